@@ -0,0 +1,233 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *   mockdpi.js
+ *
+ * DESCRIPTION
+ *   Benchmarks of the njs and JavaScript layers using the mock dpi layer.
+ *
+ *   Needs the add-on built with the mock dpi layer, which synthesizes rows
+ *   instead of talking to a database (see src/dpi/mock/dpiMock.h):
+ *
+ *     node-gyp rebuild --dpi_mock=true
+ *     node bench/mockdpi.js 100000 0
+ *
+ *   The arguments are the number of rows and the latency in microseconds
+ *   slept for each simulated round trip.  Each case reports the number of
+ *   rows (or LOBs, or connections) processed per second.
+ *
+ *****************************************************************************/
+
+var async = require('async');
+var oracledb = require('../');
+
+var numRows = parseInt(process.argv[2], 10) || 100000;
+var latency = parseInt(process.argv[3], 10) || 0;
+var connectString = 'latency=' + latency;
+
+var cols = 'cols=number,varchar2:20,date,raw:16';
+
+function report(label, count, elapsed) {
+  console.log(label + ': ' + count + ' in ' + elapsed + ' ms (' +
+              Math.round(count / (elapsed || 1) * 1000) + '/s)');
+}
+
+// Fetches all rows at once, in both row formats
+function fetchAll(connection, outFormat, cb) {
+  var start = Date.now();
+
+  connection.execute(
+    "SELECT --+ mock rows=" + numRows + " " + cols + "\n FROM DUAL",
+    [],
+    { maxRows: numRows, outFormat: outFormat },
+    function(err, result) {
+      if (err) return cb(err);
+      report(outFormat === oracledb.OBJECT ? 'execute OBJECT ' :
+                                             'execute ARRAY  ',
+             result.rows.length, Date.now() - start);
+      cb();
+    }
+  );
+}
+
+// Fetches the rows in batches from a ResultSet
+function fetchResultSet(connection, cb) {
+  var start = Date.now();
+  var count = 0;
+
+  connection.execute(
+    "SELECT --+ mock rows=" + numRows + " " + cols + "\n FROM DUAL",
+    [],
+    { resultSet: true },
+    function(err, result) {
+      if (err) return cb(err);
+
+      function fetch() {
+        result.resultSet.getRows(1000, function(err, rows) {
+          if (err) return cb(err);
+          if (rows.length) {
+            count += rows.length;
+            return fetch();
+          }
+          result.resultSet.close(function(err) {
+            if (err) return cb(err);
+            report('getRows        ', count, Date.now() - start);
+            cb();
+          });
+        });
+      }
+      fetch();
+    }
+  );
+}
+
+function fetchStream(connection, cb) {
+  var start = Date.now();
+  var count = 0;
+  var stream = connection.queryStream(
+    "SELECT --+ mock rows=" + numRows + " " + cols + "\n FROM DUAL");
+
+  stream.on('error', cb);
+  stream.on('data', function() {
+    count++;
+  });
+  stream.on('end', function() {
+    report('queryStream    ', count, Date.now() - start);
+    cb();
+  });
+}
+
+function bindMany(connection, cb) {
+  var rows = [];
+  var start;
+  var i;
+
+  for (i = 0; i < numRows; i++) {
+    rows.push([i, 'row ' + i, new Date(1451606400000 + i * 1000)]);
+  }
+
+  start = Date.now();
+  connection.executeMany(
+    "INSERT INTO nodb_bench VALUES (:1, :2, :3)",
+    rows,
+    function(err, result) {
+      if (err) return cb(err);
+      report('executeMany    ', result.rowsAffected, Date.now() - start);
+      cb();
+    }
+  );
+}
+
+// Reads every LOB of a query as a stream
+function readLobs(connection, cb) {
+  var numLobs = Math.max(Math.floor(numRows / 100), 1);
+  var start = Date.now();
+
+  connection.execute(
+    "SELECT --+ mock rows=" + numLobs + " cols=clob:65536\n FROM DUAL",
+    [],
+    { maxRows: numLobs },
+    function(err, result) {
+      if (err) return cb(err);
+
+      async.eachSeries(
+        result.rows,
+        function(row, next) {
+          var lob = row[0];
+
+          lob.setEncoding('utf8');
+          lob.on('error', next);
+          lob.on('data', function() {});
+          lob.on('end', next);
+        },
+        function(err) {
+          if (err) return cb(err);
+          report('LOB read       ', result.rows.length, Date.now() - start);
+          cb();
+        }
+      );
+    }
+  );
+}
+
+// Gets and releases pooled connections, 4 at a time
+function poolChurn(cb) {
+  var numConns = Math.max(Math.floor(numRows / 10), 1);
+  var start;
+
+  oracledb.createPool(
+    { connectString: connectString, poolMin: 4, poolMax: 4 },
+    function(err, pool) {
+      if (err) return cb(err);
+
+      start = Date.now();
+      async.timesLimit(
+        numConns,
+        4,
+        function(n, next) {
+          pool.getConnection(function(err, connection) {
+            if (err) return next(err);
+            connection.release(next);
+          });
+        },
+        function(err) {
+          if (err) return cb(err);
+          report('pool churn     ', numConns, Date.now() - start);
+          pool.terminate(cb);
+        }
+      );
+    }
+  );
+}
+
+if (oracledb.oracleClientVersion !== 0) {
+  console.error('mockdpi.js needs the add-on built with --dpi_mock=true');
+  process.exit(1);
+}
+
+oracledb.getConnection(
+  { connectString: connectString },
+  function(err, connection) {
+    if (err) {
+      console.error(err.message);
+      return;
+    }
+
+    async.series(
+      [
+        function(cb) { fetchAll(connection, oracledb.ARRAY, cb); },
+        function(cb) { fetchAll(connection, oracledb.OBJECT, cb); },
+        function(cb) { fetchResultSet(connection, cb); },
+        function(cb) { fetchStream(connection, cb); },
+        function(cb) { bindMany(connection, cb); },
+        function(cb) { readLobs(connection, cb); },
+        poolChurn
+      ],
+      function(err) {
+        if (err) {
+          console.error(err.message);
+        }
+        connection.release(function(err) {
+          if (err) {
+            console.error(err.message);
+          }
+        });
+      }
+    );
+  }
+);
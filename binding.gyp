@@ -1,4 +1,9 @@
 {
+  "variables" : {
+    # Build with "node-gyp rebuild --dpi_mock=true" to replace the OCI based
+    # dpi layer by the mock in src/dpi/mock/, see bench/mockdpi.js
+    "dpi_mock%" : "false"
+  },
   "targets": [
   {
     "target_name" : "oracledb",
@@ -9,10 +14,36 @@
              "src/njs/src/njsResultSet.cpp",
              "src/njs/src/njsMessages.cpp",
              "src/njs/src/njsIntLob.cpp",
+             "src/njs/src/njsThreadPool.cpp",
+             "src/njs/src/njsArena.cpp",
+             "src/njs/src/njsStringDict.cpp",
+             "src/dpi/src/dpiException.cpp",
+             "src/dpi/src/dpiExceptionImpl.cpp"
+    ],
+    "conditions" : [
+    [
+      'dpi_mock=="true"', {
+        "sources" : [
+             "src/dpi/mock/dpiMockEnv.cpp",
+             "src/dpi/mock/dpiMockConn.cpp",
+             "src/dpi/mock/dpiMockStmt.cpp"
+        ],
+        "include_dirs" : [ "src/dpi/mock/" ],
+        "cflags"        : ['-fexceptions'],
+        "cflags_cc"     : ['-fexceptions'],
+        "xcode_settings": {
+          "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+          "GCC_ENABLE_CPP_RTTI": "YES"
+        },
+        "msvs_settings": {
+          "VCCLCompilerTool": {
+            "AdditionalOptions": [ "/EHsc" ]
+          }
+        }
+      }, {
+    "sources" : [
              "src/dpi/src/dpiEnv.cpp",
              "src/dpi/src/dpiEnvImpl.cpp",
-             "src/dpi/src/dpiException.cpp",
-             "src/dpi/src/dpiExceptionImpl.cpp",
              "src/dpi/src/dpiConnImpl.cpp",
              "src/dpi/src/dpiDateTimeArrayImpl.cpp",
              "src/dpi/src/dpiPoolImpl.cpp",
@@ -22,6 +53,7 @@
              "src/dpi/src/dpiCommon.cpp",
              "src/dpi/src/dpiUdtImpl.cpp"
     ],
+    "include_dirs"  : [ "<(oci_inc_dir)" ],
     "conditions" : [
     [
       'OS=="linux"', {
@@ -161,8 +193,10 @@
       }
     ],
   ],
-  "include_dirs"  : [ "<(oci_inc_dir)",
-                      "src/dpi/src/",
+      }
+    ]
+  ],
+  "include_dirs"  : [ "src/dpi/src/",
                       "src/dpi/include/",
                       "<!(node -e \"require('nan')\")"
     ],
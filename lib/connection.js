@@ -23,6 +23,7 @@ var resultset = require('./resultset.js');
 var QueryStream = require('./querystream.js');
 var nodbUtil = require('./util.js');
 var executePromisified;
+var executeManyPromisified;
 var commitPromisified;
 var rollbackPromisified;
 var releasePromisified;
@@ -43,6 +44,12 @@ function queryStream(sql, binding, options) {
 
   if (options) {
     nodbUtil.assert(nodbUtil.isObject(options), 'NJS-006', 3);
+
+    if (options.highWaterMark !== undefined) {
+      nodbUtil.assert(typeof options.highWaterMark === 'number' &&
+        options.highWaterMark >= 1 && options.highWaterMark % 1 === 0,
+        'NJS-004', 'highWaterMark');
+    }
   }
 
   binding = binding || [];
@@ -50,7 +57,7 @@ function queryStream(sql, binding, options) {
 
   options.resultSet = true;
 
-  stream = new QueryStream(null, self._oracledb);
+  stream = new QueryStream(null, self._oracledb, options.highWaterMark);
 
   self._execute(sql, binding, options, function(err, result) {
     if (err) {
@@ -134,6 +141,126 @@ function execute(a1, a2, a3, a4) {
 
 executePromisified = nodbUtil.promisify(execute);
 
+// The executeMany function executes a DML statement or PL/SQL block once for
+// every row of bind values. Rows are sent to the C layer in batches of
+// batchSize rows, each batch being executed with a single round trip. Only the
+// last batch is executed with autoCommit, if enabled. OUT binds of a
+// RETURNING INTO clause are joined into one array per bind, with an entry for
+// every bind row.
+function executeMany(sql, bindRows, a3, a4) {
+  var self = this;
+  var options;
+  var executeManyCb;
+  var batchSize;
+  var batchStart;
+  var result;
+
+  nodbUtil.assert(arguments.length > 2 && arguments.length < 5, 'NJS-009');
+  nodbUtil.assert(typeof sql === 'string', 'NJS-006', 1);
+  nodbUtil.assert(Array.isArray(bindRows), 'NJS-006', 2);
+
+  switch (arguments.length) {
+    case 3:
+      nodbUtil.assert(typeof a3 === 'function', 'NJS-006', 3);
+      options = {};
+      executeManyCb = a3;
+      break;
+    case 4:
+      nodbUtil.assert(nodbUtil.isObject(a3), 'NJS-006', 3);
+      nodbUtil.assert(typeof a4 === 'function', 'NJS-006', 4);
+      options = a3;
+      executeManyCb = a4;
+      break;
+  }
+
+  if (options.batchSize !== undefined) {
+    if (typeof options.batchSize !== 'number' || options.batchSize < 1 ||
+        options.batchSize % 1 !== 0) {
+      executeManyCb(new Error(nodbUtil.getErrorMessage('NJS-004', 'batchSize')));
+      return;
+    }
+
+    batchSize = options.batchSize;
+  } else {
+    batchSize = bindRows.length || 1;
+  }
+
+  result = {
+    rowsAffected: 0,
+    batchRowsAffected: [],
+    batchErrors: options.batchErrors ? [] : undefined
+  };
+
+  batchStart = 0;
+
+  function executeBatch() {
+    var batchRows = bindRows;
+    var batchOptions;
+    var isLastBatch = batchStart + batchSize >= bindRows.length;
+
+    if (batchStart !== 0 || !isLastBatch) {
+      batchRows = bindRows.slice(batchStart, batchStart + batchSize);
+    }
+
+    batchOptions = {
+      batchErrors: options.batchErrors,
+      bindDefs: options.bindDefs
+    };
+
+    if (!isLastBatch) {
+      batchOptions.autoCommit = false;
+    } else if (options.autoCommit !== undefined) {
+      batchOptions.autoCommit = options.autoCommit;
+    }
+
+    self._executeMany(sql, batchRows, batchOptions, function(err, batchResult) {
+      var errIdx;
+      var key;
+
+      if (err) {
+        executeManyCb(err);
+        return;
+      }
+
+      result.rowsAffected += batchResult.rowsAffected;
+      result.batchRowsAffected.push(batchResult.rowsAffected);
+
+      if (batchResult.batchErrors) {
+        for (errIdx = 0; errIdx < batchResult.batchErrors.length; errIdx += 1) {
+          // Report offsets relative to the complete set of bind rows
+          batchResult.batchErrors[errIdx].offset += batchStart;
+          result.batchErrors.push(batchResult.batchErrors[errIdx]);
+        }
+      }
+
+      if (batchResult.outBinds) {
+        if (!result.outBinds) {
+          result.outBinds = batchResult.outBinds;
+        } else {
+          for (key in batchResult.outBinds) {
+            if (batchResult.outBinds.hasOwnProperty(key)) {
+              result.outBinds[key] =
+                result.outBinds[key].concat(batchResult.outBinds[key]);
+            }
+          }
+        }
+      }
+
+      if (isLastBatch) {
+        executeManyCb(null, result);
+        return;
+      }
+
+      batchStart += batchSize;
+      executeBatch();
+    });
+  }
+
+  executeBatch();
+}
+
+executeManyPromisified = nodbUtil.promisify(executeMany);
+
 // This commit function is just a place holder to allow for easier extension later.
 function commit(commitCb) {
   var self = this;
@@ -220,6 +347,14 @@ function extend(conn, oracledb, pool) {
         enumerable: true,
         writable: true
       },
+      _executeMany: {
+        value: conn.executeMany
+      },
+      executeMany: {
+        value: executeManyPromisified,
+        enumerable: true,
+        writable: true
+      },
       _commit: {
         value: conn.commit
       },
@@ -340,6 +340,10 @@ function extend(oracledb) {
         value: 4002,
         enumerable: true
       },
+      COLUMNAR: {
+        value: 4003,
+        enumerable: true
+      },
       Promise: {
         value: global.Promise,
         enumerable: true,
@@ -375,6 +379,11 @@ function extend(oracledb) {
         enumerable: true,
         writable: true
       },
+      poolPingInterval: {
+        value: 60,
+        enumerable: true,
+        writable: true
+      },
       _createPool: {
         value: oracledb.createPool
       },
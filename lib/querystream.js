@@ -23,7 +23,7 @@ var util = require('util');
 var Readable = require('stream').Readable;
 
 // This class was originally based on https://github.com/sagiegurari/simple-oracledb/blob/master/lib/resultset-read-stream.js
-function QueryStream(resultSet, oracledb) {
+function QueryStream(resultSet, oracledb, highWaterMark) {
   var self = this;
 
   Object.defineProperties(
@@ -40,6 +40,10 @@ function QueryStream(resultSet, oracledb) {
         value: [],
         writable: true
       },
+      _fetchedRowsIdx: { // index of the next row in _fetchedRows to be pushed
+        value: 0,
+        writable: true
+      },
       _fetchedAllRows: { // used to avoid an unnecessary call to resultSet.getRows
         value: false,
         writable: true
@@ -55,8 +59,11 @@ function QueryStream(resultSet, oracledb) {
     }
   );
 
+  // The highWaterMark is also the number of rows fetched from the resultset at
+  // a time, so it defaults to maxRows as the stream used to fetch that many.
   Readable.call(self, {
-    objectMode: true
+    objectMode: true,
+    highWaterMark: highWaterMark || oracledb.maxRows || 100
   });
 
   if (self._resultSet) { // If true, no need to invoke _open, we are ready to go.
@@ -106,9 +113,9 @@ QueryStream.prototype._read = function () {
     return;
   }
 
-  if (self._fetchedRows.length) {
+  if (self._fetchedRowsIdx < self._fetchedRows.length) {
     // We have rows already fetched that need to be pushed
-    self.push(self._fetchedRows.shift());
+    self._pushFetchedRows();
   } else if (self._fetchedAllRows) {
     // Calling the C layer close directly to avoid assertions on the public method
     self._resultSet._close(function(err) {
@@ -125,7 +132,7 @@ QueryStream.prototype._read = function () {
     // errors related to close w/conncurrent operations on resultsets
     self._fetching = true;
 
-    fetchCount = self._oracledb.maxRows || 100;
+    fetchCount = self._readableState.highWaterMark;
 
     // Calling the C layer getRows directly to avoid assertions on the public method
     self._resultSet._getRows(fetchCount, function(err, rows) {
@@ -150,13 +157,14 @@ QueryStream.prototype._read = function () {
       }
 
       self._fetchedRows = rows;
+      self._fetchedRowsIdx = 0;
 
       if (self._fetchedRows.length < fetchCount) {
         self._fetchedAllRows = true;
       }
 
       if (self._fetchedRows.length) {
-        self.push(self._fetchedRows.shift());
+        self._pushFetchedRows();
       } else { // No more rows to fetch
         // Calling the C layer close directly to avoid assertions on the public method
         self._resultSet._close(function(err) {
@@ -173,6 +181,24 @@ QueryStream.prototype._read = function () {
   }
 };
 
+// Pushes fetched rows until they run out or the stream's buffer is full. Rows
+// are taken by advancing _fetchedRowsIdx rather than with shift(), which would
+// copy the rest of the array for every row. push can call _read again
+// synchronously, so the index and array are always read from the instance.
+QueryStream.prototype._pushFetchedRows = function() {
+  var self = this;
+  var row;
+
+  while (self._fetchedRowsIdx < self._fetchedRows.length) {
+    row = self._fetchedRows[self._fetchedRowsIdx];
+    self._fetchedRowsIdx += 1;
+
+    if (!self.push(row)) {
+      break;
+    }
+  }
+};
+
 // The close method is not a standard method on stream instances in Node.js but
 // it was added to provide developers with a means of stopping the flow of data
 // and closing the stream without having to allow the entire resultset to finish
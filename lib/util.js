@@ -35,7 +35,6 @@ var errorMessages = {
   'NJS-009': 'NJS-009: invalid number of parameters',
   'NJS-014': 'NJS-014: %s is a read-only property',
   'NJS-037': 'NJS-037: incompatible type of value provided',
-  'NJS-040': 'NJS-040: connection request timeout',
   'NJS-041': 'NJS-041: cannot convert ResultSet to QueryStream after invoking methods',
   'NJS-042': 'NJS-042: cannot invoke ResultSet methods after converting to QueryStream',
   'NJS-043': 'NJS-043: ResultSet already converted to QueryStream',
@@ -98,6 +98,9 @@ public:
 
   virtual void breakExecution() = 0;
 
+  // Round trip checking that the session is usable
+  virtual void ping() = 0;
+
   virtual DpiHandle *getSvch () = 0;
 
   virtual DpiHandle *getErrh () = 0;
@@ -57,6 +57,11 @@ class SPool
 
   virtual unsigned int connectionsInUse() const = 0;
 
+                                // properties
+                                // seconds a session may stay idle before it
+                                // is pinged when handed out, < 0 = never
+  virtual void pingInterval( int pingInterval ) = 0;
+
 
                                 // methods
   virtual Conn * getConnection( const std::string &connClass = "",
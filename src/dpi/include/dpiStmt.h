@@ -39,6 +39,7 @@
 
 
 #include <string>
+#include <vector>
 #include <memory>
 
 using std::string;
@@ -158,6 +159,22 @@ typedef struct MetaData
 } MetaData;
 
 
+/*
+ * Error information for one failed iteration of an array DML execution
+ * done in batch errors mode.
+ */
+typedef struct BatchError
+{
+  unsigned int    offset;        // iteration (row) in error, zero based
+  int             errNum;        // error number
+  std::string     message;       // error message
+
+  BatchError ()
+    : offset ( 0 ), errNum ( 0 ), message ( "" )
+    {}
+} BatchError;
+
+
 // Application (Driver) level callback function prototype
 typedef int (*cbtype) (void *ctx, DPI_SZ_TYPE nRows, unsigned int bndpos,
                        unsigned long iter,
@@ -199,7 +216,11 @@ public:
                     dpi::Udt *udt,
                     cbtype cb = NULL) = 0;
 
-  virtual void execute ( int numIterations, bool autoCommit = false) = 0;
+  virtual void execute ( int numIterations, bool autoCommit = false,
+                         bool batchErrors = false ) = 0;
+
+  // Errors of the last execute(), if it was done in batch errors mode
+  virtual void getBatchErrors ( std::vector<BatchError> &errors ) = 0;
 
   virtual void define(unsigned int pos, unsigned short type, void *buf,
                       DPI_SZ_TYPE bufSize, short *ind, DPI_BUFLEN_TYPE *bufLen, std::shared_ptr<dpi::Udt> &udt) = 0;
@@ -0,0 +1,379 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *   dpiMock.h
+ *
+ * DESCRIPTION
+ *   Mock implementation of the dpi interfaces.
+ *
+ *   Used instead of the OCI based implementation when the add-on is built
+ *   with "node-gyp rebuild --dpi_mock=true", so that the njs and JavaScript
+ *   layers can be benchmarked without an Oracle client or database.
+ *
+ *   Nothing is sent anywhere: queries return synthesized rows, DML reports
+ *   rows affected, and every call that would be a round trip to the database
+ *   sleeps for a configurable latency.  The shape of the data is given by
+ *   options of the form key=value, taken first from the connect string and
+ *   then from a "mock" hint in the SQL text, which may be given in either
+ *   hint syntax, e.g.
+ *
+ *     SELECT --+ mock rows=10000 cols=number,varchar2:30,date,clob:4096
+ *     FROM DUAL
+ *
+ *   Options:
+ *     rows=n       rows returned by a query, rows affected by a single DML
+ *     cols=list    comma separated column types of a query, each one of
+ *                  number, varchar2[:size], char[:size], date, timestamp,
+ *                  raw[:size], clob[:length] or blob[:length]
+ *     nulls=n      every n-th value of a column is NULL, 0 for none
+ *     latency=n    microseconds slept for each round trip
+ *
+ *   Column values are derived from the row number.  DML RETURNING, UDTs and
+ *   OUT binds of PL/SQL blocks (which return NULL) are not simulated.
+ *
+ *****************************************************************************/
+
+#ifndef DPIMOCK_ORACLE
+# define DPIMOCK_ORACLE
+
+#ifndef DPI_ORACLE
+# include <dpi.h>
+#endif
+
+#ifndef DPIEXCEPTIONIMPL_ORACLE
+# include <dpiExceptionImpl.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <mutex>
+
+using namespace dpi;
+
+
+/*---------------------------------------------------------------------------
+                     PUBLIC CONSTANTS
+  ---------------------------------------------------------------------------*/
+
+#define DPI_MOCK_SERVER_VERSION   0x0C100200     // 12.1.0.2.0
+#define DPI_MOCK_LOB_CHUNKSIZE    8132
+#define DPI_MOCK_BASE_DATE        1451606400000.0L   // 2016-01-01 UTC, in ms
+
+
+/*---------------------------------------------------------------------------
+                     PUBLIC TYPES
+  ---------------------------------------------------------------------------*/
+
+class MockEnv;
+class MockPool;
+
+typedef struct MockColumn
+{
+  string             name;
+  unsigned short     dbType;
+  unsigned short     dbSize;
+  unsigned long long lobLength;  // length of CLOB/BLOB values
+} MockColumn;
+
+// Data shape and latency, see the options above
+class MockSpec
+{
+public:
+  MockSpec ();
+
+  void parse ( const string &options );
+  void parseHint ( const string &sql );
+
+  unsigned long long      rows;
+  unsigned int            nulls;
+  unsigned int            latency;
+  std::vector<MockColumn> cols;
+
+private:
+  void parseCols ( const string &cols );
+};
+
+// Lob locator handed out as a Descriptor
+typedef struct MockLobLocator
+{
+  unsigned short     type;
+  unsigned long long length;
+} MockLobLocator;
+
+
+class MockEnv : public Env
+{
+public:
+  MockEnv ();
+  virtual ~MockEnv ();
+
+  virtual void terminate ();
+
+  virtual void poolMax ( unsigned int poolMax ) { poolMax_ = poolMax; }
+  virtual unsigned int poolMax () const { return poolMax_; }
+
+  virtual void poolMin ( unsigned int poolMin ) { poolMin_ = poolMin; }
+  virtual unsigned int poolMin () const { return poolMin_; }
+
+  virtual void poolIncrement ( unsigned int poolIncrement )
+  { poolIncrement_ = poolIncrement; }
+  virtual unsigned int poolIncrement () const { return poolIncrement_; }
+
+  virtual void poolTimeout ( unsigned int poolTimeout )
+  { poolTimeout_ = poolTimeout; }
+  virtual unsigned int poolTimeout () const { return poolTimeout_; }
+
+  virtual void externalAuth ( bool externalAuth )
+  { externalAuth_ = externalAuth; }
+  virtual bool externalAuth () const { return externalAuth_; }
+
+  virtual unsigned int dbcharset () const  { return DPI_AL32UTF8; }
+  virtual unsigned int dbncharset () const { return DPI_AL32UTF8; }
+
+  virtual SPool * createPool ( const string &user, const string &password,
+                               const string &connString,
+                               int poolMax, int poolMin, int poolIncrement,
+                               int poolTimeout, int stmtCacheSize,
+                               bool externalAuth, bool homogeneous );
+
+  virtual Conn * getConnection ( const string &user, const string &password,
+                                 const string &connString, int stmtCacheSize,
+                                 const string &connClass, bool externalAuth,
+                                 DBPrivileges dbPriv );
+
+  virtual DateTimeArray * getDateTimeArray ( OCIError *errh ) const;
+  virtual void releaseDateTimeArray ( DateTimeArray *arr ) const;
+
+  virtual DpiHandle * allocHandle ( HandleType handleType );
+  virtual Descriptor * allocDescriptor ( DescriptorType descriptorType );
+  virtual void allocDescriptorArray ( DescriptorType descriptorType,
+                                      unsigned int arraySize,
+                                      Descriptor **descriptorArray );
+
+  virtual DpiHandle * envHandle () const { return NULL; }
+
+private:
+  unsigned int poolMax_;
+  unsigned int poolMin_;
+  unsigned int poolIncrement_;
+  unsigned int poolTimeout_;
+  bool         externalAuth_;
+};
+
+
+class MockPool : public SPool
+{
+public:
+  MockPool ( const string &connString, unsigned int poolMax,
+             unsigned int poolMin );
+
+  virtual void terminate ();
+
+  virtual unsigned int connectionsOpen () const;
+  virtual unsigned int connectionsInUse () const;
+
+  // Sessions of the mock are never cut, none needs a ping
+  virtual void pingInterval ( int pingInterval ) {}
+
+  virtual Conn * getConnection ( const std::string &connClass,
+                                 const std::string &username,
+                                 const std::string &password,
+                                 const std::string &tag,
+                                 const boolean any,
+                                 const DBPrivileges dbPriv );
+
+  void releaseConnection ();
+
+private:
+  virtual ~MockPool () {}
+
+  MockSpec            spec_;
+  unsigned int        poolMax_;
+  unsigned int        open_;
+  unsigned int        inUse_;
+  mutable std::mutex  mutex_;      // connections come and go on any worker
+};
+
+
+class MockConn : public Conn
+{
+public:
+  MockConn ( MockPool *pool, const MockSpec &spec );
+  virtual ~MockConn () {}
+
+  virtual std::shared_ptr<dpi::Udt> getUdt ( const std::string &udtName );
+
+  virtual void release ( const string &tag, boolean retag );
+
+  virtual void stmtCacheSize ( unsigned int stmtCacheSize )
+  { stmtCacheSize_ = stmtCacheSize; }
+  virtual unsigned int stmtCacheSize () const { return stmtCacheSize_; }
+
+  virtual int getByteExpansionRatio () { return 1; }
+
+  virtual void setErrState ( int errNum ) {}
+
+  virtual void lobPrefetchSize ( unsigned int lobPrefetchSize )
+  { lobPrefetchSize_ = lobPrefetchSize; }
+  virtual unsigned int lobPrefetchSize () const { return lobPrefetchSize_; }
+
+  // Piggybacked on the next round trip, as with OCI
+  virtual void clientId ( const string &clientId ) {}
+  virtual void module ( const string &module ) {}
+  virtual void action ( const string &action ) {}
+
+  virtual boolean sameTag () { return false; }
+
+  virtual Stmt * getStmt ( const string &sql );
+
+  virtual void commit ()           { roundTrip (); }
+  virtual void rollback ()         { roundTrip (); }
+  virtual void breakExecution ()   {}
+  virtual void ping ()             { roundTrip (); }
+
+  virtual DpiHandle *getSvch () { return (DpiHandle *) this; }
+  virtual DpiHandle *getErrh () { return NULL; }
+
+  virtual unsigned int getServerVersion () { return DPI_MOCK_SERVER_VERSION; }
+
+  const MockSpec & spec () const { return spec_; }
+
+  void roundTrip () const;
+
+  static void roundTrip ( unsigned int latency );
+
+private:
+  MockPool     *pool_;
+  MockSpec      spec_;
+  unsigned int  stmtCacheSize_;
+  unsigned int  lobPrefetchSize_;
+};
+
+
+class MockStmt : public Stmt
+{
+public:
+  MockStmt ( MockConn *conn, const string &sql );
+
+  virtual void release ();
+
+  virtual DpiStmtType stmtType () const { return stmtType_; }
+
+  virtual void prefetchRows ( unsigned int prefetchRows ) {}
+
+  virtual bool isReturning () { return false; }
+
+  virtual DPI_USZ_TYPE rowsAffected () const { return rowsAffected_; }
+
+  virtual unsigned int numCols ();
+
+  virtual void bind ( unsigned int pos, unsigned short type, void *buf,
+                      DPI_SZ_TYPE bufSize, short *ind,
+                      DPI_BUFLEN_TYPE *bufLen, unsigned int maxarr_len,
+                      unsigned int *curelen, void *data, dpi::Udt *udt,
+                      cbtype cb );
+
+  virtual void bind ( const unsigned char *name, int nameLen,
+                      unsigned int bndpos, unsigned short type, void *buf,
+                      DPI_SZ_TYPE bufSize, short *ind,
+                      DPI_BUFLEN_TYPE *bufLen, unsigned int maxarr_len,
+                      unsigned int *curelen, void *data, dpi::Udt *udt,
+                      cbtype cb );
+
+  virtual void execute ( int numIterations, bool autoCommit,
+                         bool batchErrors );
+
+  virtual void getBatchErrors ( std::vector<BatchError> &errors )
+  { errors.clear (); }
+
+  virtual void define ( unsigned int pos, unsigned short type, void *buf,
+                        DPI_SZ_TYPE bufSize, short *ind,
+                        DPI_BUFLEN_TYPE *bufLen,
+                        std::shared_ptr<dpi::Udt> &udt );
+
+  virtual void fetch ( unsigned int numRows );
+
+  virtual const MetaData * getMetaData ( bool extendedMetaData );
+
+  virtual unsigned int rowsFetched () const { return rowsFetched_; }
+
+  virtual OCIError *getError () { return NULL; }
+
+  virtual unsigned int getState () { return state_; }
+
+private:
+  virtual ~MockStmt ();
+
+  typedef struct MockDefine
+  {
+    unsigned short   type;
+    void            *buf;
+    DPI_SZ_TYPE      bufSize;
+    short           *ind;
+    DPI_BUFLEN_TYPE *bufLen;
+
+    MockDefine () : type ( 0 ), buf ( NULL ), bufSize ( 0 ), ind ( NULL ),
+                    bufLen ( NULL ) {}
+  } MockDefine;
+
+  typedef struct MockBind
+  {
+    short            *ind;
+    unsigned int      maxarr_len;
+    unsigned int     *curelen;
+  } MockBind;
+
+  void fetchValue ( const MockColumn &col, const MockDefine &define,
+                    unsigned int idx, unsigned long long rowNum,
+                    unsigned int colNum );
+
+  MockConn                *conn_;
+  MockSpec                 spec_;
+  DpiStmtType              stmtType_;
+  unsigned int             state_;
+  DPI_USZ_TYPE             rowsAffected_;
+  unsigned long long       rowsDone_;       // rows fetched so far
+  unsigned int             rowsFetched_;    // rows of the last fetch
+  MetaData                *meta_;
+  std::vector<MockDefine>  defines_;
+  std::vector<MockBind>    binds_;
+};
+
+
+class MockDateTimeArray : public DateTimeArray
+{
+public:
+  MockDateTimeArray ( const MockEnv *env ) :
+    env_ ( env ), values_ ( NULL ) {}
+
+  virtual void * init ( int nCount );
+  virtual void release ();
+
+  virtual long double getDateTime ( const int idx ) { return values_[idx]; }
+  virtual void setDateTime ( const int idx, long double ms )
+  { values_[idx] = ms; }
+
+  virtual ~MockDateTimeArray () { delete [] values_; }
+
+private:
+  const MockEnv *env_;
+  long double   *values_;             // ms since the epoch
+};
+
+
+#endif                                                  /* DPIMOCK_ORACLE */
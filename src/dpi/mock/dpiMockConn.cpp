@@ -0,0 +1,171 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *   dpiMockConn.cpp
+ *
+ * DESCRIPTION
+ *   Mock SPool and Conn implementation.
+ *
+ *****************************************************************************/
+
+#ifndef DPIMOCK_ORACLE
+# include <dpiMock.h>
+#endif
+
+#include <thread>
+#include <chrono>
+
+
+/*---------------------------------------------------------------------------
+                     MockPool
+  ---------------------------------------------------------------------------*/
+
+MockPool::MockPool ( const string &connString, unsigned int poolMax,
+                     unsigned int poolMin )
+  : poolMax_ ( poolMax ), open_ ( poolMin ), inUse_ ( 0 )
+{
+  spec_.parse ( connString );
+  MockConn::roundTrip ( spec_.latency );
+}
+
+/*****************************************************************************/
+/*
+   NOTES:
+     As with OCI, a pool with connections in use cannot be terminated.
+*/
+void MockPool::terminate ()
+{
+  {
+    std::lock_guard<std::mutex> lock ( mutex_ );
+
+    if ( inUse_ )
+      throw ExceptionImpl ( "ORA", 24422,
+        "ORA-24422: error occurred while trying to destroy the Session Pool" );
+  }
+
+  delete this;
+}
+
+unsigned int MockPool::connectionsOpen () const
+{
+  std::lock_guard<std::mutex> lock ( mutex_ );
+  return open_;
+}
+
+unsigned int MockPool::connectionsInUse () const
+{
+  std::lock_guard<std::mutex> lock ( mutex_ );
+  return inUse_;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Gets a connection from the pool.  Only opening a new session costs a
+     round trip; the pool does not wait when all sessions are in use (as
+     OCI_SPOOL_ATTRVAL_NOWAIT).
+*/
+Conn * MockPool::getConnection ( const std::string &connClass,
+                                 const std::string &username,
+                                 const std::string &password,
+                                 const std::string &tag,
+                                 const boolean any,
+                                 const DBPrivileges dbPriv )
+{
+  bool newSession = false;
+
+  {
+    std::lock_guard<std::mutex> lock ( mutex_ );
+
+    if ( inUse_ >= poolMax_ )
+      throw ExceptionImpl ( "ORA", 24418,
+                            "ORA-24418: Cannot open further sessions." );
+
+    if ( inUse_ == open_ )
+    {
+      open_++;
+      newSession = true;
+    }
+    inUse_++;
+  }
+
+  if ( newSession )
+    MockConn::roundTrip ( spec_.latency );
+
+  return new MockConn ( this, spec_ );
+}
+
+void MockPool::releaseConnection ()
+{
+  std::lock_guard<std::mutex> lock ( mutex_ );
+  inUse_--;
+}
+
+
+/*---------------------------------------------------------------------------
+                     MockConn
+  ---------------------------------------------------------------------------*/
+
+MockConn::MockConn ( MockPool *pool, const MockSpec &spec )
+  : pool_ ( pool ), spec_ ( spec ), stmtCacheSize_ ( 0 ),
+    lobPrefetchSize_ ( 0 )
+{
+}
+
+std::shared_ptr<dpi::Udt> MockConn::getUdt ( const std::string &udtName )
+{
+  throw ExceptionImpl ( "MOCK", 2,
+                        "MOCK-002: UDTs are not supported by the mock" );
+}
+
+void MockConn::release ( const string &tag, boolean retag )
+{
+  if ( pool_ )
+    pool_->releaseConnection ();
+  else
+    roundTrip ();
+
+  delete this;
+}
+
+Stmt * MockConn::getStmt ( const string &sql )
+{
+  return new MockStmt ( this, sql );
+}
+
+void MockConn::roundTrip () const
+{
+  roundTrip ( spec_.latency );
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Simulates a round trip to the database.
+
+   PARAMETERS:
+     latency - microseconds to sleep for
+*/
+void MockConn::roundTrip ( unsigned int latency )
+{
+  if ( latency )
+    std::this_thread::sleep_for ( std::chrono::microseconds ( latency ) );
+}
+
+
+/* end of file dpiMockConn.cpp */
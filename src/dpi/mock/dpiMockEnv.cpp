@@ -0,0 +1,447 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *   dpiMockEnv.cpp
+ *
+ * DESCRIPTION
+ *   Mock Env, DateTimeArray, Lob and Common implementation, and the parsing
+ *   of the mock options.
+ *
+ *****************************************************************************/
+
+#ifndef DPIMOCK_ORACLE
+# include <dpiMock.h>
+#endif
+
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+
+using std::istringstream;
+
+
+/*---------------------------------------------------------------------------
+                     PRIVATE FUNCTIONS
+  ---------------------------------------------------------------------------*/
+
+static string toLower ( string s )
+{
+  std::transform ( s.begin (), s.end (), s.begin (), ::tolower );
+  return s;
+}
+
+
+/*---------------------------------------------------------------------------
+                     MockSpec
+  ---------------------------------------------------------------------------*/
+
+MockSpec::MockSpec ()
+  : rows ( 1 ), nulls ( 0 ), latency ( 0 )
+{
+  parseCols ( "number" );
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Applies whitespace separated key=value options.
+
+   PARAMETERS:
+     options - option string, unknown keys are ignored
+*/
+void MockSpec::parse ( const string &options )
+{
+  istringstream in ( options );
+  string        token;
+
+  while ( in >> token )
+  {
+    size_t eq = token.find ( '=' );
+
+    if ( eq == string::npos )
+      continue;
+
+    string key   = toLower ( token.substr ( 0, eq ) );
+    string value = token.substr ( eq + 1 );
+
+    if ( key == "rows" )
+      rows = strtoull ( value.c_str (), NULL, 10 );
+    else if ( key == "nulls" )
+      nulls = (unsigned int) strtoul ( value.c_str (), NULL, 10 );
+    else if ( key == "latency" )
+      latency = (unsigned int) strtoul ( value.c_str (), NULL, 10 );
+    else if ( key == "cols" )
+      parseCols ( value );
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Applies the options of the "mock" hints of a SQL statement.
+
+   PARAMETERS:
+     sql - SQL text
+*/
+void MockSpec::parseHint ( const string &sql )
+{
+  size_t pos = 0;
+
+  for ( ;; )
+  {
+    size_t block = sql.find ( "/*+", pos );
+    size_t line  = sql.find ( "--+", pos );
+    size_t start = std::min ( block, line );
+    size_t end;
+
+    if ( start == string::npos )
+      break;
+
+    end = sql.find ( ( start == block ) ? "*/" : "\n", start + 3 );
+    if ( end == string::npos )
+      end = sql.length ();
+
+    istringstream in ( sql.substr ( start + 3, end - start - 3 ) );
+    string        keyword;
+
+    if ( ( in >> keyword ) && toLower ( keyword ) == "mock" )
+    {
+      string options;
+
+      std::getline ( in, options, '\0' );
+      parse ( options );
+    }
+
+    pos = end;
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Sets the query columns from a list of column types.
+
+   PARAMETERS:
+     cols - comma separated list of type[:size]
+*/
+void MockSpec::parseCols ( const string &cols )
+{
+  istringstream in ( cols );
+  string        item;
+
+  this->cols.clear ();
+
+  while ( std::getline ( in, item, ',' ) )
+  {
+    MockColumn    col;
+    size_t        colon = item.find ( ':' );
+    string        type  = toLower ( item.substr ( 0, colon ) );
+    unsigned long size  = ( colon == string::npos ) ? 0 :
+                          strtoul ( item.c_str () + colon + 1, NULL, 10 );
+    std::stringstream name;
+
+    name << "COL" << ( this->cols.size () + 1 );
+    col.name      = name.str ();
+    col.lobLength = 0;
+
+    if ( type == "number" )
+    {
+      col.dbType = DpiNumber;
+      col.dbSize = 22;
+    }
+    else if ( type == "varchar2" )
+    {
+      col.dbType = DpiVarChar;
+      col.dbSize = (unsigned short) ( size ? size : 30 );
+    }
+    else if ( type == "char" )
+    {
+      col.dbType = DpiFixedChar;
+      col.dbSize = (unsigned short) ( size ? size : 10 );
+    }
+    else if ( type == "date" )
+    {
+      col.dbType = DpiDate;
+      col.dbSize = 7;
+    }
+    else if ( type == "timestamp" )
+    {
+      col.dbType = DpiTimestamp;
+      col.dbSize = 11;
+    }
+    else if ( type == "raw" )
+    {
+      col.dbType = DpiRaw;
+      col.dbSize = (unsigned short) ( size ? size : 16 );
+    }
+    else if ( type == "clob" || type == "blob" )
+    {
+      col.dbType    = ( type == "clob" ) ? DpiClob : DpiBlob;
+      col.dbSize    = 4000;
+      col.lobLength = size ? size : 1000;
+    }
+    else
+    {
+      string msg = "MOCK-001: unsupported column type " + type;
+      throw ExceptionImpl ( "MOCK", 1, msg.c_str () );
+    }
+
+    this->cols.push_back ( col );
+  }
+}
+
+
+/*---------------------------------------------------------------------------
+                     Env
+  ---------------------------------------------------------------------------*/
+
+Env::Env()
+{
+}
+
+Env::~Env()
+{
+}
+
+Env * Env::createEnv ( const string &drvName, unsigned int charset,
+                       unsigned int ncharset )
+{
+  return new MockEnv ();
+}
+
+void Env::freeHandle ( DpiHandle *handle, HandleType handleType )
+{
+  delete [] (char *) handle;
+}
+
+void Env::freeDescriptor ( Descriptor *descriptor,
+                           DescriptorType descriptorType )
+{
+  delete (MockLobLocator *) descriptor;
+}
+
+/*****************************************************************************/
+/*
+   NOTES:
+     The locators of an array are allocated as one block preceded by a
+     header locator whose length is the number of locators.
+*/
+void Env::freeDescriptorArray ( Descriptor **descriptorArray,
+                                DescriptorType descriptorType )
+{
+  if ( descriptorArray[0] )
+    delete [] ( (MockLobLocator *) descriptorArray[0] - 1 );
+}
+
+
+/*---------------------------------------------------------------------------
+                     MockEnv
+  ---------------------------------------------------------------------------*/
+
+MockEnv::MockEnv ()
+  : poolMax_ ( 4 ), poolMin_ ( 0 ), poolIncrement_ ( 1 ),
+    poolTimeout_ ( 60 ), externalAuth_ ( false )
+{
+}
+
+MockEnv::~MockEnv ()
+{
+}
+
+void MockEnv::terminate ()
+{
+  delete this;
+}
+
+SPool * MockEnv::createPool ( const string &user, const string &password,
+                              const string &connString,
+                              int poolMax, int poolMin, int poolIncrement,
+                              int poolTimeout, int stmtCacheSize,
+                              bool externalAuth, bool homogeneous )
+{
+  return new MockPool ( connString,
+                        ( poolMax == -1 ) ? poolMax_ : poolMax,
+                        ( poolMin == -1 ) ? poolMin_ : poolMin );
+}
+
+Conn * MockEnv::getConnection ( const string &user, const string &password,
+                                const string &connString, int stmtCacheSize,
+                                const string &connClass, bool externalAuth,
+                                DBPrivileges dbPriv )
+{
+  MockSpec spec;
+
+  spec.parse ( connString );
+  MockConn::roundTrip ( spec.latency );
+
+  return new MockConn ( NULL, spec );
+}
+
+DateTimeArray * MockEnv::getDateTimeArray ( OCIError *errh ) const
+{
+  return new MockDateTimeArray ( this );
+}
+
+void MockEnv::releaseDateTimeArray ( DateTimeArray *arr ) const
+{
+  delete arr;
+}
+
+DpiHandle * MockEnv::allocHandle ( HandleType handleType )
+{
+  return (DpiHandle *) new char[1];
+}
+
+Descriptor * MockEnv::allocDescriptor ( DescriptorType descriptorType )
+{
+  MockLobLocator *lob = new MockLobLocator;
+
+  lob->type   = DpiBlob;
+  lob->length = 0;
+
+  return (Descriptor *) lob;
+}
+
+void MockEnv::allocDescriptorArray ( DescriptorType descriptorType,
+                                     unsigned int arraySize,
+                                     Descriptor **descriptorArray )
+{
+  MockLobLocator *lobs = new MockLobLocator[arraySize + 1];
+
+  lobs[0].length = arraySize;
+  for ( unsigned int i = 0; i < arraySize; i++ )
+  {
+    lobs[i + 1].type   = DpiBlob;
+    lobs[i + 1].length = 0;
+    descriptorArray[i] = (Descriptor *) &lobs[i + 1];
+  }
+}
+
+
+/*---------------------------------------------------------------------------
+                     MockDateTimeArray
+  ---------------------------------------------------------------------------*/
+
+void * MockDateTimeArray::init ( int nCount )
+{
+  values_ = new long double[nCount];
+
+  for ( int i = 0; i < nCount; i++ )
+    values_[i] = 0;
+
+  return values_;
+}
+
+void MockDateTimeArray::release ()
+{
+  env_->releaseDateTimeArray ( this );
+}
+
+
+/*---------------------------------------------------------------------------
+                     Lob
+  ---------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Reads from a mock LOB.  CLOBs hold lower case letters and BLOBs the
+     bytes 0 to 255, repeated.
+
+   NOTES:
+     svch is the MockConn the LOB was fetched with.
+*/
+void Lob::read ( DpiHandle *svch, DpiHandle *errh, Descriptor *lobLocator,
+                 unsigned long long &byteAmount,
+                 unsigned long long &charAmount,
+                 unsigned long long offset, void *buf,
+                 unsigned long long bufl )
+{
+  MockLobLocator     *lob    = (MockLobLocator *) lobLocator;
+  bool                isClob = ( lob->type == DpiClob );
+  unsigned long long  amount = isClob ? charAmount : byteAmount;
+  unsigned long long  avail  = ( offset > lob->length ) ? 0 :
+                               lob->length - offset + 1;
+
+  ( (MockConn *) svch )->roundTrip ();
+
+  if ( amount > avail )
+    amount = avail;
+
+  for ( unsigned long long i = 0; i < amount; i++ )
+  {
+    unsigned long long pos = offset - 1 + i;
+
+    ( (unsigned char *) buf )[i] =
+      isClob ? (unsigned char) ( 'a' + pos % 26 ) : (unsigned char) pos;
+  }
+
+  byteAmount = amount;
+  if ( isClob )
+    charAmount = amount;
+}
+
+void Lob::write ( DpiHandle *svch, DpiHandle *errh, Descriptor *lobLocator,
+                  unsigned long long &byteAmount,
+                  unsigned long long &charAmount,
+                  unsigned long long offset, void *buf,
+                  unsigned long long bufl )
+{
+  MockLobLocator *lob = (MockLobLocator *) lobLocator;
+
+  ( (MockConn *) svch )->roundTrip ();
+
+  if ( offset - 1 + byteAmount > lob->length )
+    lob->length = offset - 1 + byteAmount;
+
+  if ( lob->type == DpiClob )
+    charAmount = byteAmount;
+}
+
+unsigned int Lob::chunkSize ( DpiHandle *svch, DpiHandle *errh,
+                              Descriptor *lobLocator )
+{
+  ( (MockConn *) svch )->roundTrip ();
+
+  return DPI_MOCK_LOB_CHUNKSIZE;
+}
+
+unsigned long long Lob::length ( DpiHandle *svch, DpiHandle *errh,
+                                 Descriptor *lobLocator )
+{
+  ( (MockConn *) svch )->roundTrip ();
+
+  return ( (MockLobLocator *) lobLocator )->length;
+}
+
+
+/*---------------------------------------------------------------------------
+                     Common
+  ---------------------------------------------------------------------------*/
+
+// A client version of 0 tells the mock build from a real one
+void Common::clientVersion ( int *majorv, int *minorv, int *patchv,
+                             int *portv, int *portUpdv )
+{
+  *majorv = *minorv = *patchv = *portv = *portUpdv = 0;
+}
+
+
+/* end of file dpiMockEnv.cpp */
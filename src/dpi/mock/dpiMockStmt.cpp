@@ -0,0 +1,374 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *   dpiMockStmt.cpp
+ *
+ * DESCRIPTION
+ *   Mock Stmt implementation.
+ *
+ *****************************************************************************/
+
+#ifndef DPIMOCK_ORACLE
+# include <dpiMock.h>
+#endif
+
+#include <cstdio>
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+
+
+/*---------------------------------------------------------------------------
+                     PRIVATE FUNCTIONS
+  ---------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Gets the statement type from the first keyword of the SQL text.
+*/
+static DpiStmtType getStmtType ( const string &sql )
+{
+  size_t pos = 0;
+
+  // skip leading white space and comments
+  for ( ;; )
+  {
+    while ( pos < sql.length () && isspace ( (unsigned char) sql[pos] ) )
+      pos++;
+
+    if ( sql.compare ( pos, 2, "/*" ) == 0 )
+      pos = std::min ( sql.find ( "*/", pos + 2 ), sql.length () - 2 ) + 2;
+    else if ( sql.compare ( pos, 2, "--" ) == 0 )
+      pos = std::min ( sql.find ( '\n', pos + 2 ), sql.length () );
+    else
+      break;
+  }
+
+  string keyword;
+  while ( pos < sql.length () && isalpha ( (unsigned char) sql[pos] ) )
+    keyword += (char) toupper ( (unsigned char) sql[pos++] );
+
+  if ( keyword == "SELECT" || keyword == "WITH" )
+    return DpiStmtSelect;
+  if ( keyword == "INSERT" || keyword == "MERGE" )
+    return DpiStmtInsert;
+  if ( keyword == "UPDATE" )
+    return DpiStmtUpdate;
+  if ( keyword == "DELETE" )
+    return DpiStmtDelete;
+  if ( keyword == "BEGIN" )
+    return DpiStmtBegin;
+  if ( keyword == "DECLARE" )
+    return DpiStmtDeclare;
+  if ( keyword == "CALL" )
+    return DpiStmtCall;
+  if ( keyword == "CREATE" )
+    return DpiStmtCreate;
+  if ( keyword == "DROP" )
+    return DpiStmtDrop;
+  if ( keyword == "ALTER" )
+    return DpiStmtAlter;
+
+  return DpiStmtUnknown;
+}
+
+
+/*---------------------------------------------------------------------------
+                     MockStmt
+  ---------------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Constructor for the MockStmt class.
+
+   PARAMETERS:
+     conn - connection, its options are the defaults of the statement
+     sql  - SQL text, empty for a REF CURSOR
+*/
+MockStmt::MockStmt ( MockConn *conn, const string &sql )
+  : conn_ ( conn ), spec_ ( conn->spec () ),
+    stmtType_ ( getStmtType ( sql ) ), state_ ( DPI_STMT_STATE_INITIALIZED ),
+    rowsAffected_ ( 0 ), rowsDone_ ( 0 ), rowsFetched_ ( 0 ), meta_ ( NULL )
+{
+  spec_.parseHint ( sql );
+}
+
+MockStmt::~MockStmt ()
+{
+  delete [] meta_;
+}
+
+void MockStmt::release ()
+{
+  delete this;
+}
+
+unsigned int MockStmt::numCols ()
+{
+  return ( stmtType_ == DpiStmtSelect ) ?
+           (unsigned int) spec_.cols.size () : 0;
+}
+
+void MockStmt::bind ( unsigned int pos, unsigned short type, void *buf,
+                      DPI_SZ_TYPE bufSize, short *ind,
+                      DPI_BUFLEN_TYPE *bufLen, unsigned int maxarr_len,
+                      unsigned int *curelen, void *data, dpi::Udt *udt,
+                      cbtype cb )
+{
+  MockBind bind;
+
+  bind.ind        = ind;
+  bind.maxarr_len = maxarr_len;
+  bind.curelen    = curelen;
+  binds_.push_back ( bind );
+}
+
+void MockStmt::bind ( const unsigned char *name, int nameLen,
+                      unsigned int bndpos, unsigned short type, void *buf,
+                      DPI_SZ_TYPE bufSize, short *ind,
+                      DPI_BUFLEN_TYPE *bufLen, unsigned int maxarr_len,
+                      unsigned int *curelen, void *data, dpi::Udt *udt,
+                      cbtype cb )
+{
+  bind ( bndpos + 1, type, buf, bufSize, ind, bufLen, maxarr_len, curelen,
+         data, udt, cb );
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Executes the statement with one round trip.
+
+   PARAMETERS:
+     numIterations - 0 for queries, # of rows of bind values otherwise
+     autoCommit    - piggybacked on the execute, no extra round trip
+     batchErrors   - no errors are ever reported
+
+   NOTES:
+     A DML statement affects the given rows, or one row per iteration when
+     executed with several rows of binds.  The binds of a PL/SQL block all
+     come back NULL (or as empty arrays).
+*/
+void MockStmt::execute ( int numIterations, bool autoCommit,
+                         bool batchErrors )
+{
+  conn_->roundTrip ();
+
+  switch ( stmtType_ )
+  {
+    case DpiStmtSelect:
+      state_    = DPI_STMT_STATE_EXECUTED;
+      rowsDone_ = 0;
+      break;
+
+    case DpiStmtInsert:
+    case DpiStmtUpdate:
+    case DpiStmtDelete:
+      rowsAffected_ = ( numIterations > 1 ) ?
+                        (DPI_USZ_TYPE) numIterations :
+                        (DPI_USZ_TYPE) spec_.rows;
+      break;
+
+    case DpiStmtBegin:
+    case DpiStmtDeclare:
+    case DpiStmtCall:
+      for ( size_t b = 0; b < binds_.size (); b++ )
+      {
+        MockBind &bind = binds_[b];
+
+        if ( bind.ind )
+        {
+          unsigned int count = std::max ( bind.maxarr_len, 1U );
+
+          for ( unsigned int i = 0; i < count; i++ )
+            bind.ind[i] = -1;
+        }
+
+        if ( bind.curelen )
+          *bind.curelen = 0;
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+void MockStmt::define ( unsigned int pos, unsigned short type, void *buf,
+                        DPI_SZ_TYPE bufSize, short *ind,
+                        DPI_BUFLEN_TYPE *bufLen,
+                        std::shared_ptr<dpi::Udt> &udt )
+{
+  if ( defines_.size () < pos )
+    defines_.resize ( pos );
+
+  MockDefine &define = defines_[pos - 1];
+
+  define.type    = type;
+  define.buf     = buf;
+  define.bufSize = bufSize;
+  define.ind     = ind;
+  define.bufLen  = bufLen;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Fetches the next rows into the define buffers with one round trip.
+
+   PARAMETERS:
+     numRows - max # of rows to fetch
+*/
+void MockStmt::fetch ( unsigned int numRows )
+{
+  unsigned long long left = spec_.rows - rowsDone_;
+
+  conn_->roundTrip ();
+
+  rowsFetched_ = (unsigned int) std::min ( (unsigned long long) numRows,
+                                           left );
+
+  for ( unsigned int row = 0; row < rowsFetched_; row++ )
+  {
+    unsigned long long rowNum = rowsDone_ + row + 1;
+
+    for ( unsigned int col = 0; col < defines_.size (); col++ )
+    {
+      fetchValue ( spec_.cols[col], defines_[col], row, rowNum, col );
+    }
+  }
+
+  rowsDone_ += rowsFetched_;
+  if ( rowsDone_ == spec_.rows )
+    state_ = DPI_STMT_STATE_ENDOFFETCH;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Writes one synthesized value into a define buffer.
+
+   PARAMETERS:
+     col    - column
+     define - define of the column
+     idx    - index into the define buffers
+     rowNum - row number, starting at 1
+     colNum - column index
+
+   NOTES:
+     Numbers and dates fetched as strings are written as the row number.
+*/
+void MockStmt::fetchValue ( const MockColumn &col, const MockDefine &define,
+                            unsigned int idx, unsigned long long rowNum,
+                            unsigned int colNum )
+{
+  if ( spec_.nulls && ( rowNum + colNum ) % spec_.nulls == 0 )
+  {
+    define.ind[idx] = -1;
+    return;
+  }
+
+  define.ind[idx] = 0;
+
+  switch ( define.type )
+  {
+    case DpiDouble:
+      ( (double *) define.buf )[idx] = (double) rowNum;
+      define.bufLen[idx] = sizeof ( double );
+      break;
+
+    case DpiVarChar:
+    {
+      char   *str = (char *) define.buf + idx * define.bufSize;
+      size_t  len = snprintf ( str, (size_t) define.bufSize, "%llu", rowNum );
+
+      // Character columns are filled up to their size
+      if ( col.dbType == DpiVarChar || col.dbType == DpiFixedChar )
+      {
+        for ( ; len < col.dbSize && len < (size_t) define.bufSize; len++ )
+          str[len] = (char) ( 'a' + ( rowNum + len ) % 26 );
+      }
+
+      define.bufLen[idx] = (DPI_BUFLEN_TYPE) std::min ( len,
+                                              (size_t) define.bufSize );
+      break;
+    }
+
+    case DpiTimestampLTZ:
+      ( (long double *) define.buf )[idx] = DPI_MOCK_BASE_DATE +
+                                            rowNum * 1000.0L;
+      break;
+
+    case DpiRaw:
+    {
+      unsigned char *raw = (unsigned char *) define.buf +
+                           idx * define.bufSize;
+      size_t         len = std::min ( (size_t) col.dbSize,
+                                      (size_t) define.bufSize );
+
+      for ( size_t i = 0; i < len; i++ )
+        raw[i] = (unsigned char) ( rowNum + i );
+
+      define.bufLen[idx] = (DPI_BUFLEN_TYPE) len;
+      break;
+    }
+
+    case DpiClob:
+    case DpiBlob:
+    {
+      MockLobLocator *lob = ( (MockLobLocator **) define.buf )[idx];
+
+      lob->type   = define.type;
+      lob->length = col.lobLength;
+      break;
+    }
+
+    default:
+      define.ind[idx] = -1;
+      break;
+  }
+}
+
+const MetaData * MockStmt::getMetaData ( bool extendedMetaData )
+{
+  unsigned int numCols = this->numCols ();
+
+  if ( !meta_ && numCols )
+  {
+    meta_ = new MetaData[numCols];
+
+    for ( unsigned int col = 0; col < numCols; col++ )
+    {
+      const MockColumn &mockCol = spec_.cols[col];
+
+      meta_[col].colName    = (unsigned char *) mockCol.name.data ();
+      meta_[col].colNameLen = (unsigned int) mockCol.name.length ();
+      meta_[col].dbType     = mockCol.dbType;
+      meta_[col].dbSize     = mockCol.dbSize;
+      meta_[col].scale      = ( mockCol.dbType == DpiNumber ) ? -127 : 0;
+      meta_[col].isNullable = 1;
+    }
+  }
+
+  return meta_;
+}
+
+
+/* end of file dpiMockStmt.cpp */
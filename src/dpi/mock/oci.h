@@ -0,0 +1,59 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *   oci.h
+ *
+ * DESCRIPTION
+ *   Stand-in for the OCI header used when building with the mock dpi layer
+ *   (dpi_mock=true).  Only the types and constants referenced by the dpi
+ *   interface headers and the njs layer are declared; nothing here may be
+ *   called.
+ *
+ *****************************************************************************/
+
+#ifndef OCI_ORACLE
+# define OCI_ORACLE
+
+#define OCI_MAJOR_VERSION  12
+#define OCI_MINOR_VERSION   1
+
+typedef unsigned char       ub1;
+typedef signed char         sb1;
+typedef unsigned short      ub2;
+typedef signed short        sb2;
+typedef unsigned int        ub4;
+typedef signed int          sb4;
+typedef unsigned long long  ub8;
+typedef signed long long    sb8;
+typedef int                 boolean;
+typedef void                dvoid;
+typedef unsigned char       OraText;
+
+#ifndef TRUE
+# define TRUE   1
+# define FALSE  0
+#endif
+
+typedef struct OCIError     OCIError;
+
+#define OCI_ONE_PIECE       0
+#define OCI_FIRST_PIECE     1
+#define OCI_NEXT_PIECE      2
+#define OCI_LAST_PIECE      3
+
+#endif                                                     /* OCI_ORACLE */
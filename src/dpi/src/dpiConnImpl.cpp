@@ -42,6 +42,8 @@
 #endif
 
 #include <iostream>
+#include <algorithm>
+#include <ctime>
 #include <dpiUdtImpl.h>
 
 // Error numbers to set the drop_sess flag in sessionRelease()
@@ -89,8 +91,8 @@ ConnImpl::ConnImpl(EnvImpl *env, OCIEnv *envh, bool externalAuth,
 
 try :  env_(env), pool_(NULL),
        envh_(envh), errh_(NULL), auth_(NULL), svch_(NULL), sessh_(NULL),
-       hasTxn_(false), srvh_(NULL), dropConn_(false), tag_(""),
-       retag_(false), sameTag_ (false)
+       hasTxn_(false), serverVersion_(0), srvh_(NULL), dropConn_(false),
+       tag_(""), retag_(false), sameTag_ (false)
 {
 
   this->initConnImpl ( false, externalAuth, connClass,
@@ -141,8 +143,9 @@ ConnImpl::ConnImpl(PoolImpl *pool, OCIEnv *envh, bool externalAuth,
 
 try :  env_(NULL), pool_(pool),
        envh_(envh), errh_(NULL), auth_(NULL),
-       svch_(NULL), sessh_(NULL), hasTxn_(false), srvh_(NULL),
-       dropConn_(false), tag_ (""), retag_ (false), sameTag_(false)
+       svch_(NULL), sessh_(NULL), hasTxn_(false), serverVersion_(0),
+       srvh_(NULL), dropConn_(false), tag_ (""), retag_ (false),
+       sameTag_(false)
 {
   this->initConnImpl ( true, externalAuth, connClass, poolName, poolNameLen,
                        user, password, tag, matchAny, dbPriv );
@@ -178,7 +181,21 @@ ConnImpl::~ConnImpl()
 std::shared_ptr<dpi::Udt> ConnImpl::getUdt(const std::string &udtName) {
   if (udtName.empty())
     throw UdtException("udtName option required for UDT binds");
-  return std::make_shared<UdtImpl>(envh_, svch_, errh_, udtName);
+
+  // Binds and defines of the same type share one UdtImpl, so the type is
+  // only looked up and described once per session
+  std::lock_guard<std::mutex> lock(udtsMutex_);
+
+  string upperUdtName(udtName);
+  std::transform(upperUdtName.begin(), upperUdtName.end(), upperUdtName.begin(), ::toupper);
+
+  auto it = udts_.find(upperUdtName);
+  if (it != udts_.end())
+    return it->second;
+
+  auto udt = std::make_shared<UdtImpl>(envh_, svch_, errh_, upperUdtName);
+  udts_[upperUdtName] = udt;
+  return udt;
 }
 
 
@@ -510,6 +527,34 @@ void ConnImpl::breakExecution()
   }
 }
 
+/*****************************************************************************/
+/*
+  DESCRIPTION
+    Checks that the session is usable with a round trip to the server
+
+  PARAMETERS
+    -NONE-
+
+  RETURNS:
+    -NONE_
+
+  NOTES:
+    If the check fails, a pooled session is dropped when it is released
+    instead of being returned to the pool.
+*/
+void ConnImpl::ping ()
+{
+  try
+  {
+    ociCall (OCIPing (svch_, errh_, OCI_DEFAULT), errh_);
+  }
+  catch ( dpi::Exception & )
+  {
+    dropConn_ = true;
+    throw;
+  }
+}
+
 /*****************************************************************************/
 /*
   DESCRIPTION
@@ -561,18 +606,91 @@ void ConnImpl::setErrState ( int errNum )
 
   RETURNS
     version
+
+  NOTES
+    The version is got along with the session (see initConnImpl), this
+    does not make any OCI call and may be used from the main thread.
 */
 unsigned int ConnImpl::getServerVersion ()
 {
-  ub4  oraServerVer = 0;
-  char verbuf[ DPI_MAX_VERSION_SIZE ];
+  return serverVersion_;
+}
 
-  ociCall ( OCIServerRelease ( svch_, errh_, (OraText *)verbuf,
-                               (ub4) sizeof ( verbuf ),
-                               (ub1) OCI_HTYPE_SVCCTX, &oraServerVer ),
-              errh_ ) ;
 
-  return oraServerVer;
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Gets a session for a pooled connection released earlier.
+
+   PARAMETERS:
+     see the pool constructor
+
+   RETURNS:
+     nothing
+
+   NOTES:
+     The error and auth handles of the previous checkout are reused, the
+     state of the previous session is reset.
+ */
+
+void ConnImpl::reuse ( bool externalAuth, OraText *poolName,
+                       ub4 poolNameLen, const string &connClass,
+                       const string &user, const string &password,
+                       const string &tag, const boolean any,
+                       const DBPrivileges dbPriv )
+{
+  sessh_    = NULL;
+  srvh_     = NULL;
+  hasTxn_   = false;
+  dropConn_ = false;
+  tag_      = "";
+  retag_    = false;
+  sameTag_  = false;
+
+  this->initConnImpl ( true, externalAuth, connClass, poolName, poolNameLen,
+                       user, password, tag, any, dbPriv );
+}
+
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Checks a pooled session before it is handed out.
+
+   PARAMETERS:
+     pingInterval - seconds a session may stay idle without being pinged
+
+   RETURNS:
+     false if the session is unusable or cannot be checked, it is then
+     dropped on release
+
+   NOTES:
+     The time the session was last released is kept in the session (see
+     setLastTimeUsed), a new session has none and is not pinged. Only a
+     session idle for pingInterval seconds or more costs a round trip.
+ */
+
+bool ConnImpl::isUsable ( int pingInterval )
+{
+  time_t *lastTimeUsed = NULL;
+
+  try
+  {
+    ociCall ( OCIContextGetValue ( sessh_, errh_,
+                                   ( ub1 * ) DPI_CONTEXT_LAST_TIME_USED,
+                                   ( ub1 ) DPI_CONTEXT_LAST_TIME_USED_LEN,
+                                   ( void ** ) &lastTimeUsed ), errh_ );
+
+    if ( lastTimeUsed &&
+         difftime ( time ( NULL ), *lastTimeUsed ) >= pingInterval )
+      ping ();
+  }
+  catch (...)
+  {
+    dropConn_ = true;
+    return false;
+  }
+  return true;
 }
 
 
@@ -580,6 +698,51 @@ unsigned int ConnImpl::getServerVersion ()
                           PRIVATE METHODS
   ---------------------------------------------------------------------------*/
 
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Records the time a pooled session is released, in memory of the
+     session itself so that it follows the session in the OCI pool.
+
+   PARAMETERS:
+     none
+
+   RETURNS:
+     nothing
+
+   NOTES:
+     Best effort, the session is released even if this fails: it is then
+     seen as new and not pinged by isUsable.
+ */
+
+void ConnImpl::setLastTimeUsed ()
+{
+  time_t *lastTimeUsed = NULL;
+
+  if ( OCIContextGetValue ( sessh_, errh_,
+                            ( ub1 * ) DPI_CONTEXT_LAST_TIME_USED,
+                            ( ub1 ) DPI_CONTEXT_LAST_TIME_USED_LEN,
+                            ( void ** ) &lastTimeUsed ) != OCI_SUCCESS )
+    return;
+
+  if ( !lastTimeUsed )
+  {
+    if ( OCIMemoryAlloc ( sessh_, errh_, ( void ** ) &lastTimeUsed,
+                          OCI_DURATION_SESSION, ( ub4 ) sizeof ( time_t ),
+                          OCI_MEMORY_CLEARED ) != OCI_SUCCESS )
+      return;
+
+    if ( OCIContextSetValue ( sessh_, errh_, OCI_DURATION_SESSION,
+                              ( ub1 * ) DPI_CONTEXT_LAST_TIME_USED,
+                              ( ub1 ) DPI_CONTEXT_LAST_TIME_USED_LEN,
+                              lastTimeUsed ) != OCI_SUCCESS )
+      return;
+  }
+
+  *lastTimeUsed = time ( NULL );
+}
+
+
 /*****************************************************************************/
 /*
    DESCRIPTION
@@ -616,14 +779,21 @@ void ConnImpl::initConnImpl ( bool pool, bool externalAuth,
   else
     mode = externalAuth ? OCI_SESSGET_CREDEXT : OCI_DEFAULT;
 
-  ociCallEnv ( OCIHandleAlloc ( ( void * ) envh_, &errh,
-                                OCI_HTYPE_ERROR, 0, ( dvoid ** ) 0 ), envh_ );
-  errh_ = ( OCIError * ) errh;
+  // A reused pooled connection keeps its handles (see reuse ()), the
+  // connection class of its auth handle can only be replaced with the handle
+  if ( auth_ && connClass != connClass_ )
+  {
+    OCIHandleFree ( auth_, OCI_HTYPE_AUTHINFO );
+    auth_ = NULL;
+  }
 
-  ociCallEnv ( OCIHandleAlloc ( ( void * ) envh_, &auth,
-                                OCI_HTYPE_AUTHINFO, 0, ( dvoid ** ) 0 ),
-                                envh_ );
-  auth_ = ( OCIAuthInfo * ) auth;
+  if ( !errh_ )
+  {
+    ociCallEnv ( OCIHandleAlloc ( ( void * ) envh_, &errh,
+                                  OCI_HTYPE_ERROR, 0, ( dvoid ** ) 0 ),
+                                  envh_ );
+    errh_ = ( OCIError * ) errh;
+  }
 
   if ( externalAuth && ( !pool ) )
   {
@@ -631,16 +801,45 @@ void ConnImpl::initConnImpl ( bool pool, bool externalAuth,
       throw ExceptionImpl ( DpiErrExtAuth );
   }
 
-  if ( !pool )
+  if ( !auth_ )
   {
-    ociCall ( OCIAttrSet ( ( void * ) auth_, OCI_HTYPE_AUTHINFO,
-                           ( void * ) user.c_str (), ( ub4 ) user.length (),
-                           OCI_ATTR_USERNAME, errh_ ), errh_ );
-
-    ociCall ( OCIAttrSet ( ( void * ) auth_, OCI_HTYPE_AUTHINFO,
-                           ( void * ) password.c_str (),
-                           ( ub4 ) password.length (),
-                           OCI_ATTR_PASSWORD, errh_ ), errh_ );
+    ociCallEnv ( OCIHandleAlloc ( ( void * ) envh_, &auth,
+                                  OCI_HTYPE_AUTHINFO, 0, ( dvoid ** ) 0 ),
+                                  envh_ );
+    auth_ = ( OCIAuthInfo * ) auth;
+
+    if ( !pool )
+    {
+      ociCall ( OCIAttrSet ( ( void * ) auth_, OCI_HTYPE_AUTHINFO,
+                             ( void * ) user.c_str (), ( ub4 ) user.length (),
+                             OCI_ATTR_USERNAME, errh_ ), errh_ );
+
+      ociCall ( OCIAttrSet ( ( void * ) auth_, OCI_HTYPE_AUTHINFO,
+                             ( void * ) password.c_str (),
+                             ( ub4 ) password.length (),
+                             OCI_ATTR_PASSWORD, errh_ ), errh_ );
+    }
+
+    // If connection class provided, set it on auth handle
+    if ( connClass.length () )
+    {
+      ociCall ( OCIAttrSet ( ( void* ) auth_, OCI_HTYPE_AUTHINFO,
+                             ( void * ) connClass.c_str (),
+                             ( ub4 ) connClass.length (),
+                             OCI_ATTR_CONNECTION_CLASS, errh_ ), errh_ );
+    }
+    connClass_ = connClass;
+
+    /* In case of Pool, we set the driver name on poolAuth_ handle in
+     * Pool implimentation. For non-pooled connections we set it here.
+     */
+    if ( !pool &&  !(env_->drvName()).empty() )
+    {
+      ociCall ( OCIAttrSet ( (void*) auth_, OCI_HTYPE_AUTHINFO,
+                             (OraText *) ( env_->drvName() ).c_str (),
+                             ( ub4 ) ( ( env_->drvName() ).length () ),
+                             OCI_ATTR_DRIVER_NAME, errh_ ), errh_);
+    }
   }
 
   switch ( dbPriv )
@@ -654,27 +853,6 @@ void ConnImpl::initConnImpl ( bool pool, bool externalAuth,
       break;
   }
 
-
-  // If connection class provided, set it on auth handle
-  if ( connClass.length () )
-  {
-    ociCall ( OCIAttrSet ( ( void* ) auth_, OCI_HTYPE_AUTHINFO,
-                           ( void * ) connClass.c_str (),
-                           ( ub4 ) connClass.length (),
-                           OCI_ATTR_CONNECTION_CLASS, errh_ ), errh_ );
-  }
-
-  /* In case of Pool, we set the driver name on poolAuth_ handle in
-   * Pool implimentation. For non-pooled connections we set it here.
-   */
-  if ( !pool &&  !(env_->drvName()).empty() )
-  {
-    ociCall ( OCIAttrSet ( (void*) auth_, OCI_HTYPE_AUTHINFO,
-                           (OraText *) ( env_->drvName() ).c_str (),
-                           ( ub4 ) ( ( env_->drvName() ).length () ),
-                           OCI_ATTR_DRIVER_NAME, errh_ ), errh_);
-  }
-
   /*
    * Applicable only on Pooled sessions - attempts to return a session with
    * specified tag
@@ -709,6 +887,26 @@ void ConnImpl::initConnImpl ( bool pool, bool externalAuth,
                           errh_ );
 
   csratio_ = getCsRatio ( csid );
+
+  // The server version costs a round trip, it is got once per pool as all
+  // the sessions of a pool are on the same database
+  serverVersion_ = pool_ ? pool_->serverVersion () : 0;
+  if ( !serverVersion_ )
+  {
+    ub4  oraServerVer = 0;
+    char verbuf[ DPI_MAX_VERSION_SIZE ];
+
+    ociCall ( OCIServerRelease ( svch_, errh_, (OraText *)verbuf,
+                                 (ub4) sizeof ( verbuf ),
+                                 (ub1) OCI_HTYPE_SVCCTX, &oraServerVer ),
+              errh_ ) ;
+
+    serverVersion_ = oraServerVer;
+    if ( pool_ )
+    {
+      pool_->serverVersion ( serverVersion_ );
+    }
+  }
 }
 
 /*****************************************************************************/
@@ -728,12 +926,48 @@ void ConnImpl::initConnImpl ( bool pool, bool externalAuth,
  */
 
 void ConnImpl::cleanup()
+{
+  releaseSession ();
+
+  if (auth_)
+  {
+    OCIHandleFree (auth_, OCI_HTYPE_AUTHINFO);
+    auth_ = NULL;
+  }
+
+  if (errh_)
+  {
+    OCIHandleFree(errh_, OCI_HTYPE_ERROR);
+    errh_ = NULL;
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Releases the session, the error and auth handles are kept.
+
+   PARAMETERS:
+     none
+
+   RETURNS:
+     nothing
+
+   NOTES:
+     Called by cleanup () and, for pooled connections kept for reuse, by
+     PoolImpl::releaseConnection ().
+ */
+
+void ConnImpl::releaseSession()
 {
   ub4 relMode      = OCI_DEFAULT;
   ub4 serverStatus = OCI_SERVER_NORMAL;
 
   if (svch_)
   {
+    // Cached types are pinned for the session being released
+    udts_.clear();
+
     if ( pool_ )
     {
       // Get the connection status
@@ -745,6 +979,8 @@ void ConnImpl::cleanup()
       // Remove the session from pool in case of unusable
       if ( dropConn_ || ( serverStatus != OCI_SERVER_NORMAL ) )
         relMode |= OCI_SESSRLS_DROPSESS;
+      else if ( pool_->pingInterval () >= 0 )
+        setLastTimeUsed ();
     }
 
     // Re-tagging
@@ -764,18 +1000,6 @@ void ConnImpl::cleanup()
                       (ub4) tag_.length (), relMode);
     svch_ = NULL;
   }
-
-  if (auth_)
-  {
-    OCIHandleFree (auth_, OCI_HTYPE_AUTHINFO);
-    auth_ = NULL;
-  }
-
-  if (errh_)
-  {
-    OCIHandleFree(errh_, OCI_HTYPE_ERROR);
-    errh_ = NULL;
-  }
 }
 
 
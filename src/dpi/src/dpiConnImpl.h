@@ -45,6 +45,9 @@
 # include <dpiPoolImpl.h>
 #endif
 
+#include <map>
+#include <mutex>
+
 
 using namespace dpi;
 
@@ -63,6 +66,11 @@ class PoolImpl;
 // No character expansion required if DB has AL32UTF8 charset
 #define DPI_BESTCASE_CHAR_CONVERSION_RATIO     1
 
+// Key of the last release time kept in a pooled session, see isUsable
+#define DPI_CONTEXT_LAST_TIME_USED      "DPI_LAST_TIME_USED"
+#define DPI_CONTEXT_LAST_TIME_USED_LEN                                        \
+  ( sizeof ( DPI_CONTEXT_LAST_TIME_USED ) - 1 )
+
 /*---------------------------------------------------------------------------
                      PUBLIC TYPES
   ---------------------------------------------------------------------------*/
@@ -119,6 +127,8 @@ class ConnImpl : public Conn
 
   virtual void breakExecution();
 
+  virtual void ping();
+
   virtual DpiHandle *getSvch (){return (DpiHandle *)svch_;};
 
   virtual DpiHandle *getErrh (){return (DpiHandle *)errh_;};
@@ -140,8 +150,20 @@ class ConnImpl : public Conn
 
     virtual unsigned int getServerVersion () ;
 
+                              // pooled connection handles, see PoolImpl
+  void reuse ( bool externalAuth, OraText *poolName, ub4 poolNameLen,
+               const string &connClass, const string &user,
+               const string &password, const string &tag,
+               const boolean any, const DBPrivileges dbPriv );
+
+  void releaseSession ();
+
+  bool isUsable ( int pingInterval );
+
 private:
 
+  void setLastTimeUsed ();
+
   void initConnImpl( bool pool, bool externalAuth, const string& connClass,
                      OraText *poolNmRconnStr, ub4 nameLen,
                      const string &user, const string &password,
@@ -162,15 +184,21 @@ private:
   OCIEnv      *envh_;           // OCI enviornment handle
   OCIError    *errh_;           // OCI error handle
   OCIAuthInfo *auth_;           // OCI auth handle
+  string      connClass_;       // connection class set on auth_
   OCISvcCtx   *svch_;           // OCI service handle
   OCISession  *sessh_;          // OCI Session handle. Do not free this.
   boolean     hasTxn_;          // set if transaction is in progress
   int         csratio_;         // character expansion ratio
+  unsigned int serverVersion_;  // OCIServerRelease, got with the session
   OCIServer   *srvh_;           // OCI server handle
   bool        dropConn_;        // Set flag in case of unusable connection
   string      tag_;             // Session tag
   boolean     retag_;           // How to retag? (leave it, update, clear)
   boolean     sameTag_;         // connection is of same tag as requested?
+
+                                // UDTs described on this session, by name
+  std::map<string, std::shared_ptr<dpi::Udt> > udts_;
+  std::mutex  udtsMutex_;       // getUdt is called from binds and defines
 };
 
 
@@ -80,7 +80,8 @@ OCIDateTime * DateTimeArrayImpl::baseDate_ = NULL;
  ****************************************************************************/
 DateTimeArrayImpl::DateTimeArrayImpl (OCIEnv *envh, OCIError *errh,
                                       const Env* env)
-  : env_(env), envh_ (envh), errh_ (errh), dbdatetime_(NULL)
+  : env_(env), envh_ (envh), errh_ (errh), dbdatetime_(NULL),
+    interval_(NULL)
 {
 
 }
@@ -110,6 +111,10 @@ DateTimeArrayImpl::~DateTimeArrayImpl ()
  * PARAMETERS
  *   nCount       # of descriptors required
  *
+ * NOTE:
+ *   A single interval descriptor is also allocated here and reused for
+ *   every conversion, so that converting the values of a fetch or bind
+ *   does not allocate a descriptor per row.
  ****************************************************************************/
 void *DateTimeArrayImpl::init (int nCount)
 {
@@ -127,7 +132,22 @@ void *DateTimeArrayImpl::init (int nCount)
                                    OCI_DTYPE_TIMESTAMP_LTZ,
                                    nCount, 0, (void **)0);
     if ( rc != OCI_SUCCESS )
+    {
+      delete [] dbdatetime_;
+      dbdatetime_ = NULL;
+      throw ExceptionImpl ( DpiErrInternal ) ;
+    }
+
+    rc = OCIDescriptorAlloc ( (dvoid *)envh_, (void **)&interval_,
+                              OCI_DTYPE_INTERVAL_DS, 0, (dvoid **)0);
+    if ( rc != OCI_SUCCESS )
+    {
+      interval_ = NULL;
+      OCIArrayDescriptorFree ((dvoid **)dbdatetime_, OCI_DTYPE_TIMESTAMP_LTZ);
+      delete [] dbdatetime_;
+      dbdatetime_ = NULL;
       throw ExceptionImpl ( DpiErrInternal ) ;
+    }
   }
   else
   {
@@ -163,6 +183,12 @@ void DateTimeArrayImpl::release ()
     delete [] dbdatetime_;
     dbdatetime_ = NULL;
   }
+
+  if ( interval_ )
+  {
+    OCIDescriptorFree ( interval_, OCI_DTYPE_INTERVAL_DS );
+    interval_ = NULL;
+  }
   env_->releaseDateTimeArray ( this ) ;
 }
 
@@ -189,30 +215,14 @@ long double DateTimeArrayImpl::getDateTime ( const int idx )
 
   if ( dbdatetime_ )
   {
-    void *interval = NULL ;
-
-    rc = OCIDescriptorAlloc ( (dvoid *) envh_, &interval,
-                              OCI_DTYPE_INTERVAL_DS, 0, (dvoid **)0);
-
-    if (rc)
-    {
-      throw ExceptionImpl ( DpiErrInternal );
-    }
-
     /* Get diff of date/timestamp */
     rc = OCIDateTimeSubtract ( envh_, errh_, dbdatetime_[idx], baseDate_,
-                               ( OCIInterval * ) interval );
+                               interval_ );
     ociCall ( rc, errh_ ) ;
 
     // Get the Days, hours, minutes, seconds and fractional seconds
     ociCall ( OCIIntervalGetDaySecond ( envh_, errh_, &dy, &hr, &mm,
-                                        &ss, &fsec,
-                                       ( OCIInterval * ) interval ), errh_ );
-
-    if ( interval )
-    {
-      OCIDescriptorFree ( interval, OCI_DTYPE_INTERVAL_DS );
-    }
+                                        &ss, &fsec, interval_ ), errh_ );
   }
   else
   {
@@ -249,8 +259,6 @@ void DateTimeArrayImpl::setDateTime ( const int idx, long double ms)
 {
   if ( dbdatetime_ )
   {
-    void *interval = NULL;
-    sword       rc        = OCI_SUCCESS ;
     sb4 dy                = 0;
     sb4 hr                = 0;
     sb4 mm                = 0;
@@ -268,28 +276,13 @@ void DateTimeArrayImpl::setDateTime ( const int idx, long double ms)
     ms = ms - (ss * DPI_MS_SECONDS );
     fs = ( sb4 )( ms * DPI_FRAC_SEC_MS );          // Convert the ms into frac sec
 
-    rc = OCIDescriptorAlloc ( (dvoid *) envh_, &interval,
-                              OCI_DTYPE_INTERVAL_DS, 0, (dvoid **)0);
-
-    if (rc)
-    {
-      throw ExceptionImpl ( DpiErrInternal );
-    }
-
     // Convert the given timestamp in ms into interval
     ociCall ( OCIIntervalSetDaySecond ( envh_, errh_, dy, hr, mm,
-                                        ss, fs, ( OCIInterval * ) interval),
-              errh_ );
+                                        ss, fs, interval_ ), errh_ );
 
     // Add the interval to the basedate.
-    ociCall ( OCIDateTimeIntervalAdd ( envh_, errh_, baseDate_,
-                                       ( OCIInterval * ) interval,
+    ociCall ( OCIDateTimeIntervalAdd ( envh_, errh_, baseDate_, interval_,
                                        dbdatetime_[idx] ), errh_ ) ;
-
-    if ( interval )
-    {
-      OCIDescriptorFree ( interval, OCI_DTYPE_INTERVAL_DS );
-    }
   }
   else
   {
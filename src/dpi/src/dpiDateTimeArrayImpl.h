@@ -81,6 +81,9 @@ private:
   // OCI Descriptor array
   OCIDateTime  **dbdatetime_;
 
+  // Interval descriptor reused by getDateTime()/setDateTime()
+  OCIInterval  *interval_;
+
 };
 
 };
@@ -85,7 +85,9 @@ PoolImpl::PoolImpl(EnvImpl *env, OCIEnv *envh,
                    int poolTimeout, bool externalAuth, int stmtCacheSize,
                    bool homogeneous)
   try : env_(env), externalAuth_(externalAuth), envh_(envh), errh_(NULL),
-        spoolh_(NULL), poolName_(NULL), poolAuth_(NULL)
+        spoolh_(NULL), poolName_(NULL), poolAuth_(NULL),
+        poolMax_((unsigned int) poolMax), pingInterval_(-1),
+        serverVersion_(0)
 {
   ub4 mode = OCI_DEFAULT;
   void *errh   = NULL;
@@ -320,7 +322,12 @@ unsigned int PoolImpl::connectionsInUse() const
      created connection
 
    NOTES:
+     The error and auth handles of a released connection are reused when
+     available, only the session is got from the OCI session pool.
 
+     A session idle for pingInterval_ seconds or more is pinged first; if
+     it is unusable it is dropped and another session is got, so that a
+     session cut while idle (e.g. by a firewall) is never handed out.
  */
 
 Conn * PoolImpl::getConnection ( const std::string& connClass,
@@ -330,10 +337,47 @@ Conn * PoolImpl::getConnection ( const std::string& connClass,
                                  const boolean any,
                                  const DBPrivileges dbPriv)
 {
-  Conn *conn = new ConnImpl(this, envh_, externalAuth_, poolName_,
-                            poolNameLen_, connClass, user, password, tag,
-                            any, dbPriv );
-  return conn;
+  for ( ;; )
+  {
+    ConnImpl *conn = NULL;
+
+    {
+      std::lock_guard<std::mutex> lock(freeConnsMutex_);
+
+      if ( !freeConns_.empty () )
+      {
+        conn = freeConns_.back ();
+        freeConns_.pop_back ();
+      }
+    }
+
+    if ( !conn )
+    {
+      conn = new ConnImpl(this, envh_, externalAuth_, poolName_,
+                          poolNameLen_, connClass, user, password, tag,
+                          any, dbPriv );
+    }
+    else
+    {
+      try
+      {
+        conn->reuse ( externalAuth_, poolName_, poolNameLen_, connClass,
+                      user, password, tag, any, dbPriv );
+      }
+      catch (...)
+      {
+        delete conn;
+        throw;
+      }
+    }
+
+    // A new session has never been idle and is not pinged, so this ends
+    // once the dead sessions are dropped
+    if ( pingInterval_ < 0 || conn->isUsable ( pingInterval_ ) )
+      return conn;
+
+    releaseConnection ( conn );
+  }
 }
 
 
@@ -350,11 +394,24 @@ Conn * PoolImpl::getConnection ( const std::string& connClass,
      nothing
 
    NOTES:
-
+     The session goes back to the OCI session pool, the connection object
+     is kept for a later getConnection up to poolMax objects.
  */
 
 void PoolImpl::releaseConnection(ConnImpl *conn)
 {
+  conn->releaseSession();
+
+  {
+    std::lock_guard<std::mutex> lock(freeConnsMutex_);
+
+    if ( freeConns_.size () < poolMax_ )
+    {
+      freeConns_.push_back ( conn );
+      return;
+    }
+  }
+
   delete conn;
 }
 
@@ -384,6 +441,12 @@ void PoolImpl::releaseConnection(ConnImpl *conn)
 
 void PoolImpl::cleanup()
 {
+  for ( size_t i = 0; i < freeConns_.size (); i++ )
+  {
+    delete freeConns_[i];
+  }
+  freeConns_.clear ();
+
   if ( poolAuth_ )
   {
     OCIHandleFree (poolAuth_, OCI_HTYPE_AUTHINFO );
@@ -40,6 +40,10 @@
 # include <dpiConnImpl.h>
 #endif
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 
 using namespace dpi;
 
@@ -73,6 +77,8 @@ class PoolImpl : public SPool
   virtual void stmtCacheSize( unsigned int stmtCacheSize );
   virtual unsigned int connectionsOpen() const;
   virtual unsigned int connectionsInUse() const;
+  virtual void pingInterval( int pingInterval ) { pingInterval_ = pingInterval; }
+  int pingInterval() const { return pingInterval_; }
 
                                 // interface methods
   virtual Conn * getConnection( const std::string& connClass,
@@ -85,6 +91,11 @@ class PoolImpl : public SPool
                                 // internal methods
   virtual void releaseConnection(ConnImpl *conn);
 
+                                // server version of the pool's sessions,
+                                // 0 until the first session is got
+  unsigned int serverVersion() const { return serverVersion_; }
+  void serverVersion(unsigned int ver) { serverVersion_ = ver; }
+
  private:
 
   void cleanup();
@@ -97,6 +108,14 @@ class PoolImpl : public SPool
   OraText     *poolName_;       // pool name
   ub4          poolNameLen_;    // pool name length
   OCIAuthInfo *poolAuth_;       // pool Auth handle
+  unsigned int poolMax_;        // max # of connection shells kept
+  int          pingInterval_;   // see getConnection, < 0 = no ping
+  std::atomic<unsigned int> serverVersion_;
+
+                                // released connections without a session,
+                                // their handles are reused by getConnection
+  std::vector<ConnImpl *> freeConns_;
+  std::mutex   freeConnsMutex_;
 };
 
 
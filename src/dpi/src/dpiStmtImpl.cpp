@@ -53,6 +53,7 @@
 #include <dpiUdtImpl.h>
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <iostream>
 
@@ -281,6 +282,7 @@ void StmtImpl::bind (unsigned int pos, unsigned short type, void *buf,
     cbCtx->nrows      = 0;           /* # of rows - will be filled in later */
     cbCtx->iter       = 0;           /* iteration - will be filled in later */
     cbCtx->dpistmt    = this;        /* DPI Statement implementation object */
+    cbCtxs_.push_back ( cbCtx );               /* freed with the statement */
 
     ociCall (OCIBindDynamic ( b, errh_, (void*)cbCtx,  StmtImpl::inbindCallback,
                               (void*)cbCtx, StmtImpl::outbindCallback ),
@@ -341,6 +343,7 @@ void StmtImpl::bind (const unsigned char *name, int nameLen,
     cbCtx->iter       = 0;           /* iteration - will be filled in later */
     cbCtx->bndpos     = bndpos;               /* position in the bind array */
     cbCtx->dpistmt    = this;        /* DPI Statement implementation object */
+    cbCtxs_.push_back ( cbCtx );               /* freed with the statement */
 
     ociCall (OCIBindDynamic (b, errh_, (void*)cbCtx, StmtImpl::inbindCallback,
                               (void *)cbCtx, StmtImpl::outbindCallback ),
@@ -357,14 +360,21 @@ void StmtImpl::bind (const unsigned char *name, int nameLen,
     PARAMETERS
       autoCommit     - true/false - autocommit enabled or not
       numIterations  - iterations to repeat
+      batchErrors    - true/false - continue past failing iterations and
+                       collect their errors (see getBatchErrors)
 
     RETURNS:
       -None-
 */
-void StmtImpl::execute (int numIterations,  bool autoCommit)
+void StmtImpl::execute (int numIterations,  bool autoCommit, bool batchErrors)
 {
   ub4 mode = autoCommit ? OCI_COMMIT_ON_SUCCESS : OCI_DEFAULT;
 
+  if ( batchErrors )
+  {
+    mode |= OCI_BATCH_ERRORS;
+  }
+
   ociCall (OCIStmtExecute ( svch_, stmth_, errh_, (ub4)numIterations, (ub4)0,
                             (OCISnapshot *)NULL, (OCISnapshot *)NULL, mode),
            errh_ );
@@ -382,6 +392,73 @@ void StmtImpl::execute (int numIterations,  bool autoCommit)
 
 
 
+/****************************************************************************/
+/*
+  DESCRIPTION
+    Obtain the errors of the iterations that failed in the last execution
+    done in batch errors mode.
+
+  PARAMETERS
+    errors (OUT) - one entry per failed iteration
+
+  RETURNS
+    -None-
+*/
+void StmtImpl::getBatchErrors ( std::vector<BatchError> &errors )
+{
+  ub4     numErrors = 0;
+  void    *errh     = NULL;
+
+  errors.clear ();
+
+  ociCall (OCIAttrGet (stmth_, OCI_HTYPE_STMT, &numErrors, 0,
+                       OCI_ATTR_NUM_DML_ERRORS, errh_), errh_);
+  if ( !numErrors )
+  {
+    return;
+  }
+
+  // Each error is described by its own error handle
+  ociCallEnv (OCIHandleAlloc ((void *)envh_, &errh, OCI_HTYPE_ERROR, 0,
+                              (dvoid **)0), envh_);
+
+  try
+  {
+    for ( ub4 i = 0; i < numErrors; i++ )
+    {
+      BatchError batchError;
+      ub4        rowOffset = 0;
+      sb4        errNum    = 0;
+      OraText    errMsg[DPIUTILS_OCI_ERR_MAX_SIZE];
+
+      memset ( errMsg, 0, DPIUTILS_OCI_ERR_MAX_SIZE );
+
+      ociCall (OCIParamGet (errh_, OCI_HTYPE_ERROR, errh_, &errh, i), errh_);
+      ociCall (OCIAttrGet (errh, OCI_HTYPE_ERROR, &rowOffset, 0,
+                           OCI_ATTR_DML_ROW_OFFSET, errh_), errh_);
+
+      if ( OCIErrorGet (errh, 1, NULL, &errNum, errMsg,
+                        DPIUTILS_OCI_ERR_MAX_SIZE - 1, OCI_HTYPE_ERROR) )
+      {
+        throw ExceptionImpl ( DpiErrUnkOciError );
+      }
+
+      batchError.offset  = rowOffset;
+      batchError.errNum  = errNum;
+      batchError.message = (const char *)errMsg;
+      errors.push_back ( batchError );
+    }
+  }
+  catch (...)
+  {
+    OCIHandleFree (errh, OCI_HTYPE_ERROR);
+    throw;
+  }
+
+  OCIHandleFree (errh, OCI_HTYPE_ERROR);
+}
+
+
 
 /****************************************************************************/
 /*
@@ -622,6 +699,11 @@ const MetaData* StmtImpl::getMetaData ( bool extendedMetaData )
 */
 void StmtImpl::cleanup ()
 {
+  for ( size_t i = 0; i < cbCtxs_.size (); i++ )
+  {
+    free ( cbCtxs_[i] );
+  }
+  cbCtxs_.clear ();
   if(meta_)
   {
     delete [] meta_;
@@ -703,7 +785,8 @@ sb4 StmtImpl::inbindCallback ( dvoid *ctxp, OCIBind *bindp, ub4 iter,
   NOTE:
     This function uses specified callback to allocate and identify blocks
     of memory for each cell.  ctxp provides the application specific callback
-    and maxrows.
+    and maxrows.  It is called for every iteration of an array DML, ctxp
+    stays valid till the statement is released.
 */
 sb4 StmtImpl::outbindCallback ( dvoid *ctxp, OCIBind *bindp, ub4 iter,
                                 ub4 index, dvoid **bufpp, ub4 **alenp,
@@ -724,13 +807,9 @@ sb4 StmtImpl::outbindCallback ( dvoid *ctxp, OCIBind *bindp, ub4 iter,
 
     if ( rc != OCI_SUCCESS )
     {
-      errh = cbCtx->dpistmt->errh_ ;      // preserve err handle
-
-      // Cleanup
-      free ( cbCtx ) ;
-      cbCtx = NULL;
+      errh = cbCtx->dpistmt->errh_ ;
 
-      // bail out
+      // bail out, the context is freed with the statement
       ociCall ( rc, errh ) ;
     }
 
@@ -746,22 +825,6 @@ sb4 StmtImpl::outbindCallback ( dvoid *ctxp, OCIBind *bindp, ub4 iter,
                               iter, index, bufpp,
                               (void **)alenp, indpp, rcodepp, piecep );
 
-  /* callback Context was allocated for the life time of the callback,
-   * if this is the last index, de-allocate it
-   */
-  if ( ( index == ( cbCtx->nrows - 1 )) && (*piecep == OCI_ONE_PIECE ) )
-  {
-    free (cbCtx) ;
-    cbCtx = NULL;
-  }
-
-  // Cleanup in case of error from callback.
-  if ( cbret == -1 && cbCtx )
-  {
-    free ( cbCtx );
-    cbCtx = NULL;
-  }
-
   /* If the buffer is insufficient for varchar columns, error out */
   return (cbret == -1 ) ? OCI_ROWCBK_DONE : OCI_CONTINUE ;
 }
@@ -89,7 +89,10 @@ public:
                      dpi::Udt *udt,
                      cbtype cb);
 
-  virtual void execute ( int numIterations, bool autoCommit );
+  virtual void execute ( int numIterations, bool autoCommit,
+                         bool batchErrors );
+
+  virtual void getBatchErrors ( std::vector<BatchError> &errors );
 
   virtual void define (unsigned int pos, unsigned short type, void *buf,
                        DPI_SZ_TYPE bufSize, short *ind, DPI_BUFLEN_TYPE *bufLen, std::shared_ptr<dpi::Udt> &udt);
@@ -140,6 +143,9 @@ private:
   bool           isReturningSet_;  // Has isReturning_ flag queried & set.
   bool           refCursor_;       // refCursor or not.
   ub4            state_;           // OCI Stmt State
+                                   // DML RETURNING callback contexts, kept
+                                   // for all the iterations of an execute
+  std::vector<DpiCallbackCtx *>  cbCtxs_;
 };
 
 
@@ -117,22 +117,20 @@ v8::Local<v8::Value> UdtImpl::ociToJs(void *ociVal, void *ociValNullStruct, unsi
   return res;
 }
 
-v8::Local<v8::Object> UdtImpl::ociObjToJsObj(void *ociObj, void *ociObjHandle, OCIType *ociObjTdo, OCIInd *ociObjNullStruct) const {
-  ub2 fieldsCount;
-  void *fieldsHandle;
-  getOciObjFields(ociObjHandle, fieldsCount, fieldsHandle);
+v8::Local<v8::Object> UdtImpl::ociObjToJsObj(void *ociObj, const TypeInfo &type, OCIType *ociObjTdo, OCIInd *ociObjNullStruct) {
+  auto fieldsCount = type.fields.size();
 
   v8::Local<v8::Object> jsObj;
   if (outFormat_ == NJS_ROWS_ARRAY)
-    jsObj = Nan::New<v8::Array>(fieldsCount);
+    jsObj = Nan::New<v8::Array>((int)fieldsCount);
   else
     jsObj = Nan::New<v8::Object>();
 
-  for (ub2 i = 1; i <= fieldsCount; i++) {
-    const oratext *fieldNamePtr;
-    ub4 fieldNameSize;
-    OCITypeCode fieldTypecode;
-    getOciObjField(fieldsHandle, i, fieldNamePtr, fieldNameSize, fieldTypecode);
+  for (size_t i = 0; i < fieldsCount; i++) {
+    const FieldInfo &field = type.fields[i];
+    auto fieldNamePtr = (const oratext*)field.name.data();
+    auto fieldNameSize = (ub4)field.name.size();
+    OCITypeCode fieldTypecode = field.typecode;
 
     OCIType *fieldTdo = nullptr;
     OCIInd *fieldNullStruct = nullptr;
@@ -156,9 +154,9 @@ v8::Local<v8::Object> UdtImpl::ociObjToJsObj(void *ociObj, void *ociObjHandle, O
     }
 
     if (jsObj->IsArray())
-      Nan::Set(jsObj.As<v8::Array>(), i - 1, val);
+      Nan::Set(jsObj.As<v8::Array>(), (uint32_t)i, val);
     else {
-      auto jsFieldName = Nan::New<v8::String>((char*)fieldNamePtr, fieldNameSize).ToLocalChecked();
+      auto jsFieldName = Nan::New<v8::String>(field.name).ToLocalChecked();
       Nan::Set(jsObj.As<v8::Object>(), jsFieldName, val);
     }
   }
@@ -166,15 +164,9 @@ v8::Local<v8::Object> UdtImpl::ociObjToJsObj(void *ociObj, void *ociObjHandle, O
   return jsObj;
 }
 
-v8::Local<v8::Array> UdtImpl::ociNestedTableToJsArr(OCIColl *ociTab, void *ociTabHandle) const {
-  void *collElemHandle = nullptr;
-  ociCall (OCIAttrGet (ociTabHandle, OCI_DTYPE_PARAM, &collElemHandle, 0, OCI_ATTR_COLLECTION_ELEMENT, errh_), errh_);
-  OCIRef *collElemTypeRef = nullptr;
-  ociCall (OCIAttrGet (collElemHandle, OCI_DTYPE_PARAM, &collElemTypeRef, 0, OCI_ATTR_REF_TDO, errh_), errh_);
-  OCIType *collElemType;
-  ociCall (OCITypeByRef (envh_, errh_, collElemTypeRef, OCI_DURATION_SESSION, OCI_TYPEGET_HEADER, &collElemType), errh_);
-  OCITypeCode collElemTypecode;
-  ociCall (OCIAttrGet (collElemHandle, OCI_DTYPE_PARAM, &collElemTypecode, 0, OCI_ATTR_TYPECODE, errh_), errh_);
+v8::Local<v8::Array> UdtImpl::ociNestedTableToJsArr(OCIColl *ociTab, const TypeInfo &type) {
+  OCIType *collElemType = type.elemTdo;
+  OCITypeCode collElemTypecode = type.elemTypecode;
 
   sb4 collSize = 0;
   ociCall (OCICollSize (envh_, errh_, ociTab, &collSize), errh_);
@@ -203,31 +195,20 @@ v8::Local<v8::Array> UdtImpl::ociNestedTableToJsArr(OCIColl *ociTab, void *ociTa
   return arr;
 }
 
-v8::Local<v8::Value> UdtImpl::ociToJs(void *ociVal, OCIType *ociValTdo, OCIInd *ociValNullStruct) const {
+v8::Local<v8::Value> UdtImpl::ociToJs(void *ociVal, OCIType *ociValTdo, OCIInd *ociValNullStruct) {
   if (*ociValNullStruct == OCI_IND_NULL)
     return Nan::Null();
 
-  OCIDescribe *describeHandle = nullptr;
-  void *paramHandle = nullptr;
-  OCITypeCode typecode = 0;
-  describeOciTdo(ociValTdo, describeHandle, paramHandle, typecode);
+  const TypeInfo &type = getTypeInfo(ociValTdo);
 
-  v8::Local<v8::Value> jsObj;
-  switch (typecode) {
+  switch (type.typecode) {
     case OCI_TYPECODE_OBJECT:
-      jsObj = ociObjToJsObj(ociVal, paramHandle, ociValTdo, ociValNullStruct);
-      break;
+      return ociObjToJsObj(ociVal, type, ociValTdo, ociValNullStruct);
     case OCI_TYPECODE_TABLE:
-      jsObj = ociNestedTableToJsArr((OCITable*)ociVal, paramHandle);
-      break;
+      return ociNestedTableToJsArr((OCITable*)ociVal, type);
     default:
-      jsObj = Nan::Null();
-      break;
+      return Nan::Null();
   }
-
-  ociCall (OCIHandleFree (describeHandle, OCI_HTYPE_DESCRIBE), errh_);
-
-  return jsObj;
 }
 
 void * UdtImpl::jsToOci(v8::Local<v8::Object> jsObj, void *&ind) {
@@ -318,15 +299,9 @@ static map<string, string> getLowerCaseJsPropNames(v8::Local<v8::Object> jsObj)
   return names;
 }
 
-void UdtImpl::jsArrToOciNestedTable(v8::Local<v8::Array> jsArr, OCIColl *ociTab, void *ociTabHandle) {
-  void *collElemHandle = nullptr;
-  ociCall (OCIAttrGet (ociTabHandle, OCI_DTYPE_PARAM, &collElemHandle, 0, OCI_ATTR_COLLECTION_ELEMENT, errh_), errh_);
-  OCIRef *collElemTypeRef = nullptr;
-  ociCall (OCIAttrGet (collElemHandle, OCI_DTYPE_PARAM, &collElemTypeRef, 0, OCI_ATTR_REF_TDO, errh_), errh_);
-  OCIType *collElemType;
-  ociCall (OCITypeByRef (envh_, errh_, collElemTypeRef, OCI_DURATION_SESSION, OCI_TYPEGET_HEADER, &collElemType), errh_);
-  OCITypeCode collElemTypecode;
-  ociCall (OCIAttrGet (collElemHandle, OCI_DTYPE_PARAM, &collElemTypecode, 0, OCI_ATTR_TYPECODE, errh_), errh_);
+void UdtImpl::jsArrToOciNestedTable(v8::Local<v8::Array> jsArr, OCIColl *ociTab, const TypeInfo &type) {
+  OCIType *collElemType = type.elemTdo;
+  OCITypeCode collElemTypecode = type.elemTypecode;
 
   for (uint32_t i = 0; i < jsArr->Length(); ++i) {
     v8::Local<v8::Value> jsVal = jsArr->Get(i);
@@ -361,24 +336,73 @@ void UdtImpl::getOciObjField(void *fieldsHandle, ub2 fieldIndex, const oratext *
   ociCall (OCIAttrGet (fieldHandle, OCI_DTYPE_PARAM, &fieldTypecode, 0, OCI_ATTR_TYPECODE, errh_), errh_);
 }
 
-void UdtImpl::jsObjToOciObj(v8::Local<v8::Object> jsObj, void *ociObj, void *ociObjHandle, OCIType *ociObjTdo, OCIInd *ind) {
-  ub2 fieldsCount;
-  void *fieldsHandle;
-  getOciObjFields(ociObjHandle, fieldsCount, fieldsHandle);
-  auto lowerCaseJsPropNames = getLowerCaseJsPropNames(jsObj);
+void UdtImpl::getOciCollElem(void *ociTabHandle, OCIType *&collElemTdo, OCITypeCode &collElemTypecode) const {
+  void *collElemHandle = nullptr;
+  ociCall (OCIAttrGet (ociTabHandle, OCI_DTYPE_PARAM, &collElemHandle, 0, OCI_ATTR_COLLECTION_ELEMENT, errh_), errh_);
+  OCIRef *collElemTypeRef = nullptr;
+  ociCall (OCIAttrGet (collElemHandle, OCI_DTYPE_PARAM, &collElemTypeRef, 0, OCI_ATTR_REF_TDO, errh_), errh_);
+  ociCall (OCITypeByRef (envh_, errh_, collElemTypeRef, OCI_DURATION_SESSION, OCI_TYPEGET_HEADER, &collElemTdo), errh_);
+  ociCall (OCIAttrGet (collElemHandle, OCI_DTYPE_PARAM, &collElemTypecode, 0, OCI_ATTR_TYPECODE, errh_), errh_);
+}
+
+// Types are pinned for the session, so a TDO describes the same type for as
+// long as this object (owned by the connection) is alive
+const UdtImpl::TypeInfo & UdtImpl::getTypeInfo(OCIType *tdo) {
+  auto it = types_.find(tdo);
+  if (it != types_.end())
+    return it->second;
+
+  OCIDescribe *describeHandle = nullptr;
+  void *paramHandle = nullptr;
+  TypeInfo type;
+  type.typecode = 0;
+  type.elemTdo = nullptr;
+  type.elemTypecode = 0;
+
+  try {
+    describeOciTdo(tdo, describeHandle, paramHandle, type.typecode);
+
+    if (type.typecode == OCI_TYPECODE_OBJECT) {
+      ub2 fieldsCount;
+      void *fieldsHandle;
+      getOciObjFields(paramHandle, fieldsCount, fieldsHandle);
+
+      type.fields.resize(fieldsCount);
+      for (ub2 i = 1; i <= fieldsCount; i++) {
+        const oratext *fieldNamePtr;
+        ub4 fieldNameSize;
+        FieldInfo &field = type.fields[i - 1];
+        getOciObjField(fieldsHandle, i, fieldNamePtr, fieldNameSize, field.typecode);
+        field.name.assign((const char*)fieldNamePtr, fieldNameSize);
+        field.lowerName = toLower(field.name);
+      }
+    }
+    else if (type.typecode == OCI_TYPECODE_TABLE)
+      getOciCollElem(paramHandle, type.elemTdo, type.elemTypecode);
+  } catch (...) {
+    if (describeHandle)
+      OCIHandleFree (describeHandle, OCI_HTYPE_DESCRIBE);
+    throw;
+  }
+
+  ociCall (OCIHandleFree (describeHandle, OCI_HTYPE_DESCRIBE), errh_);
+
+  return types_[tdo] = type;
+}
 
-  for (ub2 i = 1; i <= fieldsCount; i++) {
-    const oratext *fieldNamePtr;
-    ub4 fieldNameSize;
-    OCITypeCode fieldTypecode;
-    getOciObjField(fieldsHandle, i, fieldNamePtr, fieldNameSize, fieldTypecode);
+void UdtImpl::jsObjToOciObj(v8::Local<v8::Object> jsObj, void *ociObj, const TypeInfo &type, OCIType *ociObjTdo, OCIInd *ind) {
+  auto lowerCaseJsPropNames = getLowerCaseJsPropNames(jsObj);
 
-    string lowerCaseOciFieldName(toLower(string((char*)fieldNamePtr, fieldNameSize)));
+  for (const FieldInfo &field : type.fields) {
+    auto fieldNamePtr = (const oratext*)field.name.data();
+    auto fieldNameSize = (ub4)field.name.size();
+    OCITypeCode fieldTypecode = field.typecode;
 
-    if (lowerCaseJsPropNames.count(lowerCaseOciFieldName) == 0)
+    auto jsPropName = lowerCaseJsPropNames.find(field.lowerName);
+    if (jsPropName == lowerCaseJsPropNames.end())
       continue;
 
-    string jsFieldName = lowerCaseJsPropNames[lowerCaseOciFieldName];
+    const string &jsFieldName = jsPropName->second;
     v8::Local<v8::Value> jsField = jsObj->Get(Nan::New<v8::String>(jsFieldName).ToLocalChecked());
 
     if (jsField->IsNull())
@@ -425,11 +449,8 @@ void * UdtImpl::jsToOci(v8::Local<v8::Value> jsVal, OCIType *ociValTdo, OCIInd *
   if (!jsVal->IsArray() && !jsVal->IsObject())
     throw UdtException("only js array or object allowed for UDT binds");
 
-  void *paramHandle = nullptr;
-  OCIDescribe *describeHandle = nullptr;
-  OCITypeCode typecode = 0;
-
-  describeOciTdo(ociValTdo, describeHandle, paramHandle, typecode);
+  const TypeInfo &type = getTypeInfo(ociValTdo);
+  OCITypeCode typecode = type.typecode;
 
   if (jsVal->IsArray() && typecode != OCI_TYPECODE_TABLE)
     throw UdtException("js array binding possible only to oracle nested table datatype");
@@ -441,12 +462,9 @@ void * UdtImpl::jsToOci(v8::Local<v8::Value> jsVal, OCIType *ociValTdo, OCIInd *
   ociCall(OCIObjectGetInd(envh_, errh_, ociObj, (void**)&ind), errh_);
 
   if (jsVal->IsArray())
-    jsArrToOciNestedTable(v8::Local<v8::Array>::Cast(jsVal), (OCIColl*)ociObj, paramHandle);
+    jsArrToOciNestedTable(v8::Local<v8::Array>::Cast(jsVal), (OCIColl*)ociObj, type);
   else if (jsVal->IsObject())
-    jsObjToOciObj(jsVal->ToObject(), ociObj, paramHandle, ociValTdo, ind);
-
-  if (describeHandle)
-    ociCall (OCIHandleFree (describeHandle, OCI_HTYPE_DESCRIBE), errh_);
+    jsObjToOciObj(jsVal->ToObject(), ociObj, type, ociValTdo, ind);
 
   return ociObj;
 }
@@ -4,6 +4,8 @@
 #include <dpiEnv.h>
 #include <dpiUdt.h>
 #include <string>
+#include <vector>
+#include <map>
 #include "dpiExceptionImpl.h"
 
 namespace dpi
@@ -24,6 +26,21 @@ public:
 
   const OCIType * getType() const;
 private:
+  // Describe results of an object or collection type, resolved once per
+  // TDO so that converting a value only costs OCIObjectGetAttr per field
+  struct FieldInfo {
+    std::string name;        // attribute name as described by OCI
+    std::string lowerName;   // used to match js property names
+    OCITypeCode typecode;
+  };
+
+  struct TypeInfo {
+    OCITypeCode typecode;            // OBJECT or collection typecode
+    std::vector<FieldInfo> fields;   // OBJECT attributes
+    OCIType *elemTdo;                // TABLE element type
+    OCITypeCode elemTypecode;
+  };
+
   OCIEnv    *envh_;
   OCISvcCtx *svch_;
   OCIError  *errh_;
@@ -31,21 +48,24 @@ private:
   unsigned int outFormat_;
   OCINumber    _num;
   OCIDate      _date;
+  std::map<const OCIType*, TypeInfo> types_;
 
-  v8::Local<v8::Value> ociToJs(void *ociVal, OCIType *ociValTdo, OCIInd *ociValNullStruct) const;
-  v8::Local<v8::Object> ociObjToJsObj(void *ociObj, void *ociObjHandle, OCIType *ociObjTdo, OCIInd *ociObjNullStruct) const;
-  v8::Local<v8::Array> ociNestedTableToJsArr(OCIColl *ociTab, void *ociTabHandle) const;
-  v8::Local<v8::Value> UdtImpl::ociPrimitiveToJsPrimitive(void *ociPrimitive, OCIInd ociPrimitiveInd, OCITypeCode ociPrimitiveTypecode) const;
+  v8::Local<v8::Value> ociToJs(void *ociVal, OCIType *ociValTdo, OCIInd *ociValNullStruct);
+  v8::Local<v8::Object> ociObjToJsObj(void *ociObj, const TypeInfo &type, OCIType *ociObjTdo, OCIInd *ociObjNullStruct);
+  v8::Local<v8::Array> ociNestedTableToJsArr(OCIColl *ociTab, const TypeInfo &type);
+  v8::Local<v8::Value> ociPrimitiveToJsPrimitive(void *ociPrimitive, OCIInd ociPrimitiveInd, OCITypeCode ociPrimitiveTypecode) const;
 
   void * jsToOci(v8::Local<v8::Value> jsVal, OCIType *ociValTdo, OCIInd *&ind);
-  void jsObjToOciObj(v8::Local<v8::Object> jsObj, void *ociObj, void *ociObjHandle, OCIType *ociObjTdo, OCIInd *ind);
-  void jsArrToOciNestedTable(v8::Local<v8::Array> jsArr, OCIColl *ociTab, void *ociTabHandle);
+  void jsObjToOciObj(v8::Local<v8::Object> jsObj, void *ociObj, const TypeInfo &type, OCIType *ociObjTdo, OCIInd *ind);
+  void jsArrToOciNestedTable(v8::Local<v8::Array> jsArr, OCIColl *ociTab, const TypeInfo &type);
   void * jsPrimitiveToOciPrimitive(v8::Local<v8::Value> jsPrimitive, OCITypeCode ociPrimitiveTypecode);
 
   static double ocidateToMsecSinceEpoch(const OCIDate *date);
   static OCIDate msecSinceEpochToOciDate(double msec);
+  const TypeInfo & getTypeInfo(OCIType *tdo);
   void getOciObjFields(void *ociObjHandle, ub2 &fieldsCount, void *&fieldsHandle) const;
   void getOciObjField(void *fieldsHandle, ub2 fieldIndex, const oratext *&fieldNamePtr, ub4 &fieldNameSize, OCITypeCode &fieldTypecode) const;
+  void getOciCollElem(void *ociTabHandle, OCIType *&collElemTdo, OCITypeCode &collElemTypecode) const;
   void describeOciTdo(OCIType *tdo, OCIDescribe *&describeHandle, void *&paramHandle, OCITypeCode &typecode) const;
 };
 
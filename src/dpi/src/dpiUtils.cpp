@@ -38,13 +38,6 @@
   #define  snprintf  _snprintf
 #endif
 
-#ifdef OCI_ERROR_MAXMSG_SIZE2
-/* A bigger message size is defined from 11.2.0.3 onwards */
-#define DPIUTILS_OCI_ERR_MAX_SIZE OCI_ERROR_MAXMSG_SIZE2
-#else
-#define DPIUTILS_OCI_ERR_MAX_SIZE OCI_ERROR_MAXMSG_SIZE
-#endif
-
 /*****************************************************************************/
 /*
    DESCRIPTION
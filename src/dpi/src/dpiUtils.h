@@ -36,6 +36,12 @@
 /*---------------------------------------------------------------------------
                      PUBLIC CONSTANTS AND MACROS
   ---------------------------------------------------------------------------*/
+#ifdef OCI_ERROR_MAXMSG_SIZE2
+/* A bigger message size is defined from 11.2.0.3 onwards */
+#define DPIUTILS_OCI_ERR_MAX_SIZE OCI_ERROR_MAXMSG_SIZE2
+#else
+#define DPIUTILS_OCI_ERR_MAX_SIZE OCI_ERROR_MAXMSG_SIZE
+#endif
 
 
 /*---------------------------------------------------------------------------
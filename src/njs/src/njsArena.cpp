@@ -0,0 +1,185 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *  njsArena.cpp
+ *
+ * DESCRIPTION
+ *  Arena class implementation.
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "njsArena.h"
+
+// Rounds up to a multiple of NJS_ARENA_ALIGNMENT
+#define NJS_ARENA_ALIGN( size )                                               \
+  ( ( (size) + NJS_ARENA_ALIGNMENT - 1 ) &                                    \
+    ~( (size_t) NJS_ARENA_ALIGNMENT - 1 ) )
+
+// Size of the block header, the allocations follow it
+#define NJS_ARENA_HEADER_SIZE    NJS_ARENA_ALIGN ( sizeof ( Block ) )
+
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Allocates from the arena.
+
+   PARAMETERS:
+     size - # of bytes
+
+   RETURNS:
+     aligned buffer valid until reset () or release (), NULL if out of memory
+
+   NOTES:
+     Allocations larger than a block get a block of their own.  A block
+     kept by reset () is reused if it is large enough.
+*/
+void * Arena::alloc ( size_t size )
+{
+  Block *block = blocks_;
+  void  *buf;
+
+  if ( size > (size_t) -1 - NJS_ARENA_ALIGNMENT - NJS_ARENA_HEADER_SIZE )
+  {
+    return NULL;
+  }
+
+  size = NJS_ARENA_ALIGN ( size ? size : 1 );
+
+  if ( !block || block->size - block->used < size )
+  {
+    Block **prev = &spare_;
+
+    // Look for a spare block first
+    while ( *prev && (*prev)->size < size )
+    {
+      prev = &(*prev)->next;
+    }
+
+    if ( *prev )
+    {
+      block = *prev;
+      *prev = block->next;
+    }
+    else
+    {
+      block = newBlock ( ( size > NJS_ARENA_BLOCK_SIZE ) ?
+                         size : NJS_ARENA_BLOCK_SIZE );
+      if ( !block )
+      {
+        return NULL;
+      }
+    }
+
+    block->next = blocks_;
+    blocks_     = block;
+  }
+
+  buf          = (char *) block + NJS_ARENA_HEADER_SIZE + block->used;
+  block->used += size;
+
+  return buf;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Allocates a zero filled array from the arena.
+
+   PARAMETERS:
+     count - # of elements
+     size  - size of an element
+
+   RETURNS:
+     aligned buffer, NULL if out of memory
+*/
+void * Arena::calloc ( size_t count, size_t size )
+{
+  void *buf = NULL;
+
+  if ( !size || count <= (size_t) -1 / size )
+  {
+    buf = alloc ( count * size );
+    if ( buf )
+    {
+      memset ( buf, 0, count * size );
+    }
+  }
+
+  return buf;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Releases all the allocations.  The blocks are kept as spare blocks.
+*/
+void Arena::reset ()
+{
+  while ( blocks_ )
+  {
+    Block *block = blocks_;
+
+    blocks_     = block->next;
+    block->used = 0;
+    block->next = spare_;
+    spare_      = block;
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Releases all the allocations and frees the blocks.
+*/
+void Arena::release ()
+{
+  freeBlocks ( blocks_ );
+  freeBlocks ( spare_ );
+  blocks_ = spare_ = NULL;
+}
+
+Arena::Block * Arena::newBlock ( size_t size )
+{
+  Block *block = (Block *) malloc ( NJS_ARENA_HEADER_SIZE + size );
+
+  if ( block )
+  {
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+  }
+
+  return block;
+}
+
+void Arena::freeBlocks ( Block *block )
+{
+  while ( block )
+  {
+    Block *next = block->next;
+
+    free ( block );
+    block = next;
+  }
+}
+
+
+/* end of file njsArena.cpp */
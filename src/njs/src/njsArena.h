@@ -0,0 +1,81 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *  njsArena.h
+ *
+ * DESCRIPTION
+ *  Arena class
+ *
+ *  Bump allocator for the bind, indicator, length and define buffers of one
+ *  execute() or of the fetch buffers of a ResultSet.  Buffers are carved
+ *  from a few large blocks and are never freed one by one: reset() releases
+ *  all of them at once and keeps the blocks for the next use, release()
+ *  returns the blocks to the heap.
+ *
+ *  An arena is used by one thread at a time, like the baton owning it.
+ *
+ ******************************************************************************/
+
+#ifndef __NJSARENA_H__
+#define __NJSARENA_H__
+
+#include <stddef.h>
+
+#define NJS_ARENA_BLOCK_SIZE      16384
+#define NJS_ARENA_ALIGNMENT          16     // enough for long double
+
+class Arena
+{
+public:
+
+  Arena () : blocks_ ( NULL ), spare_ ( NULL ) {}
+  ~Arena () { release (); }
+
+  // Returns size bytes aligned for any bind/define type, NULL if no memory
+  void * alloc ( size_t size );
+
+  // As alloc, zero filled
+  void * calloc ( size_t count, size_t size );
+
+  // Releases all the allocations, the blocks are kept for reuse
+  void reset ();
+
+  // Releases all the allocations and the blocks
+  void release ();
+
+private:
+
+  typedef struct Block
+  {
+    Block  *next;
+    size_t  size;                 // bytes available after the header
+    size_t  used;
+  } Block;
+
+  static Block * newBlock ( size_t size );
+  static void freeBlocks ( Block *block );
+
+  Block  *blocks_;                // in use, most recent first
+  Block  *spare_;                 // released by reset ()
+
+  // not copyable, the allocations belong to this arena
+  Arena ( const Arena & );
+  Arena & operator= ( const Arena & );
+};
+
+#endif                                             /* __NJSARENA_H__ */
@@ -52,8 +52,13 @@
 #include "njsConnection.h"
 #include "njsResultSet.h"
 #include "njsIntLob.h"
+#include "njsPool.h"
+#include "njsThreadPool.h"
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <limits>
+#include <unordered_set>
 using namespace std;
 
 // persistent Connection class handle
@@ -65,9 +70,16 @@ Nan::Persistent<FunctionTemplate> Connection::connectionTemplate_s;
 // max number of bytes for data converted to string with fetchAsString or fetchInfo
 #define NJS_MAX_FETCH_AS_STRING_SIZE 200
 
+// max number of bytes of a LOB fetched as String or Buffer, within the
+// String length limit of V8
+#define NJS_MAX_FETCH_AS_LOB_SIZE ( ( 1 << 28 ) - 16 )
+
 // number of rows prefetched by non-ResultSet queries
 #define NJS_PREFETCH_NON_RESULTSET 2
 
+// max size of the define buffers of a query layout kept for reuse
+#define NJS_QUERY_CACHE_MAX_BYTES 262144
+
 #define NJS_SIZE_T_MAX std::numeric_limits<std::size_t>::max()
 
 #define NJS_SIZE_T_OVERFLOW(maxSize,maxRows)                                  \
@@ -84,7 +96,10 @@ Connection::Connection()
 {
    dpiconn_             = (dpi::Conn *)0;
    oracledb_            = (Oracledb *)0;
+   njspool_             = (Pool *)0;
    oracleServerVersion_ = 0;
+   queryCacheSize_      = 0;
+   queryCacheUses_      = 0;
 }
 
 /*****************************************************************************/
@@ -93,7 +108,9 @@ Connection::Connection()
      Destructor for the Connection class.
  */
 Connection::~Connection()
-{}
+{
+   clearQueryCache ();
+}
 
 /*****************************************************************************/
 /*
@@ -101,9 +118,11 @@ Connection::~Connection()
      Initialize connection attributes after forming it.
 
    PARAMETERS:
-     DPI Connection, Oracledb reference, reference to js parent
+     DPI Connection, Oracledb reference, reference to js parent,
+     Pool the connection was obtained from (if any)
 */
-void Connection::setConnection(dpi::Conn* dpiconn, Oracledb* oracledb, Local<Object> jsParentObj)
+void Connection::setConnection(dpi::Conn* dpiconn, Oracledb* oracledb,
+                               Local<Object> jsParentObj, Pool* njspool)
 {
    this->dpiconn_   = dpiconn;
    this->isValid_   = true;
@@ -111,6 +130,17 @@ void Connection::setConnection(dpi::Conn* dpiconn, Oracledb* oracledb, Local<Obj
    this->lobCount_  = 0;
    this->rsCount_   = 0;
    this->dbCount_   = 0;
+   this->njspool_   = njspool;
+
+   // Query layouts are kept for as many statements as the statement cache
+   try
+   {
+     this->queryCacheSize_ = dpiconn->stmtCacheSize ();
+   }
+   catch ( dpi::Exception & )
+   {
+     this->queryCacheSize_ = 0;
+   }
 
    this->jsParent_.Reset ( jsParentObj );
 }
@@ -130,6 +160,7 @@ void Connection::Init(Handle<Object> target)
   tpl->SetClassName(Nan::New<v8::String>("Connection").ToLocalChecked());
 
   Nan::SetPrototypeMethod(tpl, "execute", Execute);
+  Nan::SetPrototypeMethod(tpl, "executeMany", ExecuteMany);
   Nan::SetPrototypeMethod(tpl, "release", Release);
   Nan::SetPrototypeMethod(tpl, "commit", Commit);
   Nan::SetPrototypeMethod(tpl, "rollback", Rollback);
@@ -368,6 +399,10 @@ NAN_SETTER(Connection::SetAction)
 /*
   DESCRIPTION
     Get Accessor of OracleServerVersion Property
+
+  NOTES
+    The version was got by the worker thread creating the connection, no
+    round trip is made here.
 */
 NAN_GETTER (Connection::GetOracleServerVersion)
 {
@@ -379,16 +414,13 @@ NAN_GETTER (Connection::GetOracleServerVersion)
     string error = NJSMessages::getErrorMsg ( errInvalidConnection );
     NJS_SET_EXCEPTION ( error.c_str() );
     info.GetReturnValue().SetUndefined();
+    return;
   }
 
   try
   {
     if ( !njsConn->oracleServerVersion_ )
     {
-      /* Updating the member variable is not thread-safe, but all threads
-       * will get same value from DB and update the value which is atomic
-       * and so it is ok.
-       */
       unsigned int ver = njsConn->dpiconn_->getServerVersion ();
 
       njsConn-> oracleServerVersion_ =
@@ -471,6 +503,10 @@ NAN_METHOD(Connection::Execute)
     (DataType*) connection->oracledb_->getFetchAsStringTypes ();
   executeBaton->fetchAsStringTypesCount =
     connection->oracledb_->getFetchAsStringTypesCount ();
+  executeBaton->fetchAsBufferTypes =
+    (DataType*) connection->oracledb_->getFetchAsBufferTypes ();
+  executeBaton->fetchAsBufferTypesCount =
+    connection->oracledb_->getFetchAsBufferTypesCount ();
 
   executeBaton->dpiconn            = connection->dpiconn_;
   executeBaton->njsconn            = connection;
@@ -479,8 +515,10 @@ NAN_METHOD(Connection::Execute)
 
   // In case of no fetchAs and memory allocation failure fetchAsStringTypes
   // will be NULL.  Check the combination of Count & types.
-  if ( ( executeBaton->fetchAsStringTypesCount > 0 ) &&
-       !executeBaton->fetchAsStringTypes )
+  if ( ( ( executeBaton->fetchAsStringTypesCount > 0 ) &&
+         !executeBaton->fetchAsStringTypes ) ||
+       ( ( executeBaton->fetchAsBufferTypesCount > 0 ) &&
+         !executeBaton->fetchAsBufferTypes ) )
   {
     executeBaton->error = NJSMessages::getErrorMsg ( errInsufficientMemory );
     goto exitExecute;
@@ -497,16 +535,111 @@ NAN_METHOD(Connection::Execute)
      if(!executeBaton->error.empty()) goto exitExecute;
   }
 
+  connection->checkoutQuery ( executeBaton );
+
   exitExecute:
   executeBaton->req.data  = (void*) executeBaton;
-  int status = uv_queue_work(uv_default_loop(), &executeBaton->req,
-               Async_Execute, (uv_after_work_cb)Async_AfterExecute);
-  // delete the Baton if uv_queue_work fails
+  int status = ThreadPool::queueWork(&executeBaton->req,
+               Async_Execute, (uv_after_work_cb)Async_AfterExecute,
+               connection);
+  // delete the Baton if queueWork fails
+  if ( status )
+  {
+    delete executeBaton;
+    string error = NJSMessages::getErrorMsg ( errInternalError,
+                                              "queueWork", "Execute" );
+    NJS_SET_EXCEPTION ( error.c_str() );
+  }
+
+  info.GetReturnValue().SetUndefined();
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     ExecuteMany method on Connection class.
+     Executes a DML statement or PL/SQL block once for every row of bind
+     values, using a single round trip.
+
+   PARAMETERS:
+     Arguments - SQL Statement,
+                 Array of bind rows (each row an Array or an Object),
+                 Options Object (Optional),
+                 Callback
+*/
+NAN_METHOD(Connection::ExecuteMany)
+{
+  Local<Function> callback;
+  Local<String> sql;
+  Local<Value> bindDefs = Nan::Undefined ();
+  Connection *connection;
+  NJS_GET_CALLBACK ( callback, info );
+
+  connection = Nan::ObjectWrap::Unwrap<Connection>(info.Holder());
+
+  /* If connection is invalid from JS, then throw an exception */
+  NJS_CHECK_OBJECT_VALID2 ( connection, info ) ;
+
+  eBaton *executeBaton = new eBaton ( connection->DBCount (), callback,
+                                      info.Holder () );
+
+  NJS_CHECK_NUMBER_OF_ARGS ( executeBaton->error, info, 3, 4,
+                             exitExecuteMany );
+
+  if(!connection->isValid_)
+  {
+    executeBaton->error = NJSMessages::getErrorMsg ( errInvalidConnection );
+    goto exitExecuteMany;
+  }
+  NJS_GET_ARG_V8STRING (sql, executeBaton->error, info, 0, exitExecuteMany);
+  NJSString (executeBaton->sql, sql);
+
+  executeBaton->autoCommit         = connection->oracledb_->getAutoCommit();
+  executeBaton->dpienv             = connection->oracledb_->getDpiEnv();
+  executeBaton->dpiconn            = connection->dpiconn_;
+  executeBaton->njsconn            = connection;
+
+  if ( !info[1]->IsArray () )
+  {
+    executeBaton->error = NJSMessages::getErrorMsg ( errInvalidParameterType,
+                                                     2 );
+    goto exitExecuteMany;
+  }
+
+  if ( info.Length () > 3 )
+  {
+    Local<Object> options;
+
+    if ( !info[2]->IsObject () || info[2]->IsArray () )
+    {
+      executeBaton->error = NJSMessages::getErrorMsg (
+                                                 errInvalidParameterType, 3 );
+      goto exitExecuteMany;
+    }
+    options = info[2]->ToObject ();
+
+    NJS_GET_BOOL_FROM_JSON ( executeBaton->autoCommit, executeBaton->error,
+                             options, "autoCommit", 2, exitExecuteMany );
+    NJS_GET_BOOL_FROM_JSON ( executeBaton->batchErrors, executeBaton->error,
+                             options, "batchErrors", 2, exitExecuteMany );
+    bindDefs = options->Get ( Nan::New<v8::String>(
+                                          "bindDefs" ).ToLocalChecked () );
+  }
+
+  Connection::GetBindsMany ( Local<Array>::Cast ( info[1] ), bindDefs,
+                             executeBaton );
+
+  exitExecuteMany:
+  executeBaton->req.data  = (void*) executeBaton;
+  int status = ThreadPool::queueWork(&executeBaton->req,
+               Async_ExecuteMany, (uv_after_work_cb)Async_AfterExecuteMany,
+               connection);
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete executeBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work", "Execute" );
+                                              "queueWork", "ExecuteMany" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
 
@@ -581,6 +714,8 @@ void Connection::ProcessOptions (Nan::NAN_METHOD_ARGS_TYPE args, unsigned int in
     NJS_GET_BOOL_FROM_JSON ( executeBaton->extendedMetaData,
                              executeBaton->error, options, "extendedMetaData",
                              2, exitProcessOptions );
+    NJS_GET_BOOL_FROM_JSON ( executeBaton->fetchAhead, executeBaton->error,
+                             options, "fetchAhead", 2, exitProcessOptions );
 
     // Optional fetchAs specifications
     Local<Value> val = options->Get(Nan::New<v8::String>("fetchInfo").ToLocalChecked());
@@ -605,18 +740,26 @@ void Connection::ProcessOptions (Nan::NAN_METHOD_ARGS_TYPE args, unsigned int in
 
           NJS_GET_UINT_FROM_JSON (tmptype, executeBaton->error,
                                   colInfo, "type", 2, exitProcessOptions );
+          NJS_GET_BOOL_FROM_JSON (fInfo[index].dedup, executeBaton->error,
+                                  colInfo, "dedup", 2, exitProcessOptions );
           if ( tmptype == 0xFFFFFFFF )
           {
-            executeBaton->error = NJSMessages::getErrorMsg (
-                                                  errNoTypeForConversion );
-            goto exitProcessOptions;
+            // type may be left out when only dedup is given
+            if ( !fInfo[index].dedup )
+            {
+              executeBaton->error = NJSMessages::getErrorMsg (
+                                                    errNoTypeForConversion );
+              goto exitProcessOptions;
+            }
+            tmptype = NJS_DATATYPE_DEFAULT;
           }
 
           fInfo[index].type = (DataType) tmptype;
 
-          // Only Conversion to STRING allowed now. Either STRING or DB type.
+          // Either STRING, BUFFER (for BLOBs) or DB type.
           if ( ( fInfo[index].type != NJS_DATATYPE_DEFAULT ) &&
-               ( fInfo[index].type != NJS_DATATYPE_STR ) )
+               ( fInfo[index].type != NJS_DATATYPE_STR ) &&
+               ( fInfo[index].type != NJS_DATATYPE_BUFFER ) )
           {
             executeBaton->error = NJSMessages::getErrorMsg (
                                                errInvalidTypeForConversion );
@@ -961,11 +1104,12 @@ exitGetOutBindParams:
 }
 
 void Connection::GetInBindParamsUdt(Local<Value> v8val, Bind *bind, eBaton *executeBaton) {
-  bind->ind = (short *)malloc (sizeof(void*));
-  bind->len = (DPI_BUFLEN_TYPE *)malloc (sizeof(DPI_BUFLEN_TYPE));
+  bind->ind = (short *)executeBaton->arena.alloc (sizeof(void*));
+  bind->len = (DPI_BUFLEN_TYPE *)executeBaton->arena.alloc (
+                                                   sizeof(DPI_BUFLEN_TYPE));
   bind->type = dpi::DpiUDT;
   bind->maxSize = *bind->len = sizeof(void*);
-  bind->value = malloc(*bind->len);
+  bind->value = executeBaton->arena.alloc (*bind->len);
 
   try {
     *(void**)bind->value = bind->udt->jsToOci(Local<Object>::Cast(v8val), *(void**)bind->ind);
@@ -1027,8 +1171,9 @@ void Connection::GetInBindParamsScalar(Local<Value> v8val, Bind* bind,
   boolean          v8valNULL ;   /* whether given v8 value is NULL/Undefined */
 
   /* Allocate for scalar indicator & length */
-  bind->ind = (short *)malloc ( sizeof ( short ) );
-  bind->len = (DPI_BUFLEN_TYPE *)malloc ( sizeof ( DPI_BUFLEN_TYPE ) );
+  bind->ind = (short *)executeBaton->arena.alloc ( sizeof ( short ) );
+  bind->len = (DPI_BUFLEN_TYPE *)executeBaton->arena.alloc (
+                                               sizeof ( DPI_BUFLEN_TYPE ) );
 
   *(bind->ind)  = 0;
 
@@ -1105,7 +1250,7 @@ void Connection::GetInBindParamsScalar(Local<Value> v8val, Bind* bind,
                          bind->maxSize : *(bind->len);
       if(size)
       {
-        bind->value = (char*)malloc((size_t)size);
+        bind->value = (char*)executeBaton->arena.alloc ((size_t)size);
         if( !bind->value )
         {
           executeBaton->error = NJSMessages::getErrorMsg(
@@ -1128,7 +1273,7 @@ void Connection::GetInBindParamsScalar(Local<Value> v8val, Bind* bind,
       }
       bind->type = dpi::DpiInteger;
       bind->maxSize = *(bind->len) = sizeof(int);
-      bind->value = (int*)malloc(*(bind->len));
+      bind->value = (int*)executeBaton->arena.alloc (*(bind->len));
       *(int*)(bind->value) = v8valNULL ? 0 : v8val->ToInt32()->Value();
       break;
 
@@ -1141,7 +1286,8 @@ void Connection::GetInBindParamsScalar(Local<Value> v8val, Bind* bind,
       }
       bind->type = dpi::DpiUnsignedInteger;
       bind->maxSize = *(bind->len) = sizeof(unsigned int);
-      bind->value = (unsigned int*)malloc(*(bind->len));
+      bind->value = (unsigned int*)executeBaton->arena.alloc (
+                                                             *(bind->len));
       *(unsigned int*)(bind->value) = v8valNULL ? 0 :
                                         v8val->ToUint32()->Value();
       break;
@@ -1155,7 +1301,7 @@ void Connection::GetInBindParamsScalar(Local<Value> v8val, Bind* bind,
       }
       bind->type = dpi::DpiDouble;
       bind->maxSize = *(bind->len) = sizeof(double);
-      bind->value = (double*)malloc(*(bind->len));
+      bind->value = (double*)executeBaton->arena.alloc (*(bind->len));
       *(double*)(bind->value) = v8valNULL ? 0 : v8val->NumberValue ();
       break;
 
@@ -1169,7 +1315,8 @@ void Connection::GetInBindParamsScalar(Local<Value> v8val, Bind* bind,
 
       /* This has to be allocated after stmt is initialized */
       bind->dttmarr = NULL ;
-      bind->extvalue = (long double *) malloc (sizeof ( long double ) );
+      bind->extvalue = (long double *) executeBaton->arena.alloc (
+                                                   sizeof ( long double ) );
       bind->value = NULL;
       bind->type = dpi::DpiTimestampLTZ;
       *(bind->len) = 0;
@@ -1191,7 +1338,8 @@ void Connection::GetInBindParamsScalar(Local<Value> v8val, Bind* bind,
           bind->type = dpi::DpiRaw;
           *( bind->len ) = ( DPI_BUFLEN_TYPE ) (( bind->isInOut ) ?
                                                   bind->maxSize : 0 );
-          bind->value = ( char *) malloc ( *(bind -> len ) );
+          bind->value = ( char *) executeBaton->arena.alloc (
+                                                         *(bind -> len ) );
         }
         else if (Buffer::HasInstance(obj))
         {
@@ -1210,7 +1358,7 @@ void Connection::GetInBindParamsScalar(Local<Value> v8val, Bind* bind,
                              bind->maxSize : *(bind->len);
           if(size)
           {
-            bind->value = (char *)malloc((size_t) size);
+            bind->value = (char *)executeBaton->arena.alloc ((size_t) size);
             if(bufLen)
               memcpy(bind->value, Buffer::Data(obj), bufLen);
           }
@@ -1362,7 +1510,8 @@ void Connection::GetInBindParamsArray(Local<Array> va8vals, Bind *bind,
       }
       bufferSize       = static_cast<size_t>(arrayElementSize *
                                              bind->maxArraySize);
-      buffer           = reinterpret_cast<char*>(malloc(bufferSize));
+      buffer           = reinterpret_cast<char*>(
+                           executeBaton->arena.alloc (bufferSize));
       bind->value      = buffer;
       break;
 
@@ -1376,7 +1525,8 @@ void Connection::GetInBindParamsArray(Local<Array> va8vals, Bind *bind,
       }
       bufferSize       = static_cast<size_t>(arrayElementSize *
                                              bind->maxArraySize);
-      buffer           = reinterpret_cast<char*>(malloc(bufferSize));
+      buffer           = reinterpret_cast<char*>(
+                           executeBaton->arena.alloc (bufferSize));
       bind->value      = buffer;
       break;
 
@@ -1401,7 +1551,7 @@ void Connection::GetInBindParamsArray(Local<Array> va8vals, Bind *bind,
     executeBaton->error = NJSMessages::getErrorMsg ( errResultsTooLarge );
     goto exitGetInBindParamsArray;
   }
-  bind->ind = reinterpret_cast<short*>(malloc(
+  bind->ind = reinterpret_cast<short*>(executeBaton->arena.alloc (
                                   sizeof(short) * bind->maxArraySize));
 
   if ( NJS_SIZE_T_OVERFLOW ( sizeof ( DPI_BUFLEN_TYPE ), bind->maxArraySize ) )
@@ -1410,7 +1560,8 @@ void Connection::GetInBindParamsArray(Local<Array> va8vals, Bind *bind,
     goto exitGetInBindParamsArray;
   }
   bind->len = reinterpret_cast<DPI_BUFLEN_TYPE*>(
-                malloc( sizeof(DPI_BUFLEN_TYPE) * bind->maxArraySize));
+                executeBaton->arena.alloc (
+                             sizeof(DPI_BUFLEN_TYPE) * bind->maxArraySize));
   if ( NJS_SIZE_T_OVERFLOW ( sizeof ( unsigned int ), bind->maxArraySize ) )
   {
     executeBaton->error = NJSMessages::getErrorMsg ( errResultsTooLarge );
@@ -1525,7 +1676,8 @@ bool Connection::AllocateBindArray(unsigned short dataType, Bind* bind,
     }
     bufferSize        = static_cast<size_t>(*arrayElementSize *
                                             bind->maxArraySize);
-    buffer            = reinterpret_cast<char*>(malloc(bufferSize));
+    buffer            = reinterpret_cast<char*>(
+                          executeBaton->arena.alloc (bufferSize));
     bind->value       = buffer;
     ret = true;
     break;
@@ -1540,7 +1692,8 @@ bool Connection::AllocateBindArray(unsigned short dataType, Bind* bind,
     }
     bufferSize        = static_cast<size_t>(*arrayElementSize *
                                             bind->maxArraySize);
-    buffer            = reinterpret_cast<char*>(malloc(bufferSize));
+    buffer            = reinterpret_cast<char*>(
+                          executeBaton->arena.alloc (bufferSize));
     bind->value       = buffer;
     ret = true;
     break;
@@ -1571,7 +1724,7 @@ bool Connection::AllocateBindArray(unsigned short dataType, Bind* bind,
       executeBaton->error = NJSMessages::getErrorMsg ( errResultsTooLarge );
       goto exitAllocateBindArray;
     }
-    bind->ind = reinterpret_cast<short*>(malloc(
+    bind->ind = reinterpret_cast<short*>(executeBaton->arena.alloc (
                                        sizeof(short) * bind->maxArraySize));
     if ( NJS_SIZE_T_OVERFLOW ( sizeof ( DPI_BUFLEN_TYPE ),
                                bind->maxArraySize ) )
@@ -1580,7 +1733,8 @@ bool Connection::AllocateBindArray(unsigned short dataType, Bind* bind,
       goto exitAllocateBindArray;
     }
     bind->len = reinterpret_cast<DPI_BUFLEN_TYPE*>(
-                 malloc( sizeof(DPI_BUFLEN_TYPE) * bind->maxArraySize ) );
+                 executeBaton->arena.alloc (
+                           sizeof(DPI_BUFLEN_TYPE) * bind->maxArraySize ) );
 
     if (!bind->ind || !bind->len)
     {
@@ -1596,1258 +1750,2733 @@ exitAllocateBindArray:
 /*****************************************************************************/
 /*
    DESCRIPTION
-     Worker function of Execute  method
+     Processing of the bind rows of executeMany.  One Bind is created for
+     each bind variable, holding the values of all rows column-wise, so the
+     statement can be executed for all rows at once.
 
    PARAMETERS:
-     UV queue work block
+     bindRows     - Array of bind rows (Arrays or Objects),
+     bindDefs     - optional type/maxSize per bind variable,
+     executeBaton - eBaton struct
 
    NOTES:
-     DPI call execution
+     The shape of the first row (bind by position or by name) decides the
+     binds, all other rows must follow it.
 */
-void Connection::Async_Execute (uv_work_t *req)
+void Connection::GetBindsMany (Local<Array> bindRows, Local<Value> bindDefs,
+                               eBaton* executeBaton)
 {
-  eBaton *executeBaton = (eBaton*)req->data;
-  if(!(executeBaton->error).empty()) goto exitAsyncExecute;
+  Nan::HandleScope scope;
+  std::vector< Local<Object> > rows;
+  Local<Value>  firstRow;
+  Local<Array>  keys;
+  unsigned int  numBinds = 0;
+  bool          byName   = false;
 
-  try
+  executeBaton->numIterations = bindRows->Length ();
+
+  if ( !executeBaton->numIterations )
   {
-    Connection::PrepareAndBind(executeBaton);
+    executeBaton->error = NJSMessages::getErrorMsg ( errEmptyArray );
+    goto exitGetBindsMany;
+  }
 
-    if ( !executeBaton->error.empty() )  goto exitAsyncExecute;
+  firstRow = bindRows->Get ( 0 );
+  if ( firstRow->IsArray () )
+  {
+    numBinds = Local<Array>::Cast ( firstRow )->Length ();
+  }
+  else if ( firstRow->IsObject () && !firstRow->IsFunction () &&
+            !firstRow->IsDate () && !Buffer::HasInstance ( firstRow ) )
+  {
+    byName   = true;
+    keys     = firstRow->ToObject ()->GetOwnPropertyNames ();
+    numBinds = keys->Length ();
+  }
+  else
+  {
+    executeBaton->error = NJSMessages::getErrorMsg ( errInvalidParameterType,
+                                                     2 );
+    goto exitGetBindsMany;
+  }
 
-    // In DML Returning statements, Buffer type is not allowed temporarily.
-    if ( executeBaton->stmtIsReturning )
+  // OUT binds have no values in the rows, only a bindDefs entry
+  if ( byName && bindDefs->IsObject () && !bindDefs->IsArray () )
+  {
+    Local<Object> defs    = bindDefs->ToObject ();
+    Local<Array>  defKeys = defs->GetOwnPropertyNames ();
+
+    for ( unsigned int index = 0; index < defKeys->Length (); index++ )
     {
-      for ( unsigned int b = 0; b < executeBaton->binds.size () ; b ++ )
-      {
-        if ( executeBaton->binds[b]->isOut &&
-             executeBaton->binds[b]->type == dpi::DpiRaw )
-        {
-          executeBaton->error = NJSMessages::getErrorMsg (
-                                                  errBufferReturningInvalid );
-          goto exitAsyncExecute;
+      Local<String> defKey = defKeys->Get ( index ).As<String> ();
 
-        }
+      if ( IsOutBindDef ( defs->Get ( defKey ) ) &&
+           !Nan::HasOwnProperty ( firstRow->ToObject (),
+                                  defKey ).FromMaybe ( false ) )
+      {
+        keys->Set ( numBinds++, defKey );
       }
     }
+  }
+  else if ( !byName && bindDefs->IsArray () )
+  {
+    Local<Array> defs = Local<Array>::Cast ( bindDefs );
 
-
-    if (executeBaton->st == DpiStmtSelect)
+    for ( unsigned int index = numBinds; index < defs->Length (); index++ )
     {
-      // set prefetch
-      if(executeBaton->getRS)
+      if ( IsOutBindDef ( defs->Get ( index ) ) )
       {
-        // prefetchRows either default or value provided by user
-        executeBaton->dpistmt->prefetchRows(executeBaton->prefetchRows);
-      }
-      else
-      {
-        // OCI default prefetchRows value is 1.
-        // Set default prefetchRows to 2 to cut down on additional
-        // fetch round-trip for single row non-resultset cases
-        executeBaton->dpistmt->prefetchRows(NJS_PREFETCH_NON_RESULTSET);
+        numBinds = index + 1;
       }
+    }
+  }
 
-      executeBaton->dpistmt->execute(0, executeBaton->autoCommit);
+  rows.reserve ( executeBaton->numIterations );
+  for ( unsigned int row = 0; row < executeBaton->numIterations; row++ )
+  {
+    Local<Value> val = bindRows->Get ( row );
 
-      const MetaData* mData = executeBaton->dpistmt->getMetaData(
-                                           executeBaton->extendedMetaData );
-      executeBaton->numCols = executeBaton->dpistmt->numCols();
+    if ( byName ? ( !val->IsObject () || val->IsArray () ) : !val->IsArray () )
+    {
+      executeBaton->error = NJSMessages::getErrorMsg (
+                                                   errInconsistentBindRows );
+      goto exitGetBindsMany;
+    }
+    rows.push_back ( val->ToObject () );
+  }
 
-      executeBaton->mInfo   = new MetaInfo  [ executeBaton->numCols ];
+  for ( unsigned int index = 0; index < numBinds; index++ )
+  {
+    Bind*        bind    = NULL;
+    Local<Value> key;
+    Local<Value> bindDef = Nan::Undefined ();
+    unsigned int dir     = NJS_BIND_IN;
 
-      if ( !executeBaton->mInfo )
-      {
-        executeBaton->error = NJSMessages::getErrorMsg
-                                           ( errInsufficientMemory );
-        goto exitAsyncExecute;
-      }
+    if ( byName )
+    {
+      key = keys->Get ( index );
+    }
+    else
+    {
+      key = Nan::New<v8::Integer> ( index );
+    }
 
-      Connection::CopyMetaData ( executeBaton->mInfo, executeBaton, mData,
-                                 executeBaton->numCols );
-      if ( !executeBaton->error.empty() )
-        goto exitAsyncExecute;
+    if ( bindDefs->IsObject () )
+    {
+      bindDef = bindDefs->ToObject ()->Get ( key );
+    }
 
-      if ( executeBaton->getRS )
-      {
-        goto exitAsyncExecute;
-      }
+    if ( bindDef->IsObject () )
+    {
+      NJS_GET_UINT_FROM_JSON ( dir, executeBaton->error,
+                               bindDef->ToObject (), "dir", 2,
+                               exitGetBindsMany );
+    }
 
-      Connection::DoDefines ( executeBaton );
-      /* If any errors while creating define structures, bail out */
-      if ( !executeBaton->error.empty() )
-        goto exitAsyncExecute;
+    if ( dir != NJS_BIND_IN && dir != NJS_BIND_OUT )
+    {
+      executeBaton->error = NJSMessages::getErrorMsg (
+                                                 errInvalidBindDirection );
+      goto exitGetBindsMany;
+    }
 
-      Connection::DoFetch(executeBaton);
+    bind = new Bind;
+    if ( byName )
+    {
+      std::string str;
+
+      NJSString ( str, key.As<String> () );
+      bind->key = ":" + str;
+    }
+
+    if ( dir == NJS_BIND_OUT )
+    {
+      Connection::GetOutBindParamsMany ( bindDef, bind, executeBaton );
     }
     else
     {
-      if( executeBaton->getRS )
-      {
-        executeBaton->error = NJSMessages::getErrorMsg(
-                                errInvalidNonQueryExecution );
-        goto exitAsyncExecute;
-      }
-      executeBaton->dpistmt->execute(1, executeBaton->autoCommit);
-      executeBaton->rowsAffected = executeBaton->dpistmt->rowsAffected();
+      Connection::GetInBindParamsMany ( rows, key, bindDef, bind,
+                                        executeBaton );
+    }
+    if ( !executeBaton->error.empty () )
+      goto exitGetBindsMany;
+  }
 
-      // Check whether indicators were allocated as part of callback
-      // Address GitHub issue #343
-      if ( executeBaton->stmtIsReturning && executeBaton->rowsAffected )
-      {
-        for ( unsigned int b = 0; b < executeBaton->binds.size (); b++ )
-        {
-          if ( executeBaton->binds[b]->isOut && !executeBaton->binds[b]->ind)
-          {
-            executeBaton->error = NJSMessages::getErrorMsg (
-                                                  errSQLSyntaxError );
-            goto exitAsyncExecute;
-          }
-        }
-      }
+exitGetBindsMany:
+  ;
+}
 
-      /* Check to see if the string buffer size is good in case of
-       * DML Returning.
-       */
-      if ( executeBaton->stmtIsReturning )
-      {
-        for ( unsigned int b = 0; b < executeBaton->binds.size (); b ++ )
-        {
-          /* Interested only OUT binds with VARCHAR columns */
-          if ( executeBaton->binds[b]->isOut &&
-               ( executeBaton->binds[b]->type == dpi::DpiVarChar ))
-          {
-            bool err = false;
-            for ( DPI_USZ_TYPE row = 0 ;
-                  !err && ( row < executeBaton->rowsAffected) ;
-                  row ++ )
-            {
-              if (executeBaton->binds[b]->maxSize <
-                  (DPI_SZ_TYPE) executeBaton->binds[b]->len2[row])
-              {
-                /* Report insufficient buffer for OUT binds */
-                executeBaton->error =
-                  NJSMessages::getErrorMsg (errInsufficientBufferForBinds);
-                err = true;
-              }
-            }
-          }
-        }
-        /* Fall through the code to cleanup other objects */
-      }
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Processing of one bind variable of executeMany.  Values of the given
+     bind variable are gathered from all rows into one buffer, with one
+     indicator and length per row.
 
+   PARAMETERS:
+     rows         - bind rows,
+     key          - bind name or position within each row,
+     bindDef      - optional JSON with type and maxSize,
+     bind         - bind struct to fill,
+     executeBaton - eBaton struct
 
-     /* Process date/timestamp INOUT/OUT bind values */
-     for ( unsigned int b = 0; b < executeBaton->binds.size (); b++ )
-     {
-       Bind *bind = executeBaton->binds[b];
+   NOTE:
+     Datatype is taken from bindDef when given, otherwise from the first
+     non NULL value.  A bind variable with only NULL values is bound as
+     STRING.
+*/
+void Connection::GetInBindParamsMany (
+                              const std::vector< Local<Object> > &rows,
+                              Local<Value> key, Local<Value> bindDef,
+                              Bind *bind, eBaton *executeBaton )
+{
+  Nan::HandleScope scope;
+  unsigned int     numRows          = executeBaton->numIterations;
+  unsigned int     dataType         = NJS_DATATYPE_DEFAULT;
+  size_t           arrayElementSize = 0;
+  size_t           bufferSize       = 0;
+  char*            buffer           = NULL;
 
-       /* Interested only OUT binds of date/timestamp type */
-       if ( bind->isOut && bind->dttmarr)
-       {
-          for (unsigned int rowidx = 0; rowidx < bind->rowsReturned; rowidx++)
-            ((long double *)(bind->extvalue))[rowidx] =
-                              bind->dttmarr->getDateTime ( rowidx ) ;
-       }
+  // Bind is owned by eBaton from here on, to be freed along with it
+  executeBaton->binds.push_back ( bind );
 
-       /* DATE/Timestamp could have been allocated for IN/OUT/INOUT binds */
-       if ( bind->dttmarr )
-       {
-         bind->dttmarr->release () ;
-         bind->dttmarr = NULL;
-         bind->value = NULL;
-       }
-     }
+  //
+  //  Step 1 - Determine the datatype and the buffer size per row
+  //
 
-     // allocate exteBinds vector with bind-array-size and initialize to NULL
-     executeBaton->extBinds.resize (
-                   ( unsigned int ) ( executeBaton->binds.size () ), NULL );
+  if ( bindDef->IsObject () )
+  {
+    Local<Object> bindUnit = bindDef->ToObject ();
 
-     /*
-      * For each OUT Binds of valid CURSOR type, set prefetch and get
-      * meta data
-      */
+    NJS_GET_UINT_FROM_JSON ( dataType, executeBaton->error,
+                             bindUnit, "type", 2, exitGetInBindParamsMany );
+    NJS_GET_UINT_FROM_JSON ( bind->maxSize, executeBaton->error,
+                             bindUnit, "maxSize", 2,
+                             exitGetInBindParamsMany );
+  }
 
-     for ( unsigned int b = 0; b < executeBaton->binds.size (); b ++ )
-     {
-       Bind *bind = executeBaton->binds[b];
+  for ( unsigned int row = 0; row < numRows; row++ )
+  {
+    Local<Value> value = rows[row]->Get ( key );
+    unsigned int valueType = NJS_DATATYPE_DEFAULT;
+    size_t       valueSize = 0;
 
-       /* Here bind->isOut is expected to be TRUE, and is checked earlier */
-       if ( bind->type == dpi::DpiRSet )
-       {
-         unsigned int state = ((Stmt*)bind->value)->getState ();
+    switch ( GetValueType ( value ) )
+    {
+      case NJS_VALUETYPE_NULL:
+        continue;
 
-         if ( state == DPI_STMT_STATE_EXECUTED )
-         {
-           // set the prefetch on the valid cursor object
-           ((dpi::Stmt *)(bind->value))->prefetchRows (
-                                              executeBaton->prefetchRows ) ;
-           // Get metaData and number of columns on valid cursor object
-           ExtBind* extBind = new ExtBind ();
-           if ( !extBind )
-           {
-             executeBaton->error = NJSMessages::getErrorMsg
-                                           ( errInsufficientMemory );
-             goto exitAsyncExecute;
-           }
-           const MetaData* mData = ((Stmt*)bind->value)->getMetaData(
-                                           executeBaton->extendedMetaData );
-           extBind->numCols      = ((Stmt*)bind->value)->numCols ();
+      case NJS_VALUETYPE_STRING:
+        valueType = NJS_DATATYPE_STR;
+        valueSize = value->ToString ()->Utf8Length ();
+        break;
 
-           extBind->mInfo        = new MetaInfo  [ extBind->numCols ];
-           if ( !extBind->mInfo )
-           {
-             executeBaton->error = NJSMessages::getErrorMsg
-                                                ( errInsufficientMemory );
-             goto exitAsyncExecute;
-           }
-           Connection::CopyMetaData ( extBind->mInfo, executeBaton, mData,
-                                      extBind->numCols );
-           if ( !executeBaton->error.empty() )
-             goto exitAsyncExecute;
+      case NJS_VALUETYPE_INTEGER:
+      case NJS_VALUETYPE_UINTEGER:
+      case NJS_VALUETYPE_NUMBER:
+        valueType = NJS_DATATYPE_NUM;
+        break;
 
-           executeBaton->extBinds [ b ] = extBind;
-         }
-         else
-         {
-           /* Release the invalid REFCURSOR to avoid any leaks */
-           ((Stmt*)bind->value)->release ();
-           bind->value = NULL;
-         }
-       }
-     }
+      case NJS_VALUETYPE_DATE:
+        valueType = NJS_DATATYPE_DATE;
+        break;
 
-     // process any lob descriptor out binds
-     Connection::Descr2protoILob ( executeBaton, 0, 0);
+      case NJS_VALUETYPE_OBJECT:
+        if ( Buffer::HasInstance ( value ) )
+        {
+          valueType = NJS_DATATYPE_BUFFER;
+          valueSize = Buffer::Length ( value->ToObject () );
+          break;
+        }
+        // fall through - other objects can not be bound
+
+      default:
+        executeBaton->error = NJSMessages::getErrorMsg (
+                                              errInvalidTypeForArrayBind );
+        goto exitGetInBindParamsMany;
     }
-    //dpistmt will be released in exitAsyncExecute label in case of non-RS
-  }
-  catch (dpi::Exception& e)
-  {
-    NJS_SET_CONN_ERR_STATUS (  e.errnum(), executeBaton->dpiconn );
-    // In Case of DML Returning, if the buffer is small, and if the callback
-    // is called multiple times, an ORA error 24343 was reported. Converting
-    // that error to errInsufficientBufferForBinds.
-    if ( !executeBaton->stmtIsReturning ||
-         (e.errnum() != 24343) )
+
+    if ( dataType == NJS_DATATYPE_DEFAULT )
     {
-      executeBaton->error = std::string(e.what ());
+      dataType = valueType;
     }
-    else
+    else if ( dataType != valueType )
     {
       executeBaton->error = NJSMessages::getErrorMsg (
-                                     errInsufficientBufferForBinds ) ;
+                                            errIncompatibleTypeArrayBind );
+      goto exitGetInBindParamsMany;
+    }
+
+    if ( valueSize > arrayElementSize )
+    {
+      arrayElementSize = valueSize;
     }
   }
-  exitAsyncExecute:
-    /* Release the statement handle in case of errors or non-ResultSet
-     * In case of ResultSet and no errors, statement handle will be released
-     * while closing it.
-     */
-    if ( ( ( !(executeBaton->error).empty() ) ||
-           ( !executeBaton->getRS ) ) &&
-         executeBaton->dpistmt )
+
+  //
+  //  Step 2 - Allocate the buffers for the values, indicators and lengths
+  //
+
+  switch ( dataType )
+  {
+    case NJS_DATATYPE_DEFAULT:            // NULL values only
+    case NJS_DATATYPE_STR:
+    case NJS_DATATYPE_BUFFER:
+      bind->type = ( dataType == NJS_DATATYPE_BUFFER ) ? dpi::DpiRaw :
+                                                          dpi::DpiVarChar;
+      if ( arrayElementSize < static_cast<size_t>(bind->maxSize) )
+      {
+        arrayElementSize = static_cast<size_t>(bind->maxSize);
+      }
+      if ( !arrayElementSize )
+      {
+        arrayElementSize = 1;
+      }
+      break;
+
+    case NJS_DATATYPE_NUM:
+      bind->type       = dpi::DpiDouble;
+      arrayElementSize = sizeof ( double );
+      break;
+
+    case NJS_DATATYPE_DATE:
+      // Values are kept in extvalue till the DateTimeArray is available
+      bind->type       = dpi::DpiTimestampLTZ;
+      arrayElementSize = sizeof ( long double );
+      break;
+
+    default:
+      executeBaton->error = NJSMessages::getErrorMsg (
+                                              errInvalidTypeForArrayBind );
+      goto exitGetInBindParamsMany;
+  }
+
+  if ( NJS_SIZE_T_OVERFLOW ( arrayElementSize, numRows ) ||
+       NJS_SIZE_T_OVERFLOW ( sizeof ( DPI_BUFLEN_TYPE ), numRows ) )
+  {
+    executeBaton->error = NJSMessages::getErrorMsg ( errResultsTooLarge );
+    goto exitGetInBindParamsMany;
+  }
+
+  bufferSize = arrayElementSize * numRows;
+  buffer     = reinterpret_cast<char*>(
+                   executeBaton->arena.alloc ( bufferSize ) );
+  bind->ind  = reinterpret_cast<short*>(
+                   executeBaton->arena.alloc ( sizeof ( short ) * numRows ) );
+  bind->len  = reinterpret_cast<DPI_BUFLEN_TYPE*>(
+                   executeBaton->arena.alloc ( sizeof ( DPI_BUFLEN_TYPE ) *
+                                               numRows ) );
+
+  if ( bind->type == dpi::DpiTimestampLTZ )
+  {
+    bind->extvalue = buffer;
+    bind->maxSize  = sizeof ( void * );       // array of descriptors
+  }
+  else
+  {
+    bind->value    = buffer;
+    bind->maxSize  = static_cast<DPI_SZ_TYPE>( arrayElementSize );
+  }
+
+  if ( !buffer || !bind->ind || !bind->len )
+  {
+    executeBaton->error = NJSMessages::getErrorMsg ( errInsufficientMemory );
+    goto exitGetInBindParamsMany;
+  }
+  memset ( buffer, 0, bufferSize );
+
+  //
+  //  Step 3 - Copy the values from all the rows
+  //
+
+  for ( unsigned int row = 0; row < numRows;
+        row++, buffer += arrayElementSize )
+  {
+    Local<Value> value = rows[row]->Get ( key );
+
+    if ( GetValueType ( value ) == NJS_VALUETYPE_NULL )
     {
-        executeBaton->dpistmt->release ();
+      bind->ind[row] = -1;
+      bind->len[row] = 0;
+      continue;
     }
 
-    // In case of error, release the statement handles allocated (REF CURSOR)
-    if ( !(executeBaton->error).empty() )
+    bind->ind[row] = 0;
+    switch ( bind->type )
     {
-      for( unsigned int index = 0 ;index < executeBaton->binds.size();
-           index++ )
-      {
-        if( executeBaton->binds[index]->value &&
-            ( executeBaton->binds[index]->type == DpiRSet ) )
+      case dpi::DpiVarChar:
         {
-          ((Stmt*)executeBaton->binds[index]->value)->release ();
-          executeBaton->binds[index]->value = NULL;
+          v8::String::Utf8Value str ( value->ToString () );
+          size_t stringLength = str.length ();
+
+          if ( stringLength > 0 )
+          {
+            memcpy ( buffer, *str, stringLength );
+          }
+          bind->len[row] = static_cast<DPI_BUFLEN_TYPE>( stringLength );
         }
-      }
+        break;
+
+      case dpi::DpiRaw:
+        {
+          Local<Object> obj  = value->ToObject ();
+          size_t        size = Buffer::Length ( obj );
+
+          if ( size > 0 )
+          {
+            memcpy ( buffer, Buffer::Data ( obj ), size );
+          }
+          bind->len[row] = static_cast<DPI_BUFLEN_TYPE>( size );
+        }
+        break;
+
+      case dpi::DpiDouble:
+        *( reinterpret_cast<double*>( buffer ) ) = value->NumberValue ();
+        bind->len[row] = sizeof ( double );
+        break;
+
+      case dpi::DpiTimestampLTZ:
+        *( reinterpret_cast<long double*>( buffer ) ) =
+                                      value.As<Date>()->NumberValue ();
+        bind->len[row] = 0;
+        break;
     }
+  }
+
+exitGetInBindParamsMany:
   ;
 }
 
 /*****************************************************************************/
 /*
    DESCRIPTION
-     Calls DPI Stmt Prepare and Bind
+     Processing of one OUT bind variable of executeMany, filled by the
+     RETURNING INTO clause.  The buffers are allocated once for all the
+     iterations, with room for maxArraySize rows per iteration.
 
    PARAMETERS:
-     eBaton struct
- */
-void Connection::PrepareAndBind (eBaton* executeBaton)
+     bindDef      - JSON with dir, type, maxSize and maxArraySize,
+     bind         - bind struct to fill,
+     executeBaton - eBaton struct
+
+   NOTE:
+     Only STRING, NUMBER and DATE are supported.
+*/
+void Connection::GetOutBindParamsMany ( Local<Value> bindDef, Bind *bind,
+                                        eBaton *executeBaton )
 {
-  executeBaton->dpistmt = executeBaton->dpiconn->getStmt(executeBaton->sql);
-  executeBaton->st = executeBaton->dpistmt->stmtType ();
-  executeBaton->stmtIsReturning = executeBaton->dpistmt->isReturning ();
+  Nan::HandleScope scope;
+  Local<Object>    bindUnit     = bindDef->ToObject ();
+  unsigned int     dataType     = NJS_DATATYPE_STR;
+  unsigned int     maxArraySize = 1;
+  size_t           numSlots     = 0;
+  size_t           elementSize  = 0;
+
+  // Bind is owned by eBaton from here on, to be freed along with it
+  executeBaton->binds.push_back ( bind );
+  bind->isOut   = true;
+  bind->maxSize = NJS_MAX_OUT_BIND_SIZE;
+  executeBaton->numOutBinds++;
+
+  NJS_GET_UINT_FROM_JSON ( dataType, executeBaton->error,
+                           bindUnit, "type", 2, exitGetOutBindParamsMany );
+  NJS_GET_UINT_FROM_JSON ( bind->maxSize, executeBaton->error,
+                           bindUnit, "maxSize", 2,
+                           exitGetOutBindParamsMany );
+  NJS_GET_UINT_FROM_JSON ( maxArraySize, executeBaton->error,
+                           bindUnit, "maxArraySize", 2,
+                           exitGetOutBindParamsMany );
+
+  if ( !maxArraySize )
+  {
+    executeBaton->error = NJSMessages::getErrorMsg (
+                                              errInvalidValueArrayBind );
+    goto exitGetOutBindParamsMany;
+  }
+  bind->maxArraySize = maxArraySize;
 
-  if(!executeBaton->binds.empty())
+  switch ( dataType )
   {
-    if(!executeBaton->binds[0]->key.empty())
-    {
-      for(unsigned int index = 0 ;index < executeBaton->binds.size();
-          index++)
+    case NJS_DATATYPE_STR:
+      bind->type  = dpi::DpiVarChar;
+      elementSize = static_cast<size_t>( bind->maxSize );
+      if ( !elementSize )
       {
-        if ( executeBaton->binds[index]->isOut &&
-             executeBaton->stmtIsReturning &&
-             executeBaton->binds[index]->type == dpi::DpiRSet )
-        {
-          executeBaton->error = NJSMessages::getErrorMsg (
-                                                     errInvalidResultSet ) ;
-        }
+        executeBaton->error = NJSMessages::getErrorMsg (
+                               errInvalidPropertyValueInParam, "maxSize", 3 );
+        goto exitGetOutBindParamsMany;
+      }
+      break;
 
-        // Allocate for OUT Binds
-        // For DML Returning, allocation happens through callback.
-        if ( executeBaton->binds[index]->isOut &&
-             !executeBaton->stmtIsReturning &&
-             !executeBaton->binds[index]->value )
-        {
-          Connection::cbDynBufferAllocate ( executeBaton,
-                                            false, 1, index );
-          // LOBs: binds[index]->value is a pointer to a pointer
-          // we need to allocate the underlying LOB descriptor
-          if (executeBaton->binds[index]->type == DpiClob ||
-              executeBaton->binds[index]->type == DpiBlob)
-          {
-            *((void **)executeBaton->binds[index]->value) =
-              executeBaton->dpienv->allocDescriptor(LobDescriptorType);
-          }
-        }
+    case NJS_DATATYPE_NUM:
+      bind->type    = dpi::DpiDouble;
+      bind->maxSize = sizeof ( double );
+      elementSize   = sizeof ( double );
+      break;
 
-        // Convert v8::Date to Oracle DB Type for IN and IN/OUT binds
-        if ( executeBaton->binds[index]->type == DpiTimestampLTZ &&
-            // InOut bind
-            (executeBaton->binds[index]->isInOut ||
-            // In bind
-            (!executeBaton->binds[index]->isOut &&
-             !executeBaton->binds[index]->isInOut)))
-        {
-          Connection::UpdateDateValue ( executeBaton, index ) ;
-        }
+    case NJS_DATATYPE_DATE:
+      // Values are converted to extvalue after execution
+      bind->type    = dpi::DpiTimestampLTZ;
+      bind->maxSize = sizeof ( void * );
+      elementSize   = sizeof ( long double );
+      break;
 
-        // Bind by name
-        executeBaton->dpistmt->bind(
-              (const unsigned char*)executeBaton->binds[index]->key.c_str(),
-              (int) executeBaton->binds[index]->key.length(), index,
-              executeBaton->binds[index]->type,
-              executeBaton->binds[index]->value,
-              (executeBaton->stmtIsReturning &&
-                executeBaton->binds[index]->isOut &&
-               (executeBaton->binds[index]->type == dpi::DpiVarChar )) ?
-                (executeBaton->binds[index]->maxSize + 1) :
-                executeBaton->binds[index]->maxSize,
-              executeBaton->binds[index]->ind,
-                executeBaton->binds[index]->len,
-              (executeBaton->binds[index]->isArray) ?
-                executeBaton->binds[index]->maxArraySize : 0,
-              (executeBaton->binds[index]->isArray) ?
-                &(executeBaton->binds[index]->curArraySize) : 0,
-              (executeBaton->stmtIsReturning &&
-                executeBaton->binds[index]->isOut) ?
-              (void *)executeBaton : NULL,
-              executeBaton->binds[index]->udt.get(),
-              (executeBaton->stmtIsReturning &&
-                executeBaton->binds[index]->isOut) ?
-              Connection::cbDynBufferGet : NULL);
-      }
-    }
-    else
-    {
-      for(unsigned int index = 0 ;index < executeBaton->binds.size();
-          index++)
-      {
-        // Allocate for OUT Binds
-        // For DML Returning, allocation happens through callback
-        if ( executeBaton->binds[index]->isOut &&
-             !executeBaton->stmtIsReturning &&
-             !executeBaton->binds[index]->value )
-        {
-          Connection::cbDynBufferAllocate ( executeBaton,
-                                            false, 1, index );
-        }
-
-        // Convert v8::Date to Oracle DB Type for IN and IN/OUT binds
-        if ( executeBaton->binds[index]->type == DpiTimestampLTZ &&
-            // InOut bind
-            (executeBaton->binds[index]->isInOut ||
-            // In bind
-            (!executeBaton->binds[index]->isOut &&
-             !executeBaton->binds[index]->isInOut)))
-        {
-          Connection::UpdateDateValue ( executeBaton, index ) ;
-        }
+    case NJS_DATATYPE_BUFFER:
+      executeBaton->error = NJSMessages::getErrorMsg (
+                                               errBufferReturningInvalid );
+      goto exitGetOutBindParamsMany;
 
-        // Bind by position
-        executeBaton->dpistmt->bind(
-              index+1,executeBaton->binds[index]->type,
-              executeBaton->binds[index]->value,
-              (executeBaton->stmtIsReturning &&
-                executeBaton->binds[index]->isOut &&
-               (executeBaton->binds[index]->type == dpi::DpiVarChar )) ?
-                (executeBaton->binds[index]->maxSize + 1) :
-                 executeBaton->binds[index]->maxSize,
-              executeBaton->binds[index]->ind,
-              executeBaton->binds[index]->len,
-              (executeBaton->binds[index]->isArray) ?
-                executeBaton->binds[index]->maxArraySize : 0,
-              (executeBaton->binds[index]->isArray) ?
-                &(executeBaton->binds[index]->curArraySize ) : 0,
-              (executeBaton->stmtIsReturning &&
-                executeBaton->binds[index]->isOut ) ?
-                  (void *)executeBaton : NULL,
-              executeBaton->binds[index]->udt.get(),
-              (executeBaton->stmtIsReturning &&
-                executeBaton->binds[index]->isOut) ?
-              Connection::cbDynBufferGet : NULL);
-      }
-    }
+    default:
+      executeBaton->error = NJSMessages::getErrorMsg (
+                                               errInvalidTypeForArrayBind );
+      goto exitGetOutBindParamsMany;
   }
-}
-
-/*****************************************************************************/
-/*
-   DESCRIPTION
-     Copies metaData into MetaInfo and gets target fetchTypes
 
-   PARAMETERS:
-     mInfo         - an array of structs representing column info
-     executeBaton  - eBaton structure
-     mData         - meta data of columns
-     numCols       - number of columns
- */
-void Connection::CopyMetaData ( MetaInfo           *mInfo,
-                                eBaton             *executeBaton,
-                                const MetaData*    mData,
-                                const unsigned int numCols )
-{
-  bool error = false;
-
-  for ( unsigned int col = 0; !error && ( col < numCols ); col++ )
+  if ( NJS_SIZE_T_OVERFLOW ( maxArraySize, executeBaton->numIterations ) ||
+       (size_t) maxArraySize * executeBaton->numIterations >
+         (size_t) std::numeric_limits<int>::max () )
   {
-    mInfo[col].name         = string( (const char*)mData[col].colName,
-                                      mData[col].colNameLen );
-    mInfo[col].dbType       = mData[col].dbType;
-    mInfo[col].byteSize     = mData[col].dbSize;
-
-    if ( executeBaton->extendedMetaData )
-    {
-      mInfo[col].precision  = mData[col].precision;
-      mInfo[col].scale      = mData[col].scale;
-      mInfo[col].isNullable = mData[col].isNullable;
-    }
-
-    switch( mData[col].dbType )
-    {
-      case dpi::DpiNumber:
-      case dpi::DpiBinaryFloat:
-      case dpi::DpiBinaryDouble:
-        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
-                                                 mInfo[col].name,
-                                                 dpi::DpiDouble );
-        mInfo[col].njsFetchType =
-                     ( mInfo[col].dpiFetchType == dpi::DpiVarChar ) ?
-                                  NJS_DATATYPE_STR : NJS_DATATYPE_NUM;
-        break;
-
-      case dpi::DpiVarChar:
-      case dpi::DpiFixedChar:
-        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
-                                                 mInfo[col].name,
-                                                 dpi::DpiVarChar );
-        mInfo[col].njsFetchType = NJS_DATATYPE_STR;
-        break;
-
-      case dpi::DpiDate:
-      case dpi::DpiTimestamp:
-      case dpi::DpiTimestampLTZ:
-        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
-                                                 mInfo[col].name,
-                                                 dpi::DpiTimestampLTZ );
-        mInfo[col].njsFetchType =
-                     ( mInfo[col].dpiFetchType == dpi::DpiVarChar ) ?
-                                  NJS_DATATYPE_STR : NJS_DATATYPE_DATE;
-        break;
-
-      case dpi::DpiTimestampTZ:
-        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
-                                                 mInfo[col].name,
-                                                 dpi::DpiTimestampLTZ );
-        mInfo[col].njsFetchType =
-                     ( mInfo[col].dpiFetchType == dpi::DpiVarChar ) ?
-                                  NJS_DATATYPE_STR : NJS_DATATYPE_UNKNOWN;
-        break;
-
-      case dpi::DpiRaw:
-        mInfo[col].dpiFetchType = DpiRaw;
-        mInfo[col].njsFetchType = NJS_DATATYPE_BUFFER;
-        break;
-
-      case dpi::DpiClob:
-        mInfo[col].dpiFetchType = mData[col].dbType;
-        mInfo[col].njsFetchType = NJS_DATATYPE_CLOB;
-        break;
-
-      case dpi::DpiBlob:
-        mInfo[col].dpiFetchType = mData[col].dbType;
-        mInfo[col].njsFetchType = NJS_DATATYPE_BLOB;
-        break;
-
-      case dpi::DpiRowid:
-        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
-                                                 mInfo[col].name,
-                                                 dpi::DpiRowid );
-        mInfo[col].njsFetchType =
-                     ( mInfo[col].dpiFetchType == dpi::DpiVarChar ) ?
-                                  NJS_DATATYPE_STR : NJS_DATATYPE_UNKNOWN;
-        break;
+    executeBaton->error = NJSMessages::getErrorMsg ( errResultsTooLarge );
+    goto exitGetOutBindParamsMany;
+  }
+  numSlots = (size_t) maxArraySize * executeBaton->numIterations;
 
-      case dpi::DpiUDT:
-        mInfo[col].dpiFetchType = mData[col].dbType;
-        mInfo[col].njsFetchType = NJS_DATATYPE_DEFAULT;
-        break;
+  if ( NJS_SIZE_T_OVERFLOW ( elementSize, numSlots ) )
+  {
+    executeBaton->error = NJSMessages::getErrorMsg ( errResultsTooLarge );
+    goto exitGetOutBindParamsMany;
+  }
 
-      default:
-        mInfo[col].njsFetchType = NJS_DATATYPE_UNKNOWN;
-        mInfo[col].dbType       = NJS_DATATYPE_UNKNOWN;
-        break;
-    }
+  bind->ind      = reinterpret_cast<short*>(
+                     executeBaton->arena.alloc ( sizeof ( short ) *
+                                                 numSlots ) );
+  bind->len2     = reinterpret_cast<unsigned int*>(
+                     executeBaton->arena.calloc ( numSlots,
+                                                  sizeof ( unsigned int ) ) );
+  bind->iterRows = reinterpret_cast<unsigned int*>(
+                     executeBaton->arena.calloc ( executeBaton->numIterations,
+                                                  sizeof ( unsigned int ) ) );
+  if ( bind->type == dpi::DpiTimestampLTZ )
+  {
+    bind->extvalue = executeBaton->arena.alloc ( elementSize * numSlots );
+  }
+  else
+  {
+    bind->value    = executeBaton->arena.alloc ( elementSize * numSlots );
+  }
 
-    if ( mInfo[col].njsFetchType == NJS_DATATYPE_UNKNOWN )
-    {
-      error = true;
-    }
+  if ( !bind->ind || !bind->len2 || !bind->iterRows ||
+       !( bind->value || bind->extvalue ) )
+  {
+    executeBaton->error = NJSMessages::getErrorMsg ( errInsufficientMemory );
+    goto exitGetOutBindParamsMany;
   }
 
-  if ( error )
+  for ( size_t slot = 0; slot < numSlots; slot++ )
   {
-    executeBaton->error = NJSMessages::getErrorMsg ( errUnsupportedDatType );
+    bind->ind[slot] = -1;
   }
+
+exitGetOutBindParamsMany:
+  ;
 }
 
 /*****************************************************************************/
 /*
-  DESCRIPTION
-    To convert various Oracle Database type to the one used by the driver
-
-  PARAMETERS
-    dbType - Dpi enumeration of database type
+   DESCRIPTION
+     Checks whether a bindDefs entry of executeMany is for an OUT bind.
 
-  RETURNS
-  targetDB type (DPI enumeration)
+   PARAMETERS:
+     bindDef - bindDefs entry, may be undefined
 */
-unsigned short Connection::SourceDBType2TargetDBType ( unsigned dbType )
+bool Connection::IsOutBindDef ( Local<Value> bindDef )
 {
-  switch ( dbType )
+  if ( bindDef->IsObject () )
   {
-    /* Double is used for all numeric types */
-  case dpi::DpiNumber:
-  case dpi::DpiBinaryFloat:
-  case dpi::DpiBinaryDouble:
-  case dpi::DpiDouble:
-    dbType = dpi::DpiDouble;
-    break;
-
-    /* VARCHAR is used for all character types */
-  case dpi::DpiVarChar:
-  case dpi::DpiFixedChar:
-    dbType = dpi::DpiVarChar;
-    break;
+    Local<Value> dir = bindDef->ToObject ()->Get (
+                           Nan::New<v8::String> ( "dir" ).ToLocalChecked () );
 
-    /* TIMESTAMP WITH LOCAL TIME ZONE (LTZ) is used for all DATE/TIMESTAMP */
-  case dpi::DpiDate:
-  case dpi::DpiTimestamp:
-  case dpi::DpiTimestampLTZ:
-    dbType = dpi::DpiTimestampLTZ;
-    break;
+    return dir->IsUint32 () && dir->Uint32Value () == NJS_BIND_OUT;
   }
-
-  return dbType;
+  return false;
 }
 
-
 /*****************************************************************************/
 /*
-  DESCRIPTION
-    Apply By-name rules if applicable
+   DESCRIPTION
+     Worker function of Execute  method
 
-  PARAMETERS
-    executeBaton          SQL Execute Baton structure
-    name                  name of the column
-    targetType[IN/OUT]  - db type [IN}, and fetchType [OUT] if a rules was
-                          applied
+   PARAMETERS:
+     UV queue work block
 
-  RETURNS
-    true if rules applied and
-    false if no matching column name available.
+   NOTES:
+     DPI call execution
 */
-boolean Connection::MapByName ( eBaton *executeBaton, std::string &name,
-                                unsigned short &targetType )
+void Connection::Async_Execute (uv_work_t *req)
 {
-  boolean modified = false;
+  eBaton *executeBaton = (eBaton*)req->data;
+  if(!(executeBaton->error).empty()) goto exitAsyncExecute;
 
-  if ( executeBaton->fetchInfo && executeBaton->fetchInfoCount > 0 )
+  try
   {
-    for ( unsigned int f = 0 ;
-          !modified && ( f < executeBaton->fetchInfoCount ) ;
-          f ++ )
+    Connection::PrepareAndBind(executeBaton);
+
+    if ( !executeBaton->error.empty() )  goto exitAsyncExecute;
+
+    // In DML Returning statements, Buffer type is not allowed temporarily.
+    if ( executeBaton->stmtIsReturning )
     {
-      /* COLUMN name should match */
-      if ( executeBaton->fetchInfo[f].name.compare ( name ) == 0 )
+      for ( unsigned int b = 0; b < executeBaton->binds.size () ; b ++ )
       {
-        /* Only NJS_DATATYPE_STR & NJS_DATATYPE_DEFAULT allowed.  For NJS_DATATYPE_DEFAULT,
-         * the type is identified from metadata and is already set.
-         * In case of NJS_DATATYPE_STR, set the return value.
-         */
-        if ( executeBaton->fetchInfo[f].type == NJS_DATATYPE_STR )
+        if ( executeBaton->binds[b]->isOut &&
+             executeBaton->binds[b]->type == dpi::DpiRaw )
         {
-          targetType = dpi::DpiVarChar;
-        }
-        else if ( executeBaton->fetchInfo[f].type == NJS_DATATYPE_DEFAULT )
-        {
-          targetType = Connection::SourceDBType2TargetDBType ( targetType );
+          executeBaton->error = NJSMessages::getErrorMsg (
+                                                  errBufferReturningInvalid );
+          goto exitAsyncExecute;
+
         }
-        modified = true;
       }
     }
-  }
-
-  return modified;
-}
-
-
-
-/*****************************************************************************/
-/*
-  DESCRIPTION
-    Apply by-type conversion rules - rules are set as oracledb property
-
-  PARAMETERS
-    executeBaton  - eBaton structure for this execute call
-    dbType        - database column type from metadata(IN), targetDBtype(OUT)
-
-  RETURNS
-    true if the database type is modified based on by-type rules
-    false if not modified
-*/
-boolean Connection::MapByType ( eBaton *executeBaton, unsigned short &dbType )
-{
-  boolean modified = false;
-  unsigned int count = 0 ;
 
-  /* If oracledb property is set map using that */
-  if ( executeBaton->fetchAsStringTypes )
-  {
-    count = executeBaton->fetchAsStringTypesCount;
 
-    switch ( dbType )
+    if (executeBaton->st == DpiStmtSelect)
     {
-    case dpi::DpiNumber:
-    case dpi::DpiBinaryFloat:
-    case dpi::DpiBinaryDouble:
-    case dpi::DpiDouble:
-      /* Numeric Type */
-      for ( unsigned int t = 0 ; !modified && ( t < count ) ; t++)
+      // set prefetch
+      if(executeBaton->getRS)
       {
-        if ( executeBaton->fetchAsStringTypes[t] == NJS_DATATYPE_NUM )
-        {
-          /*
-           * Convert all Numeric values to STRING
-           */
-          dbType = dpi::DpiVarChar;
-          modified = true;
-          break;
-        }
+        // prefetchRows either default or value provided by user
+        executeBaton->dpistmt->prefetchRows(executeBaton->prefetchRows);
       }
-      break;
-
-    case dpi::DpiDate:
-    case dpi::DpiTimestamp:
-    case dpi::DpiTimestampTZ:
-    case dpi::DpiTimestampLTZ:
-      /* DATE/TIMESTAMP */
-      for ( unsigned int t = 0 ; !modified && ( t < count ) ; t ++ )
+      else
       {
-        if ( executeBaton->fetchAsStringTypes[t] == NJS_DATATYPE_DATE )
-        {
-          /* Convert all DATE/TIMESTAMP values to STRING */
-          dbType = dpi::DpiVarChar;
-          modified = true;
-          break;
-        }
+        // OCI default prefetchRows value is 1.
+        // Set default prefetchRows to 2 to cut down on additional
+        // fetch round-trip for single row non-resultset cases
+        executeBaton->dpistmt->prefetchRows(NJS_PREFETCH_NON_RESULTSET);
       }
-      break;
 
-    default:  /* Other data types no supported and is checked earlier */
-      break;
-    }
-  }
+      executeBaton->dpistmt->execute(0, executeBaton->autoCommit);
 
-  return dbType;
-}
+      const MetaData* mData = executeBaton->dpistmt->getMetaData(
+                                           executeBaton->extendedMetaData );
+      executeBaton->numCols = executeBaton->dpistmt->numCols();
 
-/*****************************************************************************/
-/*
-   DESCRIPTION
-     To map to desired database type if any specified by Column Name or
-     oracledb type
+      // Reuse the layout of an earlier execute if the columns are the same
+      if ( executeBaton->cacheEntry && executeBaton->cacheEntry->defines )
+      {
+        QueryCacheEntry *entry = executeBaton->cacheEntry;
 
-   PARAMETERS
-     eBaton  - executeBaton structure
-     name    - column name
-     default Type - if no override provided, to return the default DB type
+        if ( entry->numCols == executeBaton->numCols &&
+             Connection::SameMetaData ( entry->mInfo, mData,
+                                        executeBaton->numCols,
+                                        executeBaton->extendedMetaData ) )
+        {
+          executeBaton->mInfo   = entry->mInfo;
+          executeBaton->defines = entry->defines;
 
-   RETURNS
-     dbType   - As default is provided, always a DB Column type will
-                be returned.
-*/
-unsigned short Connection::GetTargetType ( eBaton *executeBaton,
-                                            std::string &name,
-                                unsigned short defaultType)
-{
-  unsigned short dbType = defaultType;  // Start with DB Metadata type
+          Connection::Redefine ( executeBaton );
+          if ( !executeBaton->error.empty() )
+            goto exitAsyncExecute;
 
-  /* If the Database COLUMN type is STRING type already, then nothing to
-   * convert simply return
-   */
-  if ( dbType == dpi::DpiVarChar || dbType == dpi::DpiFixedChar )
-  {
-    dbType = Connection::SourceDBType2TargetDBType ( dbType );
-  }
-  else
-  {
-    if ( !Connection::MapByName ( executeBaton, name, dbType ) )
-    {
-      /* If no specification by-column-name provided, then check
-       * the by-type specification.
-       * By-name overrides the by-type specification, and so if by-name found
-       * no need to check for by-type specifications.
-       */
-      if ( !MapByType ( executeBaton, dbType ) )
-      {
-        /* No conversion rules applied, convert to target type */
-        dbType = Connection::SourceDBType2TargetDBType ( dbType );
+          Connection::DoFetch(executeBaton);
+          goto exitAsyncExecute;
+        }
+
+        // The query has changed under us (e.g. the table was altered)
+        entry->clear ();
       }
-    }
-  }
 
-  return dbType;
-}
+      executeBaton->mInfo   = new MetaInfo  [ executeBaton->numCols ];
 
+      if ( !executeBaton->mInfo )
+      {
+        executeBaton->error = NJSMessages::getErrorMsg
+                                           ( errInsufficientMemory );
+        goto exitAsyncExecute;
+      }
 
+      Connection::CopyMetaData ( executeBaton->mInfo, executeBaton, mData,
+                                 executeBaton->numCols );
+      if ( !executeBaton->error.empty() )
+        goto exitAsyncExecute;
 
-/*****************************************************************************/
-/*
-   DESCRIPTION
-     Allocate defines buffer for query output and do fetch.
-     Call DPI define.
+      if ( executeBaton->getRS )
+      {
+        goto exitAsyncExecute;
+      }
 
-   PARAMETERS:
-     eBaton struct
- */
-void Connection::DoDefines ( eBaton* executeBaton )
-{
-  unsigned int numCols  = executeBaton->numCols;
-  Define       *defines = executeBaton->defines = new Define[numCols];
-  int          csratio  = executeBaton->dpiconn->getByteExpansionRatio ();
-  bool         error    = false;
+      Connection::DoDefines ( executeBaton );
+      /* If any errors while creating define structures, bail out */
+      if ( !executeBaton->error.empty() )
+        goto exitAsyncExecute;
 
-  for (unsigned int col = 0; !error && ( col < numCols ); col++)
-  {
-    /*
-     * Only supported DB column types handled here and others would have
-     * reported error while processing meta-data
-     */
-    switch( executeBaton->mInfo[col].dbType )
+      Connection::DoFetch(executeBaton);
+    }
+    else
     {
-      case dpi::DpiNumber :
-      case dpi::DpiBinaryFloat :
-      case dpi::DpiBinaryDouble :
-        defines[col].fetchType = executeBaton->mInfo[col].dpiFetchType;
-        /* For VARCHAR2 type, make sure sufficient buffer is available */
-        defines[col].maxSize = ( defines[col].fetchType == dpi::DpiVarChar) ?
-                               NJS_MAX_FETCH_AS_STRING_SIZE : sizeof (double);
+      if( executeBaton->getRS )
+      {
+        executeBaton->error = NJSMessages::getErrorMsg(
+                                errInvalidNonQueryExecution );
+        goto exitAsyncExecute;
+      }
+      executeBaton->dpistmt->execute(1, executeBaton->autoCommit);
+      executeBaton->rowsAffected = executeBaton->dpistmt->rowsAffected();
 
-        if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
-                                       executeBaton->maxRows ) )
+      // Check whether indicators were allocated as part of callback
+      // Address GitHub issue #343
+      if ( executeBaton->stmtIsReturning && executeBaton->rowsAffected )
+      {
+        for ( unsigned int b = 0; b < executeBaton->binds.size (); b++ )
         {
-          executeBaton->error = NJSMessages::getErrorMsg( errResultsTooLarge );
-          error = true;
+          if ( executeBaton->binds[b]->isOut && !executeBaton->binds[b]->ind)
+          {
+            executeBaton->error = NJSMessages::getErrorMsg (
+                                                  errSQLSyntaxError );
+            goto exitAsyncExecute;
+          }
         }
-        else
-        {
-          defines[col].buf = (double *)malloc( (size_t)defines[col].maxSize*
-                                               executeBaton->maxRows );
+      }
 
-          if( !defines[col].buf )
+      /* Check to see if the string buffer size is good in case of
+       * DML Returning.
+       */
+      if ( executeBaton->stmtIsReturning )
+      {
+        for ( unsigned int b = 0; b < executeBaton->binds.size (); b ++ )
+        {
+          /* Interested only OUT binds with VARCHAR columns */
+          if ( executeBaton->binds[b]->isOut &&
+               ( executeBaton->binds[b]->type == dpi::DpiVarChar ))
           {
-            executeBaton->error = NJSMessages::getErrorMsg(
-                                    errInsufficientMemory );
-            error = true;
+            bool err = false;
+            for ( DPI_USZ_TYPE row = 0 ;
+                  !err && ( row < executeBaton->rowsAffected) ;
+                  row ++ )
+            {
+              if (executeBaton->binds[b]->maxSize <
+                  (DPI_SZ_TYPE) executeBaton->binds[b]->len2[row])
+              {
+                /* Report insufficient buffer for OUT binds */
+                executeBaton->error =
+                  NJSMessages::getErrorMsg (errInsufficientBufferForBinds);
+                err = true;
+              }
+            }
           }
         }
+        /* Fall through the code to cleanup other objects */
+      }
 
-        break;
-      case dpi::DpiVarChar :
-      case dpi::DpiFixedChar :
-        defines[col].fetchType = executeBaton->mInfo[col].dpiFetchType;
 
-        /*
-         * the buffer size is increased to account for possible character
-         * size expansion when data is converted from the DB character set
-         * to client character set
-         */
+     /* Process date/timestamp INOUT/OUT bind values */
+     for ( unsigned int b = 0; b < executeBaton->binds.size (); b++ )
+     {
+       Bind *bind = executeBaton->binds[b];
+
+       /* Interested only OUT binds of date/timestamp type */
+       if ( bind->isOut && bind->dttmarr)
+       {
+          for (unsigned int rowidx = 0; rowidx < bind->rowsReturned; rowidx++)
+            ((long double *)(bind->extvalue))[rowidx] =
+                              bind->dttmarr->getDateTime ( rowidx ) ;
+       }
+
+       /* DATE/Timestamp could have been allocated for IN/OUT/INOUT binds */
+       if ( bind->dttmarr )
+       {
+         bind->dttmarr->release () ;
+         bind->dttmarr = NULL;
+         bind->value = NULL;
+       }
+     }
+
+     // allocate exteBinds vector with bind-array-size and initialize to NULL
+     executeBaton->extBinds.resize (
+                   ( unsigned int ) ( executeBaton->binds.size () ), NULL );
+
+     /*
+      * For each OUT Binds of valid CURSOR type, set prefetch and get
+      * meta data
+      */
+
+     for ( unsigned int b = 0; b < executeBaton->binds.size (); b ++ )
+     {
+       Bind *bind = executeBaton->binds[b];
+
+       /* Here bind->isOut is expected to be TRUE, and is checked earlier */
+       if ( bind->type == dpi::DpiRSet )
+       {
+         unsigned int state = ((Stmt*)bind->value)->getState ();
+
+         if ( state == DPI_STMT_STATE_EXECUTED )
+         {
+           // set the prefetch on the valid cursor object
+           ((dpi::Stmt *)(bind->value))->prefetchRows (
+                                              executeBaton->prefetchRows ) ;
+           // Get metaData and number of columns on valid cursor object
+           ExtBind* extBind = new ExtBind ();
+           if ( !extBind )
+           {
+             executeBaton->error = NJSMessages::getErrorMsg
+                                           ( errInsufficientMemory );
+             goto exitAsyncExecute;
+           }
+           const MetaData* mData = ((Stmt*)bind->value)->getMetaData(
+                                           executeBaton->extendedMetaData );
+           extBind->numCols      = ((Stmt*)bind->value)->numCols ();
+
+           extBind->mInfo        = new MetaInfo  [ extBind->numCols ];
+           if ( !extBind->mInfo )
+           {
+             executeBaton->error = NJSMessages::getErrorMsg
+                                                ( errInsufficientMemory );
+             goto exitAsyncExecute;
+           }
+           Connection::CopyMetaData ( extBind->mInfo, executeBaton, mData,
+                                      extBind->numCols );
+           if ( !executeBaton->error.empty() )
+             goto exitAsyncExecute;
+
+           executeBaton->extBinds [ b ] = extBind;
+         }
+         else
+         {
+           /* Release the invalid REFCURSOR to avoid any leaks */
+           ((Stmt*)bind->value)->release ();
+           bind->value = NULL;
+         }
+       }
+     }
+
+     // process any lob descriptor out binds
+     Connection::Descr2protoILob ( executeBaton, 0, 0);
+    }
+    //dpistmt will be released in exitAsyncExecute label in case of non-RS
+  }
+  catch (dpi::Exception& e)
+  {
+    NJS_SET_CONN_ERR_STATUS (  e.errnum(), executeBaton->dpiconn );
+    // In Case of DML Returning, if the buffer is small, and if the callback
+    // is called multiple times, an ORA error 24343 was reported. Converting
+    // that error to errInsufficientBufferForBinds.
+    if ( !executeBaton->stmtIsReturning ||
+         (e.errnum() != 24343) )
+    {
+      executeBaton->error = std::string(e.what ());
+    }
+    else
+    {
+      executeBaton->error = NJSMessages::getErrorMsg (
+                                     errInsufficientBufferForBinds ) ;
+    }
+  }
+  exitAsyncExecute:
+    /* Release the statement handle in case of errors or non-ResultSet
+     * In case of ResultSet and no errors, statement handle will be released
+     * while closing it.
+     */
+    if ( ( ( !(executeBaton->error).empty() ) ||
+           ( !executeBaton->getRS ) ) &&
+         executeBaton->dpistmt )
+    {
+        executeBaton->dpistmt->release ();
+    }
+
+    // In case of error, release the statement handles allocated (REF CURSOR)
+    if ( !(executeBaton->error).empty() )
+    {
+      for( unsigned int index = 0 ;index < executeBaton->binds.size();
+           index++ )
+      {
+        if( executeBaton->binds[index]->value &&
+            ( executeBaton->binds[index]->type == DpiRSet ) )
+        {
+          ((Stmt*)executeBaton->binds[index]->value)->release ();
+          executeBaton->binds[index]->value = NULL;
+        }
+      }
+    }
+  ;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Calls DPI Stmt Prepare and Bind
+
+   PARAMETERS:
+     eBaton struct
+ */
+void Connection::PrepareAndBind (eBaton* executeBaton)
+{
+  executeBaton->dpistmt = executeBaton->dpiconn->getStmt(executeBaton->sql);
+  executeBaton->st = executeBaton->dpistmt->stmtType ();
+  executeBaton->stmtIsReturning = executeBaton->dpistmt->isReturning ();
+
+  // OUT binds of executeMany are only filled through RETURNING INTO
+  if ( executeBaton->numOutBinds && !executeBaton->stmtIsReturning )
+  {
+    for ( unsigned int index = 0; index < executeBaton->binds.size ();
+          index++ )
+    {
+      if ( executeBaton->binds[index]->iterRows )
+      {
+        executeBaton->error = NJSMessages::getErrorMsg (
+                                                  errOutBindsNotReturning );
+        return;
+      }
+    }
+  }
+
+  if(!executeBaton->binds.empty())
+  {
+    if(!executeBaton->binds[0]->key.empty())
+    {
+      for(unsigned int index = 0 ;index < executeBaton->binds.size();
+          index++)
+      {
+        if ( executeBaton->binds[index]->isOut &&
+             executeBaton->stmtIsReturning &&
+             executeBaton->binds[index]->type == dpi::DpiRSet )
+        {
+          executeBaton->error = NJSMessages::getErrorMsg (
+                                                     errInvalidResultSet ) ;
+        }
+
+        // Allocate for OUT Binds
+        // For DML Returning, allocation happens through callback.
+        if ( executeBaton->binds[index]->isOut &&
+             !executeBaton->stmtIsReturning &&
+             !executeBaton->binds[index]->value )
+        {
+          Connection::cbDynBufferAllocate ( executeBaton,
+                                            false, 1, index );
+          // LOBs: binds[index]->value is a pointer to a pointer
+          // we need to allocate the underlying LOB descriptor
+          if (executeBaton->binds[index]->type == DpiClob ||
+              executeBaton->binds[index]->type == DpiBlob)
+          {
+            *((void **)executeBaton->binds[index]->value) =
+              executeBaton->dpienv->allocDescriptor(LobDescriptorType);
+          }
+        }
+
+        // Convert v8::Date to Oracle DB Type for IN and IN/OUT binds
+        if ( executeBaton->binds[index]->type == DpiTimestampLTZ &&
+            // InOut bind
+            (executeBaton->binds[index]->isInOut ||
+            // In bind
+            (!executeBaton->binds[index]->isOut &&
+             !executeBaton->binds[index]->isInOut)))
+        {
+          Connection::UpdateDateValue ( executeBaton, index ) ;
+        }
+
+        // Bind by name
+        executeBaton->dpistmt->bind(
+              (const unsigned char*)executeBaton->binds[index]->key.c_str(),
+              (int) executeBaton->binds[index]->key.length(), index,
+              executeBaton->binds[index]->type,
+              executeBaton->binds[index]->value,
+              (executeBaton->stmtIsReturning &&
+                executeBaton->binds[index]->isOut &&
+               (executeBaton->binds[index]->type == dpi::DpiVarChar )) ?
+                (executeBaton->binds[index]->maxSize + 1) :
+                executeBaton->binds[index]->maxSize,
+              executeBaton->binds[index]->ind,
+                executeBaton->binds[index]->len,
+              (executeBaton->binds[index]->isArray) ?
+                executeBaton->binds[index]->maxArraySize : 0,
+              (executeBaton->binds[index]->isArray) ?
+                &(executeBaton->binds[index]->curArraySize) : 0,
+              (executeBaton->stmtIsReturning &&
+                executeBaton->binds[index]->isOut) ?
+              (void *)executeBaton : NULL,
+              executeBaton->binds[index]->udt.get(),
+              (executeBaton->stmtIsReturning &&
+                executeBaton->binds[index]->isOut) ?
+              Connection::cbDynBufferGet : NULL);
+      }
+    }
+    else
+    {
+      for(unsigned int index = 0 ;index < executeBaton->binds.size();
+          index++)
+      {
+        // Allocate for OUT Binds
+        // For DML Returning, allocation happens through callback
+        if ( executeBaton->binds[index]->isOut &&
+             !executeBaton->stmtIsReturning &&
+             !executeBaton->binds[index]->value )
+        {
+          Connection::cbDynBufferAllocate ( executeBaton,
+                                            false, 1, index );
+        }
+
+        // Convert v8::Date to Oracle DB Type for IN and IN/OUT binds
+        if ( executeBaton->binds[index]->type == DpiTimestampLTZ &&
+            // InOut bind
+            (executeBaton->binds[index]->isInOut ||
+            // In bind
+            (!executeBaton->binds[index]->isOut &&
+             !executeBaton->binds[index]->isInOut)))
+        {
+          Connection::UpdateDateValue ( executeBaton, index ) ;
+        }
+
+        // Bind by position
+        executeBaton->dpistmt->bind(
+              index+1,executeBaton->binds[index]->type,
+              executeBaton->binds[index]->value,
+              (executeBaton->stmtIsReturning &&
+                executeBaton->binds[index]->isOut &&
+               (executeBaton->binds[index]->type == dpi::DpiVarChar )) ?
+                (executeBaton->binds[index]->maxSize + 1) :
+                 executeBaton->binds[index]->maxSize,
+              executeBaton->binds[index]->ind,
+              executeBaton->binds[index]->len,
+              (executeBaton->binds[index]->isArray) ?
+                executeBaton->binds[index]->maxArraySize : 0,
+              (executeBaton->binds[index]->isArray) ?
+                &(executeBaton->binds[index]->curArraySize ) : 0,
+              (executeBaton->stmtIsReturning &&
+                executeBaton->binds[index]->isOut ) ?
+                  (void *)executeBaton : NULL,
+              executeBaton->binds[index]->udt.get(),
+              (executeBaton->stmtIsReturning &&
+                executeBaton->binds[index]->isOut) ?
+              Connection::cbDynBufferGet : NULL);
+      }
+    }
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Copies metaData into MetaInfo and gets target fetchTypes
+
+   PARAMETERS:
+     mInfo         - an array of structs representing column info
+     executeBaton  - eBaton structure
+     mData         - meta data of columns
+     numCols       - number of columns
+ */
+void Connection::CopyMetaData ( MetaInfo           *mInfo,
+                                eBaton             *executeBaton,
+                                const MetaData*    mData,
+                                const unsigned int numCols )
+{
+  bool error = false;
+
+  for ( unsigned int col = 0; !error && ( col < numCols ); col++ )
+  {
+    mInfo[col].name         = string( (const char*)mData[col].colName,
+                                      mData[col].colNameLen );
+    mInfo[col].dbType       = mData[col].dbType;
+    mInfo[col].byteSize     = mData[col].dbSize;
+
+    if ( executeBaton->extendedMetaData )
+    {
+      mInfo[col].precision  = mData[col].precision;
+      mInfo[col].scale      = mData[col].scale;
+      mInfo[col].isNullable = mData[col].isNullable;
+    }
+
+    switch( mData[col].dbType )
+    {
+      case dpi::DpiNumber:
+      case dpi::DpiBinaryFloat:
+      case dpi::DpiBinaryDouble:
+        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
+                                                 mInfo[col].name,
+                                                 dpi::DpiDouble );
+        mInfo[col].njsFetchType =
+                     ( mInfo[col].dpiFetchType == dpi::DpiVarChar ) ?
+                                  NJS_DATATYPE_STR : NJS_DATATYPE_NUM;
+        break;
+
+      case dpi::DpiVarChar:
+      case dpi::DpiFixedChar:
+        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
+                                                 mInfo[col].name,
+                                                 dpi::DpiVarChar );
+        mInfo[col].njsFetchType = NJS_DATATYPE_STR;
+        break;
+
+      case dpi::DpiDate:
+      case dpi::DpiTimestamp:
+      case dpi::DpiTimestampLTZ:
+        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
+                                                 mInfo[col].name,
+                                                 dpi::DpiTimestampLTZ );
+        mInfo[col].njsFetchType =
+                     ( mInfo[col].dpiFetchType == dpi::DpiVarChar ) ?
+                                  NJS_DATATYPE_STR : NJS_DATATYPE_DATE;
+        break;
+
+      case dpi::DpiTimestampTZ:
+        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
+                                                 mInfo[col].name,
+                                                 dpi::DpiTimestampLTZ );
+        mInfo[col].njsFetchType =
+                     ( mInfo[col].dpiFetchType == dpi::DpiVarChar ) ?
+                                  NJS_DATATYPE_STR : NJS_DATATYPE_UNKNOWN;
+        break;
+
+      case dpi::DpiRaw:
+        mInfo[col].dpiFetchType = DpiRaw;
+        mInfo[col].njsFetchType = NJS_DATATYPE_BUFFER;
+        break;
+
+      case dpi::DpiClob:
+        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
+                                                 mInfo[col].name,
+                                                               dpi::DpiClob );
+        mInfo[col].njsFetchType =
+                     ( mInfo[col].dpiFetchType == dpi::DpiVarChar ) ?
+                                  NJS_DATATYPE_STR : NJS_DATATYPE_CLOB;
+        break;
+
+      case dpi::DpiBlob:
+        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
+                                                 mInfo[col].name,
+                                                               dpi::DpiBlob );
+        mInfo[col].njsFetchType =
+                     ( mInfo[col].dpiFetchType == dpi::DpiRaw ) ?
+                                  NJS_DATATYPE_BUFFER : NJS_DATATYPE_BLOB;
+        if ( mInfo[col].dpiFetchType == dpi::DpiVarChar )
+        {
+          // BLOBs are not converted to String
+          executeBaton->error = NJSMessages::getErrorMsg (
+                                               errInvalidTypeForConversion );
+          return;
+        }
+        break;
+
+      case dpi::DpiRowid:
+        mInfo[col].dpiFetchType = Connection::GetTargetType ( executeBaton,
+                                                 mInfo[col].name,
+                                                 dpi::DpiRowid );
+        mInfo[col].njsFetchType =
+                     ( mInfo[col].dpiFetchType == dpi::DpiVarChar ) ?
+                                  NJS_DATATYPE_STR : NJS_DATATYPE_UNKNOWN;
+        break;
+
+      case dpi::DpiUDT:
+        mInfo[col].dpiFetchType = mData[col].dbType;
+        mInfo[col].njsFetchType = NJS_DATATYPE_DEFAULT;
+        break;
+
+      default:
+        mInfo[col].njsFetchType = NJS_DATATYPE_UNKNOWN;
+        mInfo[col].dbType       = NJS_DATATYPE_UNKNOWN;
+        break;
+    }
+
+    if ( mInfo[col].njsFetchType == NJS_DATATYPE_UNKNOWN )
+    {
+      error = true;
+    }
+
+    // Repeated values of a string column may share one String
+    if ( mInfo[col].njsFetchType == NJS_DATATYPE_STR )
+    {
+      for ( unsigned int f = 0; f < executeBaton->fetchInfoCount; f++ )
+      {
+        if ( executeBaton->fetchInfo[f].dedup &&
+             executeBaton->fetchInfo[f].name == mInfo[col].name )
+        {
+          mInfo[col].dedup = true;
+        }
+      }
+    }
+  }
+
+  if ( error )
+  {
+    executeBaton->error = NJSMessages::getErrorMsg ( errUnsupportedDatType );
+  }
+}
+
+/*****************************************************************************/
+/*
+  DESCRIPTION
+    To convert various Oracle Database type to the one used by the driver
+
+  PARAMETERS
+    dbType - Dpi enumeration of database type
+
+  RETURNS
+  targetDB type (DPI enumeration)
+*/
+unsigned short Connection::SourceDBType2TargetDBType ( unsigned dbType )
+{
+  switch ( dbType )
+  {
+    /* Double is used for all numeric types */
+  case dpi::DpiNumber:
+  case dpi::DpiBinaryFloat:
+  case dpi::DpiBinaryDouble:
+  case dpi::DpiDouble:
+    dbType = dpi::DpiDouble;
+    break;
+
+    /* VARCHAR is used for all character types */
+  case dpi::DpiVarChar:
+  case dpi::DpiFixedChar:
+    dbType = dpi::DpiVarChar;
+    break;
+
+    /* TIMESTAMP WITH LOCAL TIME ZONE (LTZ) is used for all DATE/TIMESTAMP */
+  case dpi::DpiDate:
+  case dpi::DpiTimestamp:
+  case dpi::DpiTimestampLTZ:
+    dbType = dpi::DpiTimestampLTZ;
+    break;
+  }
+
+  return dbType;
+}
+
+
+/*****************************************************************************/
+/*
+  DESCRIPTION
+    Apply By-name rules if applicable
+
+  PARAMETERS
+    executeBaton          SQL Execute Baton structure
+    name                  name of the column
+    targetType[IN/OUT]  - db type [IN}, and fetchType [OUT] if a rules was
+                          applied
+
+  RETURNS
+    true if rules applied and
+    false if no matching column name available.
+*/
+boolean Connection::MapByName ( eBaton *executeBaton, std::string &name,
+                                unsigned short &targetType )
+{
+  boolean modified = false;
+
+  if ( executeBaton->fetchInfo && executeBaton->fetchInfoCount > 0 )
+  {
+    for ( unsigned int f = 0 ;
+          !modified && ( f < executeBaton->fetchInfoCount ) ;
+          f ++ )
+    {
+      /* COLUMN name should match */
+      if ( executeBaton->fetchInfo[f].name.compare ( name ) == 0 )
+      {
+        /* Only NJS_DATATYPE_STR, NJS_DATATYPE_BUFFER & NJS_DATATYPE_DEFAULT
+         * allowed.  For NJS_DATATYPE_DEFAULT, the type is identified from
+         * metadata and is already set.
+         * In case of NJS_DATATYPE_STR, set the return value.
+         * NJS_DATATYPE_BUFFER is only for BLOBs, which are read as RAW.
+         */
+        if ( executeBaton->fetchInfo[f].type == NJS_DATATYPE_STR )
+        {
+          targetType = dpi::DpiVarChar;
+        }
+        else if ( executeBaton->fetchInfo[f].type == NJS_DATATYPE_BUFFER )
+        {
+          if ( targetType == dpi::DpiBlob )
+          {
+            targetType = dpi::DpiRaw;
+          }
+          else
+          {
+            executeBaton->error = NJSMessages::getErrorMsg (
+                                               errInvalidTypeForConversion );
+          }
+        }
+        else if ( executeBaton->fetchInfo[f].type == NJS_DATATYPE_DEFAULT )
+        {
+          targetType = Connection::SourceDBType2TargetDBType ( targetType );
+        }
+        modified = true;
+      }
+    }
+  }
+
+  return modified;
+}
+
+
+
+/*****************************************************************************/
+/*
+  DESCRIPTION
+    Apply by-type conversion rules - rules are set as oracledb property
+
+  PARAMETERS
+    executeBaton  - eBaton structure for this execute call
+    dbType        - database column type from metadata(IN), targetDBtype(OUT)
+
+  RETURNS
+    true if the database type is modified based on by-type rules
+    false if not modified
+*/
+boolean Connection::MapByType ( eBaton *executeBaton, unsigned short &dbType )
+{
+  boolean modified = false;
+  unsigned int count = 0 ;
+
+  /* If oracledb property is set map using that */
+  if ( executeBaton->fetchAsStringTypes )
+  {
+    count = executeBaton->fetchAsStringTypesCount;
+
+    switch ( dbType )
+    {
+    case dpi::DpiNumber:
+    case dpi::DpiBinaryFloat:
+    case dpi::DpiBinaryDouble:
+    case dpi::DpiDouble:
+      /* Numeric Type */
+      for ( unsigned int t = 0 ; !modified && ( t < count ) ; t++)
+      {
+        if ( executeBaton->fetchAsStringTypes[t] == NJS_DATATYPE_NUM )
+        {
+          /*
+           * Convert all Numeric values to STRING
+           */
+          dbType = dpi::DpiVarChar;
+          modified = true;
+          break;
+        }
+      }
+      break;
+
+    case dpi::DpiDate:
+    case dpi::DpiTimestamp:
+    case dpi::DpiTimestampTZ:
+    case dpi::DpiTimestampLTZ:
+      /* DATE/TIMESTAMP */
+      for ( unsigned int t = 0 ; !modified && ( t < count ) ; t ++ )
+      {
+        if ( executeBaton->fetchAsStringTypes[t] == NJS_DATATYPE_DATE )
+        {
+          /* Convert all DATE/TIMESTAMP values to STRING */
+          dbType = dpi::DpiVarChar;
+          modified = true;
+          break;
+        }
+      }
+      break;
+
+    case dpi::DpiClob:
+      for ( unsigned int t = 0 ; !modified && ( t < count ) ; t ++ )
+      {
+        if ( executeBaton->fetchAsStringTypes[t] == NJS_DATATYPE_CLOB )
+        {
+          /* Read all CLOB values into STRING */
+          dbType = dpi::DpiVarChar;
+          modified = true;
+          break;
+        }
+      }
+      break;
+
+    default:  /* Other data types no supported and is checked earlier */
+      break;
+    }
+  }
+
+  /* BLOBs are read into Buffers (RAW) if set in oracledb.fetchAsBuffer */
+  if ( !modified && dbType == dpi::DpiBlob &&
+       executeBaton->fetchAsBufferTypesCount > 0 )
+  {
+    dbType = dpi::DpiRaw;
+    modified = true;
+  }
+
+  return dbType;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     To map to desired database type if any specified by Column Name or
+     oracledb type
+
+   PARAMETERS
+     eBaton  - executeBaton structure
+     name    - column name
+     default Type - if no override provided, to return the default DB type
+
+   RETURNS
+     dbType   - As default is provided, always a DB Column type will
+                be returned.
+*/
+unsigned short Connection::GetTargetType ( eBaton *executeBaton,
+                                            std::string &name,
+                                unsigned short defaultType)
+{
+  unsigned short dbType = defaultType;  // Start with DB Metadata type
+
+  /* If the Database COLUMN type is STRING type already, then nothing to
+   * convert simply return
+   */
+  if ( dbType == dpi::DpiVarChar || dbType == dpi::DpiFixedChar )
+  {
+    dbType = Connection::SourceDBType2TargetDBType ( dbType );
+  }
+  else
+  {
+    if ( !Connection::MapByName ( executeBaton, name, dbType ) )
+    {
+      /* If no specification by-column-name provided, then check
+       * the by-type specification.
+       * By-name overrides the by-type specification, and so if by-name found
+       * no need to check for by-type specifications.
+       */
+      if ( !MapByType ( executeBaton, dbType ) )
+      {
+        /* No conversion rules applied, convert to target type */
+        dbType = Connection::SourceDBType2TargetDBType ( dbType );
+      }
+    }
+  }
+
+  return dbType;
+}
+
+
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Allocate defines buffer for query output and do fetch.
+     Call DPI define.
+
+   PARAMETERS:
+     eBaton struct
+ */
+void Connection::DoDefines ( eBaton* executeBaton )
+{
+  unsigned int numCols  = executeBaton->numCols;
+  Define       *defines = executeBaton->defines = new Define[numCols];
+  Arena        *arena   = executeBaton->defineArena;
+  int          csratio  = executeBaton->dpiconn->getByteExpansionRatio ();
+  bool         error    = false;
+
+  for (unsigned int col = 0; !error && ( col < numCols ); col++)
+  {
+    /*
+     * Only supported DB column types handled here and others would have
+     * reported error while processing meta-data
+     */
+    switch( executeBaton->mInfo[col].dbType )
+    {
+      case dpi::DpiNumber :
+      case dpi::DpiBinaryFloat :
+      case dpi::DpiBinaryDouble :
+        defines[col].fetchType = executeBaton->mInfo[col].dpiFetchType;
+        /* For VARCHAR2 type, make sure sufficient buffer is available */
+        defines[col].maxSize = ( defines[col].fetchType == dpi::DpiVarChar) ?
+                               NJS_MAX_FETCH_AS_STRING_SIZE : sizeof (double);
+
+        if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
+                                       executeBaton->maxRows ) )
+        {
+          executeBaton->error = NJSMessages::getErrorMsg( errResultsTooLarge );
+          error = true;
+        }
+        else
+        {
+          /*
+           * A COLUMNAR NUMBER column buffer is handed over to a
+           * Float64Array, so it is not carved from the arena
+           */
+          defines[col].ownsBuf = ( executeBaton->outFormat ==
+                                     NJS_ROWS_COLUMNAR &&
+                                   !executeBaton->getRS &&
+                                   defines[col].fetchType == dpi::DpiDouble );
+          defines[col].buf = defines[col].ownsBuf ?
+                             malloc( (size_t)defines[col].maxSize*
+                                     executeBaton->maxRows ) :
+                             arena->alloc( (size_t)defines[col].maxSize*
+                                           executeBaton->maxRows );
+
+          if( !defines[col].buf )
+          {
+            executeBaton->error = NJSMessages::getErrorMsg(
+                                    errInsufficientMemory );
+            error = true;
+          }
+        }
+
+        break;
+      case dpi::DpiVarChar :
+      case dpi::DpiFixedChar :
+        defines[col].fetchType = executeBaton->mInfo[col].dpiFetchType;
+
+        /*
+         * the buffer size is increased to account for possible character
+         * size expansion when data is converted from the DB character set
+         * to client character set
+         */
 
         if ( executeBaton->mInfo[col].byteSize != 0 )
         {
-          defines[col].maxSize   = ( executeBaton->mInfo[col].byteSize ) *
-                                                              csratio;
+          defines[col].maxSize   = ( executeBaton->mInfo[col].byteSize ) *
+                                                              csratio;
+
+          if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
+                                         executeBaton->maxRows ) )
+          {
+            executeBaton->error = NJSMessages::getErrorMsg(
+                                               errResultsTooLarge );
+            error = true;
+          }
+          else
+          {
+            defines[col].buf = (char *)arena->alloc (
+                                              (size_t)defines[col].maxSize*
+                                              executeBaton->maxRows );
+            if( !defines[col].buf )
+            {
+              executeBaton->error = NJSMessages::getErrorMsg(
+                                      errInsufficientMemory );
+              error = true;
+            }
+          }
+        }
+        /* The null scenario will have indicator as -1, so memory allocation
+         * not required.
+         */
+        break;
+      case dpi::DpiTimestampTZ:
+        // TIMESTAMPTZ WITH TIMEZONE (TZ) supported only as STRING value
+      case dpi::DpiDate :
+      case dpi::DpiTimestamp:
+      case dpi::DpiTimestampLTZ:
+        defines[col].fetchType = executeBaton->mInfo[col].dpiFetchType;
+
+        if ( defines[col].fetchType != dpi::DpiVarChar )
+        {
+          defines[col].dttmarr   = executeBaton->dpienv->getDateTimeArray (
+                                     executeBaton->dpistmt->getError () );
+          defines[col].maxSize   = executeBaton->mInfo[col].byteSize;
+          defines[col].extbuf    = defines[col].dttmarr->init(
+                                                      executeBaton->maxRows);
+
+          /*
+           * A layout that may be cached converts the values of every
+           * execute into the same buffer, so it must hold maxRows values
+           */
+          if ( executeBaton->cacheEntry )
+          {
+            defines[col].buf = arena->alloc ( sizeof ( long double ) *
+                                              executeBaton->maxRows );
+            if ( !defines[col].buf )
+            {
+              executeBaton->error = NJSMessages::getErrorMsg(
+                                      errInsufficientMemory );
+              error = true;
+            }
+          }
+        }
+        else
+        {
+          /* Fetching DATE/TIMESTAMP values as VARCHAR */
+          defines[col].maxSize = NJS_MAX_FETCH_AS_STRING_SIZE ;
+
+          if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
+                                         executeBaton->maxRows ) )
+          {
+            executeBaton->error =
+                           NJSMessages::getErrorMsg( errResultsTooLarge );
+            error = true;
+          }
+          else
+          {
+            defines[col].buf = (char *)arena->alloc (
+                                              (size_t)defines[col].maxSize*
+                                              executeBaton->maxRows );
+
+            if( !defines[col].buf )
+            {
+              executeBaton->error = NJSMessages::getErrorMsg(
+                                       errInsufficientMemory);
+              error = true;
+            }
+          }
+
+        }
+        break;
+      case dpi::DpiRaw :
+        defines[col].fetchType = DpiRaw;
+        defines[col].maxSize   = executeBaton->mInfo[col].byteSize;
+
+        if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
+                                   executeBaton->maxRows ) )
+        {
+          executeBaton->error = NJSMessages::getErrorMsg (
+                                                     errResultsTooLarge ) ;
+          error = true;
+        }
+        else
+        {
+          /*
+           * The RAW values of a query which does not fetch into its buffers
+           * again are slices of the buffer, see BeginBatch.  Such a layout
+           * is not kept by the query cache (see QueryLayoutCacheable).
+           */
+          defines[col].ownsBuf = !executeBaton->getRS;
+          defines[col].buf = defines[col].ownsBuf ?
+                             malloc ( (size_t)defines[col].maxSize *
+                                      executeBaton->maxRows ) :
+                             arena->alloc ( (size_t)defines[col].maxSize *
+                                            executeBaton->maxRows );
+          if ( !defines[col].buf )
+          {
+            executeBaton->error = NJSMessages::getErrorMsg (
+                                           errInsufficientMemory );
+            error = true;
+          }
+        }
+        break;
+
+      case dpi::DpiClob:
+      case dpi::DpiBlob:
+      case dpi::DpiBfile:
+        defines[col].fetchType = executeBaton->mInfo[col].dbType;
+        defines[col].maxSize   = sizeof(Descriptor *);
+        // Still fetched as locators, the values are read by ReadInlineLobs
+        defines[col].lobInline = ( executeBaton->mInfo[col].dpiFetchType !=
+                                   executeBaton->mInfo[col].dbType );
+
+        if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
+                                       executeBaton->maxRows ) )
+        {
+          executeBaton->error = NJSMessages::getErrorMsg( errResultsTooLarge );
+          error = true;
+        }
+        else
+        {
+          defines[col].buf = arena->alloc ( (size_t)defines[col].maxSize*
+                                            executeBaton->maxRows );
+
+          if( !defines[col].buf )
+          {
+            executeBaton->error =
+                          NJSMessages::getErrorMsg( errInsufficientMemory );
+            error = true;
+          }
+        }
+
+        if ( !error )
+        {
+          for (unsigned int j = 0; j < executeBaton->maxRows; j++)
+          {
+            ((Descriptor **)(defines[col].buf))[j] =
+              executeBaton->dpienv->allocDescriptor(LobDescriptorType);
+          }
+        }
+        break;
+
+      case dpi::DpiRowid:
+        defines[col].fetchType = executeBaton->mInfo[col].dpiFetchType;
+
+        // ROWID supported only as STRING value
+        defines[col].maxSize = NJS_MAX_FETCH_AS_STRING_SIZE;
+
+        if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
+                                       executeBaton->maxRows ) )
+        {
+          executeBaton->error = NJSMessages::getErrorMsg( errResultsTooLarge );
+          error = true;
+        }
+        else
+        {
+          defines[col].buf = (char *)arena->alloc (
+                                              (size_t)defines[col].maxSize*
+                                              executeBaton->maxRows );
+
+          if( !defines[col].buf )
+          {
+            executeBaton->error = NJSMessages::getErrorMsg(
+                                    errInsufficientMemory);
+            error = true;
+          }
+        }
+        break;
+
+      case dpi::DpiUDT:
+        defines[col].fetchType = executeBaton->mInfo[col].dbType;
+        defines[col].maxSize   = sizeof(void *);
+
+        if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
+                                   executeBaton->maxRows ) )
+        {
+          executeBaton->error = NJSMessages::getErrorMsg( errResultsTooLarge );
+          error = true;
+        }
+        else
+        {
+          defines[col].buf = arena->calloc ( executeBaton->maxRows,
+                                             (size_t)defines[col].maxSize );
+
+          if( !defines[col].buf )
+          {
+            executeBaton->error =
+                          NJSMessages::getErrorMsg( errInsufficientMemory );
+            error = true;
+          }
+        }
+        defines[col].ind = (short*)arena->calloc (executeBaton->maxRows,
+                                                  sizeof( void* ) );
+        break;
+      default :
+        // For unsupported column types, an error is reported earlier itself
+        executeBaton->error = NJSMessages::getErrorMsg( errInternalError,
+                                              "default:", "DoDefines" );
+        error = true;
+        break;
+    }
+
+    if ( !error )
+    {
+      if (executeBaton->mInfo[col].dbType != dpi::DpiUDT)
+        defines[col].ind = (short*)arena->alloc ( sizeof( short ) *
+                                                  ( executeBaton->maxRows ) );
+      if(!defines[col].ind)
+      {
+        executeBaton->error = NJSMessages::getErrorMsg( errInsufficientMemory );
+        error = true;
+      }
+      defines[col].len = (DPI_BUFLEN_TYPE *)arena->alloc (
+                                             sizeof(DPI_BUFLEN_TYPE)*
+                                             executeBaton->maxRows);
+      if(!defines[col].len)
+      {
+        executeBaton->error = NJSMessages::getErrorMsg( errInsufficientMemory );
+        error = true;
+      }
+
+      executeBaton->dpistmt->define(col+1, defines[col].fetchType,
+                   (defines[col].dttmarr) ? defines[col].extbuf : defines[col].buf,
+                   defines[col].maxSize, defines[col].ind, defines[col].len, defines[col].udt);
+    }
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Defines the columns of a query with the defines of a cached layout.
+     Call DPI define.
+
+   PARAMETERS:
+     eBaton struct
+
+   NOTES:
+     Only the date/timestamp arrays of descriptors, which are released after
+     every fetch, are allocated again.
+ */
+void Connection::Redefine ( eBaton* executeBaton )
+{
+  Define *defines = executeBaton->defines;
+
+  for ( unsigned int col = 0; col < executeBaton->numCols; col++ )
+  {
+    if ( defines[col].fetchType == dpi::DpiTimestampLTZ )
+    {
+      defines[col].dttmarr = executeBaton->dpienv->getDateTimeArray (
+                               executeBaton->dpistmt->getError () );
+      defines[col].extbuf  = defines[col].dttmarr->init(
+                                                   executeBaton->maxRows);
+    }
+
+    executeBaton->dpistmt->define(col+1, defines[col].fetchType,
+                   (defines[col].dttmarr) ? defines[col].extbuf : defines[col].buf,
+                   defines[col].maxSize, defines[col].ind, defines[col].len, defines[col].udt);
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Compares the column info of a cached layout with the meta data of the
+     query.
+
+   PARAMETERS:
+     mInfo            - column info of the cached layout
+     mData            - meta data of the columns
+     numCols          - # of columns
+     extendedMetaData - extended meta data was requested
+
+   RETURNS:
+     true if the cached defines fit the columns
+
+   NOTES:
+     mData is read from the statement handle of this execute, so a renamed
+     column invalidates the layout.
+ */
+bool Connection::SameMetaData ( const MetaInfo*    mInfo,
+                                const MetaData*    mData,
+                                const unsigned int numCols,
+                                const bool         extendedMetaData )
+{
+  for ( unsigned int col = 0; col < numCols; col++ )
+  {
+    if ( mInfo[col].dbType   != mData[col].dbType ||
+         mInfo[col].byteSize != mData[col].dbSize ||
+         mInfo[col].name.compare ( 0, std::string::npos,
+                                   (const char*)mData[col].colName,
+                                   mData[col].colNameLen ) != 0 )
+    {
+      return false;
+    }
+
+    if ( extendedMetaData &&
+         ( mInfo[col].precision  != mData[col].precision ||
+           mInfo[col].scale      != mData[col].scale     ||
+           mInfo[col].isNullable != mData[col].isNullable ) )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Fetch rows into defines buffer for query output.
+     Call DPI fetch.
+
+   PARAMETERS:
+     eBaton struct
+ */
+void Connection::DoFetch (eBaton* executeBaton)
+{
+  NJSErrorType errNum = errSuccess;
+  executeBaton->dpistmt->fetch ( executeBaton->maxRows );
+  executeBaton->rowsFetched = executeBaton->dpistmt->rowsFetched();
+  errNum = Connection::Descr2Double ( executeBaton->defines,
+                                      executeBaton->numCols,
+                                      executeBaton->rowsFetched,
+                                      executeBaton->getRS,
+                                      executeBaton->defineArena );
+  if ( !errNum )
+  {
+    Connection::ReadInlineLobs ( executeBaton,
+                                 executeBaton->numCols,
+                                 executeBaton->rowsFetched );
+    Connection::Descr2protoILob ( executeBaton,
+                                  executeBaton->numCols,
+                                  executeBaton->rowsFetched );
+    Connection::FlagAsciiColumns ( executeBaton->defines,
+                                   executeBaton->numCols,
+                                   executeBaton->rowsFetched );
+  }
+  else
+  {
+    executeBaton->error = NJSMessages::getErrorMsg ( errNum );
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Special processing for datetime to convert descriptors to double value.
+
+   PARAMETERS:
+     defines       - Define struct
+     numCols       - # of columns
+     rowsFetched   - rows fetched
+     getRS         - boolean set for resultset
+     arena         - arena of the define buffers
+ */
+NJSErrorType Connection::Descr2Double( Define* defines, unsigned int numCols,
+                               unsigned int rowsFetched, bool getRS,
+                               Arena *arena )
+{
+  NJSErrorType errNum = errSuccess;
+
+  /* Special processing for certain data types */
+  for (unsigned int col = 0; !errNum && ( col < numCols ); col ++ )
+  {
+    /* Special processing for datetime, as it is obtained as descriptors */
+    if ( defines[col].dttmarr )
+    {
+      if ( rowsFetched )
+      {
+        long double *dblArr = NULL;
+        if ( !defines[col].buf )
+        {
+          // size_t overflow check not required here as rowsFetched
+          // (unsigned int) multiplied by sizeof(long double) never cause
+          // size_t overflow
+          defines[col].buf =
+          dblArr =
+            (long double *)arena->alloc ( sizeof ( long double ) *
+                                          rowsFetched );
 
-          if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
-                                         executeBaton->maxRows ) )
+          if( !defines[col].buf )
           {
-            executeBaton->error = NJSMessages::getErrorMsg(
-                                               errResultsTooLarge );
-            error = true;
+            errNum = errInsufficientMemory;
           }
-          else
+        }
+        else
+        {
+          dblArr = (long double *) defines[col].buf;
+        }
+
+        if ( !errNum )
+        {
+          for ( int row = 0; row < (int) rowsFetched; row ++ )
           {
-            defines[col].buf = (char *)malloc( (size_t)defines[col].maxSize*
-                                               executeBaton->maxRows );
-            if( !defines[col].buf )
+            dblArr[row] = defines[col].dttmarr->getDateTime (row);
+          }
+        }
+      }
+
+      if ( !getRS )
+      {
+        defines[col].dttmarr->release ();
+        defines[col].dttmarr = NULL;
+        defines[col].extbuf  = NULL;
+      }
+    }
+  }
+
+  return errNum;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Flags the VARCHAR columns whose fetched values are all 7-bit ASCII.
+
+   PARAMETERS:
+     defines       - Define struct
+     numCols       - # of columns
+     rowsFetched   - rows fetched
+
+   NOTES:
+     Done in the worker thread after every fetch, so that the main thread
+     can create the values of a flagged column as one-byte strings without
+     UTF-8 decoding.
+ */
+void Connection::FlagAsciiColumns ( Define* defines, unsigned int numCols,
+                                    unsigned int rowsFetched )
+{
+  for ( unsigned int col = 0; col < numCols; col++ )
+  {
+    Define *define = &defines[col];
+
+    define->ascii = ( define->fetchType == dpi::DpiVarChar && define->buf );
+
+    for ( unsigned int row = 0; define->ascii && ( row < rowsFetched );
+          row++ )
+    {
+      if ( define->ind[row] != -1 )
+      {
+        define->ascii = Connection::IsAscii (
+                          (char *) define->buf + row * define->maxSize,
+                          define->len[row] );
+      }
+    }
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Checks whether a string is 7-bit ASCII.
+
+   PARAMETERS:
+     str - client character set data
+     len - # of bytes
+
+   NOTES:
+     Tests 8 bytes at a time; compilers vectorize the loop.
+ */
+bool Connection::IsAscii ( const char *str, size_t len )
+{
+  const unsigned char *p    = (const unsigned char *) str;
+  const unsigned char *end  = p + len;
+  uint64_t             bits = 0;
+
+  for ( ; end - p >= 8; p += 8 )
+  {
+    uint64_t word;
+
+    memcpy ( &word, p, sizeof ( word ) );
+    bits |= word;
+  }
+
+  for ( ; p < end; p++ )
+  {
+    bits |= *p;
+  }
+
+  return !( bits & 0x8080808080808080ULL );
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Creates a String from client character set (UTF-8) data.
+
+   PARAMETERS:
+     str   - data
+     len   - # of bytes
+     ascii - true if the data is known to be 7-bit ASCII
+
+   NOTES:
+     ASCII data is copied as is into a one-byte string, other data is
+     decoded from UTF-8.
+ */
+Local<String> Connection::NewString ( const char *str, DPI_BUFLEN_TYPE len,
+                                      bool ascii )
+{
+  if ( ascii )
+  {
+    return Nan::NewOneByteString ( (const uint8_t *) str,
+                                   (int) len ).ToLocalChecked ();
+  }
+
+  return Nan::New<v8::String> ( str, (int) len ).ToLocalChecked ();
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Reads the values of the LOB columns fetched as String or Buffer.
+
+   PARAMETERS:
+     executeBaton  - eBaton struct
+     numCols       - # of columns
+     rowsFetched   - rows fetched
+
+   NOTES:
+     Done in the worker thread after every fetch.  The length and the data
+     of LOBs up to oracledb.lobPrefetchSize come with the locator, so such
+     values are read without a round trip; larger values take one.  The
+     locators stay in the define buffer and are fetched into again.
+ */
+void Connection::ReadInlineLobs ( eBaton *executeBaton, unsigned int numCols,
+                                  unsigned int rowsFetched )
+{
+  DpiHandle *svch    = executeBaton->dpiconn->getSvch ();
+  DpiHandle *errh    = executeBaton->dpiconn->getErrh ();
+  Define    *defines = executeBaton->defines;
+  int        csratio = 0;
+
+  for ( unsigned int col = 0; col < numCols; col++ )
+  {
+    Define *define = &defines[col];
+    size_t  used   = 0;
+
+    if ( !define->lobInline )
+    {
+      continue;
+    }
+
+    define->lobEnd.resize ( rowsFetched );
+    for ( unsigned int row = 0; row < rowsFetched; row++ )
+    {
+      Descriptor        *lobLocator = ((Descriptor **)(define->buf))[row];
+      unsigned long long length     = 0;
+      unsigned long long byteAmount = 0;
+      unsigned long long charAmount = 0;
+      unsigned long long bufl       = 0;
+
+      if ( define->ind[row] != -1 )
+      {
+        length = Lob::length ( svch, errh, lobLocator );
+      }
+
+      if ( length )
+      {
+        // CLOBs are read by characters, which may take several bytes
+        if ( define->fetchType == dpi::DpiClob )
+        {
+          if ( !csratio )
+          {
+            csratio = executeBaton->dpiconn->getByteExpansionRatio ();
+          }
+          charAmount = length;
+          bufl       = length * csratio;
+        }
+        else
+        {
+          byteAmount = bufl = length;
+        }
+
+        if ( length > NJS_MAX_FETCH_AS_LOB_SIZE )
+        {
+          executeBaton->error = NJSMessages::getErrorMsg (
+                                                   errResultsTooLarge );
+          return;
+        }
+
+        define->lobData.resize ( used + (size_t) bufl );
+        Lob::read ( svch, errh, lobLocator, byteAmount, charAmount, 1,
+                    &define->lobData[used], bufl );
+        used += (size_t) byteAmount;
+      }
+
+      define->lobEnd[row] = used;
+    }
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Special processing for lob descriptors
+
+   PARAMETERS:
+     executeBato   - eBaton struct
+     numCols       - # of columns
+     rowsFetched   - rows fetched
+ */
+void Connection::Descr2protoILob( eBaton *executeBaton, unsigned int numCols,
+                                  unsigned int rowsFetched )
+{
+  Define *defines = executeBaton->defines;
+  for (unsigned int col = 0; col < numCols; col ++ )
+  {
+    if (((defines[col].fetchType == DpiClob) ||
+         (defines[col].fetchType == DpiBlob) ||
+         (defines[col].fetchType == DpiBfile)) && !defines[col].lobInline)
+    {
+      for (unsigned int row = 0; row < rowsFetched; row++)
+      {
+        if ( (defines[col].ind)[row] == -1 )
+          continue;           // null value, nothing to convert/transfer
+        Descriptor *lobLocator = ((Descriptor **)(defines[col].buf))[row];
+
+            // The ownership of the Lob locator is going to be transferred to
+            // the ProtoILob object now.  If anything goes wrong, it is the
+            // responsibility of the ProtoILob class to free the Lob locator.
+            // Hence, setting the Lob Descriptor in the define buffer to NULL.
+
+        ((Descriptor **)(defines[col].buf))[row] = NULL;
+
+
+        ProtoILob *protoILob = new ProtoILob(executeBaton, lobLocator,
+                                             defines[col].fetchType);
+
+        if (!executeBaton->error.empty())
+        {
+              // we need to delete all ProtoLobs that have been created so far
+              // else when the executeBaton is deleted, then the defines buf
+              // cleanup will incorrectly interpret the ProtoLob as Lob
+              // Descriptor and try to free it as such.
+
+          for (unsigned int i = 0; i < col; i++)
+          {
+            if (((defines[i].fetchType == DpiClob) ||
+                 (defines[i].fetchType == DpiBlob) ||
+                 (defines[i].fetchType == DpiBfile)) &&
+                !defines[i].lobInline)
             {
-              executeBaton->error = NJSMessages::getErrorMsg(
-                                      errInsufficientMemory );
-              error = true;
+              for (unsigned int j = 0; j <  executeBaton->rowsFetched; j++)
+              {
+                // Skip this block for null values.  The null wasn't
+                // converted to a protoILob. The define buffer still
+                // points to a descriptor which can be properly
+                // freed when the executeBaton is destroyed.
+                if ( (defines[i].ind)[j] != -1 )
+                {
+                  protoILob = static_cast<ProtoILob **>(defines[i].buf)[j];
+                  delete protoILob;
+                  ((Descriptor **)(defines[i].buf))[j] = NULL;
+                }
+              }
             }
           }
-        }
-        /* The null scenario will have indicator as -1, so memory allocation
-         * not required.
-         */
-        break;
-      case dpi::DpiTimestampTZ:
-        // TIMESTAMPTZ WITH TIMEZONE (TZ) supported only as STRING value
-      case dpi::DpiDate :
-      case dpi::DpiTimestamp:
-      case dpi::DpiTimestampLTZ:
-        defines[col].fetchType = executeBaton->mInfo[col].dpiFetchType;
 
-        if ( defines[col].fetchType != dpi::DpiVarChar )
-        {
-          defines[col].dttmarr   = executeBaton->dpienv->getDateTimeArray (
-                                     executeBaton->dpistmt->getError () );
-          defines[col].maxSize   = executeBaton->mInfo[col].byteSize;
-          defines[col].extbuf    = defines[col].dttmarr->init(
-                                                      executeBaton->maxRows);
-        }
-        else
-        {
-          /* Fetching DATE/TIMESTAMP values as VARCHAR */
-          defines[col].maxSize = NJS_MAX_FETCH_AS_STRING_SIZE ;
+              // now delete ProtoLob in the current column we were working up
+              // to row that gave the error. We know that this is a Lob column
+              // as the error happenned here.
+
+          for (unsigned int j = 0; j <  row; j++)
+          {
+            // As before, skip this block for null values
+            if ( (defines[col].ind)[j] != -1 )
+            {
+              protoILob = static_cast<ProtoILob **>(defines[col].buf)[j];
+              delete protoILob;
+              ((Descriptor **)(defines[col].buf))[j] = NULL;
+            }
+          }
+
+          return;
+        } // done with error handling
+
+            // The descriptor is now replaced by the correponding LobProto.
+            // The defines buf contained a Descriptor i.e. a pointer.  We are
+            // replacing that pointer by a pointer to a ProtoILob.
+
+        ((Descriptor **)(defines[col].buf))[row] =
+          reinterpret_cast<Descriptor *>(protoILob);
+      }
+    }
+  }
+  // Now process all the OUT binds. Just as with the defines,
+  // the descriptor is replaced by a pointer to a ProtoILob
+  if (!executeBaton->rowsAffected)
+    return;  // if no rows inserted or updated, return
+  for(unsigned int obndpos = 0;  obndpos < executeBaton->binds.size(); obndpos++)
+  {
+    Bind *bind = executeBaton->binds[obndpos];
+
+    if ((!bind->isOut && !bind->isInOut) ||
+        ( bind->ind && *(sb2 *)bind->ind == -1))
+      continue;  // we only need to process the non-null OUT binds
+
+    if (bind->type == DpiClob || bind->type == DpiBlob)
+    {
+      // TODO: Update this loop when support for array binds is added.
+      // For UPDATE, loop through all the rows returned for each bind
+      // For INSERT, eventually we will consider the iters.
+      //             For now only 1 row will be inserted.
+      for (unsigned int rowidx = 0; rowidx < bind->rowsReturned; rowidx++)
+      {
+        Descriptor *lobLocator =
+          (Descriptor *)((Descriptor **)bind->value)[rowidx];
+        ProtoILob *protoILob = new ProtoILob(executeBaton, lobLocator,
+                                             bind->type);
+
+        ((Descriptor **)(bind->value))[rowidx] =
+          reinterpret_cast<Descriptor *>(protoILob);
+      }
+    }
+  }
+}
 
-          if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
-                                         executeBaton->maxRows ) )
-          {
-            executeBaton->error =
-                           NJSMessages::getErrorMsg( errResultsTooLarge );
-            error = true;
-          }
-          else
-          {
-            defines[col].buf = (char *)malloc( (size_t)defines[col].maxSize*
-                                               executeBaton->maxRows );
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Callback function of Execute method
 
-            if( !defines[col].buf )
-            {
-              executeBaton->error = NJSMessages::getErrorMsg(
-                                       errInsufficientMemory);
-              error = true;
-            }
-          }
+   PARAMETERS:
+     UV queue work block
 
-        }
-        break;
-      case dpi::DpiRaw :
-        defines[col].fetchType = DpiRaw;
-        defines[col].maxSize   = executeBaton->mInfo[col].byteSize;
+   NOTES:
+     Handle for result is formed and handed over to JS
+*/
+void Connection::Async_AfterExecute(uv_work_t *req)
+{
+  Nan::HandleScope scope;
 
-        if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
-                                   executeBaton->maxRows ) )
-        {
-          executeBaton->error = NJSMessages::getErrorMsg (
-                                                     errResultsTooLarge ) ;
-          error = true;
-        }
-        else
+  eBaton *executeBaton = (eBaton*)req->data;
+  Nan::TryCatch tc;
+  Local<Value> argv[2];
+  if(!(executeBaton->error).empty())
+  {
+    argv[0] = v8::Exception::Error(
+                 Nan::New<v8::String>(executeBaton->error).ToLocalChecked());
+    argv[1] = Nan::Undefined();
+  }
+  else
+  {
+    argv[0] = Nan::Undefined();
+    Local<Object> result = Nan::New<v8::Object>();
+    Local<Value> rowArray;
+    Local<Value> outBindValue;   // v8 Value for any out binds
+
+    switch(executeBaton->st)
+    {
+      case DpiStmtSelect :
+        if( executeBaton->getRS )
         {
-          defines[col].buf = (char *)malloc(defines[col].maxSize *
-                                          (size_t) executeBaton->maxRows) ;
-          if ( !defines[col].buf )
+          Local<Object> resultSet = Nan::New<FunctionTemplate>(
+              ResultSet::resultSetTemplate_s)->GetFunction() ->NewInstance();
+
+          /* ResultSet case, the statement object is ready for fetching */
+          (Nan::ObjectWrap::Unwrap<ResultSet> (resultSet))->
+                       setResultSet( executeBaton->dpistmt, executeBaton,
+                                     executeBaton->numCols,
+                                     executeBaton->mInfo );
+
+          if ( !executeBaton->error.empty () )
           {
-            executeBaton->error = NJSMessages::getErrorMsg (
-                                           errInsufficientMemory );
-            error = true;
+            argv[0] = v8::Exception::Error (
+                                            Nan::New<v8::String> (
+                                    executeBaton->error).ToLocalChecked());
+            argv[1] = Nan::Undefined ();
+            goto exitAsyncAfterExecute;
           }
-        }
-        break;
 
-      case dpi::DpiClob:
-      case dpi::DpiBlob:
-      case dpi::DpiBfile:
-        defines[col].fetchType = executeBaton->mInfo[col].dbType;
-        defines[col].maxSize   = sizeof(Descriptor *);
+          Nan::Set(result, Nan::New<v8::String>("rows").ToLocalChecked(),
+                   Nan::Undefined());
 
-        if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
-                                       executeBaton->maxRows ) )
-        {
-          executeBaton->error = NJSMessages::getErrorMsg( errResultsTooLarge );
-          error = true;
+          Nan::Set(result, Nan::New<v8::String>("resultSet").ToLocalChecked(),
+                   resultSet);
         }
         else
         {
-          defines[col].buf = malloc( (size_t)defines[col].maxSize*
-                                     executeBaton->maxRows );
-
-          if( !defines[col].buf )
+          rowArray = Connection::GetQueryRows ( executeBaton );
+          if(!(executeBaton->error).empty())
           {
-            executeBaton->error =
-                          NJSMessages::getErrorMsg( errInsufficientMemory );
-            error = true;
+            argv[0] = v8::Exception::Error(
+                  Nan::New<v8::String>(executeBaton->error).ToLocalChecked());
+            argv[1] = Nan::Undefined();
+            goto exitAsyncAfterExecute;
           }
+          Nan::Set(result, Nan::New<v8::String>("rows").ToLocalChecked(), rowArray);
+          Nan::Set(result, Nan::New<v8::String>("resultSet").ToLocalChecked(), Nan::Undefined());
         }
+        Nan::Set(result, Nan::New<v8::String>("outBinds").ToLocalChecked(),Nan::Undefined());
+        Nan::Set(result, Nan::New<v8::String>("rowsAffected").ToLocalChecked(), Nan::Undefined());
+        Nan::Set( result, Nan::New<v8::String>("metaData").ToLocalChecked(),
+                  Connection::GetQueryMetaData ( executeBaton ) );
+        break;
 
-        if ( !error )
+      case DpiStmtBegin:
+      case DpiStmtDeclare:
+      case DpiStmtCall:
+        outBindValue = Connection::GetOutBinds(executeBaton);
+        // If any error report in callback
+        if ( !executeBaton->error.empty () )
         {
-          for (unsigned int j = 0; j < executeBaton->maxRows; j++)
-          {
-            ((Descriptor **)(defines[col].buf))[j] =
-              executeBaton->dpienv->allocDescriptor(LobDescriptorType);
-          }
+          argv[0] = v8::Exception::Error (
+                      Nan::New<v8::String> (
+                                    executeBaton->error).ToLocalChecked ());
+          argv[1] = Nan::Undefined ();
+          goto exitAsyncAfterExecute;
         }
-        break;
-
-      case dpi::DpiRowid:
-        defines[col].fetchType = executeBaton->mInfo[col].dpiFetchType;
 
-        // ROWID supported only as STRING value
-        defines[col].maxSize = NJS_MAX_FETCH_AS_STRING_SIZE;
+        Nan::ForceSet(result,
+                      Nan::New<v8::String>("outBinds").ToLocalChecked(),
+                      outBindValue,
+                      v8::ReadOnly);
+        Nan::Set(result, Nan::New<v8::String>("rowsAffected").ToLocalChecked(),
+                 Nan::Undefined());
 
-        if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
-                                       executeBaton->maxRows ) )
+        Nan::Set(result, Nan::New<v8::String>("rows").ToLocalChecked(),
+                 Nan::Undefined());
+        Nan::Set(result, Nan::New<v8::String>("metaData").ToLocalChecked(),
+                 Nan::Undefined());
+        break;
+      default :
+        Nan::ForceSet(result,
+                      Nan::New<v8::String>("rowsAffected").ToLocalChecked(),
+             Nan::New<v8::Integer>((unsigned int) executeBaton->rowsAffected),
+                      v8::ReadOnly);
+        if( executeBaton->numOutBinds )
         {
-          executeBaton->error = NJSMessages::getErrorMsg( errResultsTooLarge );
-          error = true;
+          Nan::ForceSet(result,
+                        Nan::New<v8::String>("outBinds").ToLocalChecked(),
+                        Connection::GetOutBinds(executeBaton), v8::ReadOnly);
         }
         else
         {
-          defines[col].buf = (char *)malloc( (size_t)defines[col].maxSize*
-                                             executeBaton->maxRows );
-
-          if( !defines[col].buf )
-          {
-            executeBaton->error = NJSMessages::getErrorMsg(
-                                    errInsufficientMemory);
-            error = true;
-          }
+          Nan::Set(result, Nan::New<v8::String>("outBinds").ToLocalChecked(),
+                   Nan::Undefined());
         }
+        Nan::Set(result, Nan::New<v8::String>("rows").ToLocalChecked(),
+                 Nan::Undefined());
+        Nan::Set(result, Nan::New<v8::String>("metaData").ToLocalChecked(),
+                 Nan::Undefined());
         break;
+    }
+    argv[1] = result;
+  }
+exitAsyncAfterExecute:
+  Local<Function> callback = Nan::New<Function>(executeBaton->cb);
+  if ( executeBaton->cacheEntry )
+  {
+    executeBaton->njsconn->checkinQuery ( executeBaton );
+  }
+  executeBaton->getRS = false;  // To cleanup in case of parent SQL execution
+  delete executeBaton;
+  Nan::MakeCallback( Nan::GetCurrentContext()->Global(), callback, 2, argv );
+  if(tc.HasCaught())
+  {
+    Nan::FatalException(tc);
+  }
+}
 
-      case dpi::DpiUDT:
-        defines[col].fetchType = executeBaton->mInfo[col].dbType;
-        defines[col].maxSize   = sizeof(void *);
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Lends the cached layout of a query to an execute.
 
-        if ( NJS_SIZE_T_OVERFLOW ( defines[col].maxSize,
-                                   executeBaton->maxRows ) )
-        {
-          executeBaton->error = NJSMessages::getErrorMsg( errResultsTooLarge );
-          error = true;
-        }
-        else
-        {
-          defines[col].buf = calloc( executeBaton->maxRows,
-                                     (size_t)defines[col].maxSize );
+   PARAMETERS:
+     executeBaton - eBaton struct
 
-          if( !defines[col].buf )
-          {
-            executeBaton->error =
-                          NJSMessages::getErrorMsg( errInsufficientMemory );
-            error = true;
-          }
-        }
-        defines[col].ind = (short*)calloc (executeBaton->maxRows, sizeof( void* ) );
-        break;
-      default :
-        // For unsupported column types, an error is reported earlier itself
-        executeBaton->error = NJSMessages::getErrorMsg( errInternalError,
-                                              "default:", "DoDefines" );
-        error = true;
-        break;
-    }
+   NOTES:
+     Executes of the same SQL text with the same options affecting the
+     defines share an entry, which is lent to one execute at a time.  The
+     define buffers of the execute are carved from the arena of the entry so
+     that checkinQuery () can keep them.  ResultSets and COLUMNAR results
+     hand their buffers over and are not cached.
+ */
+void Connection::checkoutQuery ( eBaton *executeBaton )
+{
+  QueryCacheEntry *entry = NULL;
+  std::string      key;
 
-    if ( !error )
+  if ( !queryCacheSize_ || executeBaton->getRS ||
+       executeBaton->outFormat == NJS_ROWS_COLUMNAR )
+  {
+    return;
+  }
+
+  key = Connection::QueryCacheKey ( executeBaton );
+
+  std::unordered_map<std::string, QueryCacheEntry*>::iterator it =
+                                                      queryCache_.find ( key );
+  if ( it != queryCache_.end () )
+  {
+    entry = it->second;
+    if ( entry->inUse || !entry->cacheable )
+    {
+      return;
+    }
+  }
+  else
+  {
+    // Make room by evicting the least recently used entry not lent out
+    if ( queryCache_.size () >= queryCacheSize_ )
     {
-      if (executeBaton->mInfo[col].dbType != dpi::DpiUDT)
-        defines[col].ind = (short*)malloc ( sizeof( short ) *
-                                            ( executeBaton->maxRows ) );
-      if(!defines[col].ind)
+      std::unordered_map<std::string, QueryCacheEntry*>::iterator lru =
+                                                            queryCache_.end ();
+
+      for ( it = queryCache_.begin (); it != queryCache_.end (); it++ )
       {
-        executeBaton->error = NJSMessages::getErrorMsg( errInsufficientMemory );
-        error = true;
+        if ( !it->second->inUse &&
+             ( lru == queryCache_.end () ||
+               it->second->lastUse < lru->second->lastUse ) )
+        {
+          lru = it;
+        }
       }
-      defines[col].len = (DPI_BUFLEN_TYPE *)malloc(sizeof(DPI_BUFLEN_TYPE)*
-                                             executeBaton->maxRows);
-      if(!defines[col].len)
+
+      if ( lru == queryCache_.end () )
       {
-        executeBaton->error = NJSMessages::getErrorMsg( errInsufficientMemory );
-        error = true;
+        return;
       }
 
-      executeBaton->dpistmt->define(col+1, defines[col].fetchType,
-                   (defines[col].buf) ? defines[col].buf : defines[col].extbuf,
-                   defines[col].maxSize, defines[col].ind, defines[col].len, defines[col].udt);
+      delete lru->second;
+      queryCache_.erase ( lru );
     }
+
+    entry = new QueryCacheEntry ();
+    queryCache_[key] = entry;
   }
+
+  entry->inUse              = true;
+  entry->lastUse            = ++queryCacheUses_;
+  executeBaton->cacheEntry  = entry;
+  executeBaton->defineArena = &entry->arena;
 }
 
 /*****************************************************************************/
 /*
    DESCRIPTION
-     Fetch rows into defines buffer for query output.
-     Call DPI fetch.
+     Returns the cached layout of a query after an execute.
 
    PARAMETERS:
-     eBaton struct
+     executeBaton - eBaton struct
+
+   NOTES:
+     The layout of the first successful execute is kept if it can be reused
+     (see QueryLayoutCacheable).  Statements without defines and layouts
+     which cannot be reused are not tried again.  A failed execute drops the
+     layout it was lent, the baton cleans it up.
  */
-void Connection::DoFetch (eBaton* executeBaton)
+void Connection::checkinQuery ( eBaton *executeBaton )
 {
-  NJSErrorType errNum = errSuccess;
-  executeBaton->dpistmt->fetch ( executeBaton->maxRows );
-  executeBaton->rowsFetched = executeBaton->dpistmt->rowsFetched();
-  errNum = Connection::Descr2Double ( executeBaton->defines,
-                                      executeBaton->numCols,
-                                      executeBaton->rowsFetched,
-                                      executeBaton->getRS );
-  if ( !errNum )
+  QueryCacheEntry *entry = executeBaton->cacheEntry;
+
+  if ( !executeBaton->error.empty () )
   {
-    Connection::Descr2protoILob ( executeBaton,
-                                  executeBaton->numCols,
-                                  executeBaton->rowsFetched );
+    if ( entry->defines && entry->defines == executeBaton->defines )
+    {
+      for ( unsigned int col = 0; col < entry->numCols; col++ )
+      {
+        if ( entry->defines[col].dttmarr )
+        {
+          entry->defines[col].dttmarr->release ();
+          entry->defines[col].dttmarr = NULL;
+        }
+      }
+
+      entry->defines = NULL;
+      entry->mInfo   = NULL;
+      entry->numCols = 0;
+    }
+    entry->metaDataValid = false;
+    entry->rowShapeValid = false;
   }
-  else
+  else if ( !entry->defines )
   {
-    executeBaton->error = NJSMessages::getErrorMsg ( errNum );
+    if ( executeBaton->defines &&
+         Connection::QueryLayoutCacheable ( executeBaton ) )
+    {
+      entry->mInfo   = executeBaton->mInfo;
+      entry->defines = executeBaton->defines;
+      entry->numCols = executeBaton->numCols;
+    }
+    else
+    {
+      entry->cacheable = false;
+    }
   }
 }
 
 /*****************************************************************************/
 /*
    DESCRIPTION
-     Special processing for datetime to convert descriptors to double value.
+     Frees all the cached query layouts.
+ */
+void Connection::clearQueryCache ()
+{
+  std::unordered_map<std::string, QueryCacheEntry*>::iterator it;
+
+  for ( it = queryCache_.begin (); it != queryCache_.end (); it++ )
+  {
+    delete it->second;
+  }
+  queryCache_.clear ();
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Forms the key of the cached layout of a query.
 
    PARAMETERS:
-     defines       - Define struct
-     numCols       - # of columns
-     rowsFetched   - rows fetched
-     getRS         - boolean set for resultset
+     executeBaton - eBaton struct
+
+   RETURNS:
+     SQL text followed by the options which affect the defines
  */
-NJSErrorType Connection::Descr2Double( Define* defines, unsigned int numCols,
-                               unsigned int rowsFetched, bool getRS )
+std::string Connection::QueryCacheKey ( eBaton *executeBaton )
 {
-  NJSErrorType errNum = errSuccess;
+  std::string key = executeBaton->sql;
 
-  /* Special processing for certain data types */
-  for (unsigned int col = 0; !errNum && ( col < numCols ); col ++ )
+  key.append ( 1, '\0' );
+  key.append ( (const char *) &executeBaton->maxRows,
+               sizeof ( executeBaton->maxRows ) );
+  key.append ( 1, executeBaton->extendedMetaData ? '1' : '0' );
+
+  for ( unsigned int t = 0; t < executeBaton->fetchAsStringTypesCount; t++ )
   {
-    /* Special processing for datetime, as it is obtained as descriptors */
-    if ( defines[col].dttmarr )
+    key.append ( (const char *) &executeBaton->fetchAsStringTypes[t],
+                 sizeof ( DataType ) );
+  }
+
+  for ( unsigned int i = 0; i < executeBaton->fetchInfoCount; i++ )
+  {
+    key.append ( 1, '\0' );
+    key.append ( executeBaton->fetchInfo[i].name );
+    key.append ( 1, '\0' );
+    key.append ( (const char *) &executeBaton->fetchInfo[i].type,
+                 sizeof ( DataType ) );
+    key.append ( 1, executeBaton->fetchInfo[i].dedup ? '1' : '0' );
+  }
+
+  return key;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Checks whether the layout of a query can be kept for reuse.
+
+   PARAMETERS:
+     executeBaton - eBaton struct
+
+   RETURNS:
+     false for LOB, BFILE and object columns, which hold descriptors per
+     row, for RAW columns, whose buffers are handed over to the values, and
+     for define buffers larger than NJS_QUERY_CACHE_MAX_BYTES
+ */
+bool Connection::QueryLayoutCacheable ( eBaton *executeBaton )
+{
+  size_t rowSize = 0;
+
+  for ( unsigned int col = 0; col < executeBaton->numCols; col++ )
+  {
+    const Define &define = executeBaton->defines[col];
+
+    switch ( define.fetchType )
     {
-      if ( rowsFetched )
-      {
-        long double *dblArr = NULL;
-        if ( !defines[col].buf )
-        {
-          // size_t overflow check not required here as rowsFetched
-          // (unsigned int) multiplied by sizeof(long double) never cause
-          // size_t overflow
-          defines[col].buf =
-          dblArr =
-            (long double *)malloc ( sizeof ( long double ) * rowsFetched );
+      case dpi::DpiClob:
+      case dpi::DpiBlob:
+      case dpi::DpiBfile:
+      case dpi::DpiUDT:
+        return false;
 
-          if( !defines[col].buf )
-          {
-            errNum = errInsufficientMemory;
-          }
-        }
-        else
-        {
-          dblArr = (long double *) defines[col].buf;
-        }
+#if NODE_MODULE_VERSION >= NODE_4_0_MODULE_VERSION
+      case dpi::DpiRaw:
+        return false;
+#endif
 
-        if ( !errNum )
-        {
-          for ( int row = 0; row < (int) rowsFetched; row ++ )
-          {
-            dblArr[row] = defines[col].dttmarr->getDateTime (row);
-          }
-        }
-      }
+      case dpi::DpiTimestampLTZ:
+        rowSize += sizeof ( long double );
+        break;
 
-      if ( !getRS )
-      {
-        defines[col].dttmarr->release ();
-        defines[col].dttmarr = NULL;
-        defines[col].extbuf  = NULL;
-      }
+      default:
+        rowSize += (size_t) define.maxSize;
+        break;
     }
+    rowSize += sizeof ( short ) + sizeof ( DPI_BUFLEN_TYPE );
   }
 
-  return errNum;
+  return !executeBaton->maxRows ||
+         rowSize <= NJS_QUERY_CACHE_MAX_BYTES / executeBaton->maxRows;
 }
 
 /*****************************************************************************/
 /*
    DESCRIPTION
-     Special processing for lob descriptors
+     Worker function of ExecuteMany method
 
    PARAMETERS:
-     executeBato   - eBaton struct
-     numCols       - # of columns
-     rowsFetched   - rows fetched
- */
-void Connection::Descr2protoILob( eBaton *executeBaton, unsigned int numCols,
-                                  unsigned int rowsFetched )
+     UV queue work block
+
+   NOTES:
+     DPI call execution, one execute call for all the bind rows
+*/
+void Connection::Async_ExecuteMany (uv_work_t *req)
 {
-  Define *defines = executeBaton->defines;
-  for (unsigned int col = 0; col < numCols; col ++ )
+  eBaton *executeBaton = (eBaton*)req->data;
+  if(!(executeBaton->error).empty()) goto exitAsyncExecuteMany;
+
+  try
   {
-    if ((defines[col].fetchType == DpiClob) ||
-        (defines[col].fetchType == DpiBlob) ||
-        (defines[col].fetchType == DpiBfile))
+    Connection::PrepareAndBind(executeBaton);
+
+    if ( !executeBaton->error.empty() )  goto exitAsyncExecuteMany;
+
+    if ( executeBaton->st == DpiStmtSelect )
     {
-      for (unsigned int row = 0; row < rowsFetched; row++)
+      executeBaton->error = NJSMessages::getErrorMsg ( errQueryNotAllowed );
+      goto exitAsyncExecuteMany;
+    }
+
+    /* Descriptors for all the DATE values RETURNING INTO may give back */
+    for ( unsigned int b = 0; b < executeBaton->binds.size (); b++ )
+    {
+      Bind *bind = executeBaton->binds[b];
+
+      if ( bind->iterRows && bind->type == dpi::DpiTimestampLTZ )
       {
-        if ( (defines[col].ind)[row] == -1 )
-          continue;           // null value, nothing to convert/transfer
-        Descriptor *lobLocator = ((Descriptor **)(defines[col].buf))[row];
+        bind->dttmarr = executeBaton->dpienv->getDateTimeArray (
+                                        executeBaton->dpistmt->getError () );
+        bind->value = bind->dttmarr->init ( executeBaton->numIterations *
+                                            bind->maxArraySize );
+      }
+    }
 
-            // The ownership of the Lob locator is going to be transferred to
-            // the ProtoILob object now.  If anything goes wrong, it is the
-            // responsibility of the ProtoILob class to free the Lob locator.
-            // Hence, setting the Lob Descriptor in the define buffer to NULL.
+    executeBaton->dpistmt->execute ( executeBaton->numIterations,
+                                     executeBaton->autoCommit,
+                                     executeBaton->batchErrors );
+    executeBaton->rowsAffected = executeBaton->dpistmt->rowsAffected ();
 
-        ((Descriptor **)(defines[col].buf))[row] = NULL;
+    if ( executeBaton->batchErrors )
+    {
+      executeBaton->dpistmt->getBatchErrors ( executeBaton->batchErrorInfo );
+    }
 
+    /* Check the string lengths and convert the dates of RETURNING INTO */
+    for ( unsigned int b = 0; b < executeBaton->binds.size (); b++ )
+    {
+      Bind *bind = executeBaton->binds[b];
 
-        ProtoILob *protoILob = new ProtoILob(executeBaton, lobLocator,
-                                             defines[col].fetchType);
+      if ( !bind->iterRows )
+        continue;
 
-        if (!executeBaton->error.empty())
-        {
-              // we need to delete all ProtoLobs that have been created so far
-              // else when the executeBaton is deleted, then the defines buf
-              // cleanup will incorrectly interpret the ProtoLob as Lob
-              // Descriptor and try to free it as such.
+      for ( unsigned int iter = 0; iter < executeBaton->numIterations;
+            iter++ )
+      {
+        size_t slot = (size_t) iter * bind->maxArraySize;
 
-          for (unsigned int i = 0; i < col; i++)
+        for ( unsigned int row = 0; row < bind->iterRows[iter];
+              row++, slot++ )
+        {
+          if ( bind->type == dpi::DpiVarChar &&
+               bind->maxSize < (DPI_SZ_TYPE) bind->len2[slot] )
           {
-            if ((defines[i].fetchType == DpiClob) ||
-                (defines[i].fetchType == DpiBlob) ||
-                (defines[i].fetchType == DpiBfile))
-            {
-              for (unsigned int j = 0; j <  executeBaton->rowsFetched; j++)
-              {
-                // Skip this block for null values.  The null wasn't
-                // converted to a protoILob. The define buffer still
-                // points to a descriptor which can be properly
-                // freed when the executeBaton is destroyed.
-                if ( (defines[i].ind)[j] != -1 )
-                {
-                  protoILob = static_cast<ProtoILob **>(defines[i].buf)[j];
-                  delete protoILob;
-                  ((Descriptor **)(defines[i].buf))[j] = NULL;
-                }
-              }
-            }
+            executeBaton->error = NJSMessages::getErrorMsg (
+                                             errInsufficientBufferForBinds );
+            goto exitAsyncExecuteMany;
           }
-
-              // now delete ProtoLob in the current column we were working up
-              // to row that gave the error. We know that this is a Lob column
-              // as the error happenned here.
-
-          for (unsigned int j = 0; j <  row; j++)
+          if ( bind->dttmarr && bind->ind[slot] != -1 )
           {
-            // As before, skip this block for null values
-            if ( (defines[col].ind)[j] != -1 )
-            {
-              protoILob = static_cast<ProtoILob **>(defines[col].buf)[j];
-              delete protoILob;
-              ((Descriptor **)(defines[col].buf))[j] = NULL;
-            }
+            ((long double *)bind->extvalue)[slot] =
+                              bind->dttmarr->getDateTime ( slot );
           }
-
-          return;
-        } // done with error handling
-
-            // The descriptor is now replaced by the correponding LobProto.
-            // The defines buf contained a Descriptor i.e. a pointer.  We are
-            // replacing that pointer by a pointer to a ProtoILob.
-
-        ((Descriptor **)(defines[col].buf))[row] =
-          reinterpret_cast<Descriptor *>(protoILob);
+        }
       }
     }
+
+    // OUT binds are picked up through GetOutBinds (), no extended binds
+    executeBaton->extBinds.resize ( executeBaton->binds.size (), NULL );
   }
-  // Now process all the OUT binds. Just as with the defines,
-  // the descriptor is replaced by a pointer to a ProtoILob
-  if (!executeBaton->rowsAffected)
-    return;  // if no rows inserted or updated, return
-  for(unsigned int obndpos = 0;  obndpos < executeBaton->binds.size(); obndpos++)
+  catch (dpi::Exception& e)
   {
-    Bind *bind = executeBaton->binds[obndpos];
-
-    if ((!bind->isOut && !bind->isInOut) ||
-        ( bind->ind && *(sb2 *)bind->ind == -1))
-      continue;  // we only need to process the non-null OUT binds
-
-    if (bind->type == DpiClob || bind->type == DpiBlob)
+    NJS_SET_CONN_ERR_STATUS (  e.errnum(), executeBaton->dpiconn );
+    // Errors of the RETURNING INTO callback are reported as ORA-24343, the
+    // callback has set the error (or the buffer was too small)
+    if ( !executeBaton->stmtIsReturning || e.errnum() != 24343 )
     {
-      // TODO: Update this loop when support for array binds is added.
-      // For UPDATE, loop through all the rows returned for each bind
-      // For INSERT, eventually we will consider the iters.
-      //             For now only 1 row will be inserted.
-      for (unsigned int rowidx = 0; rowidx < bind->rowsReturned; rowidx++)
-      {
-        Descriptor *lobLocator =
-          (Descriptor *)((Descriptor **)bind->value)[rowidx];
-        ProtoILob *protoILob = new ProtoILob(executeBaton, lobLocator,
-                                             bind->type);
+      executeBaton->error = std::string(e.what ());
+    }
+    else if ( executeBaton->error.empty () )
+    {
+      executeBaton->error = NJSMessages::getErrorMsg (
+                                     errInsufficientBufferForBinds ) ;
+    }
+  }
+  exitAsyncExecuteMany:
+    /* DATE/Timestamp descriptors allocated for the binds */
+    for ( unsigned int b = 0; b < executeBaton->binds.size (); b++ )
+    {
+      Bind *bind = executeBaton->binds[b];
 
-        ((Descriptor **)(bind->value))[rowidx] =
-          reinterpret_cast<Descriptor *>(protoILob);
+      if ( bind->dttmarr )
+      {
+        bind->dttmarr->release () ;
+        bind->dttmarr = NULL;
+        bind->value = NULL;
       }
     }
-  }
+
+    if ( executeBaton->dpistmt )
+    {
+      executeBaton->dpistmt->release ();
+    }
+  ;
 }
 
 /*****************************************************************************/
 /*
    DESCRIPTION
-     Callback function of Execute method
+     Callback function of ExecuteMany method
 
    PARAMETERS:
      UV queue work block
 
    NOTES:
-     Handle for result is formed and handed over to JS
+     Result with rowsAffected, in batch errors mode the errors of the failed
+     rows and the values of RETURNING INTO is handed over to JS
 */
-void Connection::Async_AfterExecute(uv_work_t *req)
+void Connection::Async_AfterExecuteMany (uv_work_t *req)
 {
   Nan::HandleScope scope;
 
   eBaton *executeBaton = (eBaton*)req->data;
   Nan::TryCatch tc;
   Local<Value> argv[2];
+
   if(!(executeBaton->error).empty())
   {
     argv[0] = v8::Exception::Error(
@@ -2856,114 +4485,54 @@ void Connection::Async_AfterExecute(uv_work_t *req)
   }
   else
   {
-    argv[0] = Nan::Undefined();
     Local<Object> result = Nan::New<v8::Object>();
-    Local<Value> rowArray;
-    Local<Value> outBindValue;   // v8 Value for any out binds
-
-    switch(executeBaton->st)
-    {
-      case DpiStmtSelect :
-        if( executeBaton->getRS )
-        {
-          Local<Object> resultSet = Nan::New<FunctionTemplate>(
-              ResultSet::resultSetTemplate_s)->GetFunction() ->NewInstance();
-
-          /* ResultSet case, the statement object is ready for fetching */
-          (Nan::ObjectWrap::Unwrap<ResultSet> (resultSet))->
-                       setResultSet( executeBaton->dpistmt, executeBaton,
-                                     executeBaton->numCols,
-                                     executeBaton->mInfo );
 
-          if ( !executeBaton->error.empty () )
-          {
-            argv[0] = v8::Exception::Error (
-                                            Nan::New<v8::String> (
-                                    executeBaton->error).ToLocalChecked());
-            argv[1] = Nan::Undefined ();
-            goto exitAsyncAfterExecute;
-          }
+    Nan::Set(result, Nan::New<v8::String>("rowsAffected").ToLocalChecked(),
+             Nan::New<v8::Integer>((unsigned int) executeBaton->rowsAffected));
 
-          Nan::Set(result, Nan::New<v8::String>("rows").ToLocalChecked(),
-                   Nan::Undefined());
-
-          Nan::Set(result, Nan::New<v8::String>("resultSet").ToLocalChecked(),
-                   resultSet);
-        }
-        else
-        {
-          rowArray = Connection::GetRows(executeBaton);
-          if(!(executeBaton->error).empty())
-          {
-            argv[0] = v8::Exception::Error(
-                  Nan::New<v8::String>(executeBaton->error).ToLocalChecked());
-            argv[1] = Nan::Undefined();
-            goto exitAsyncAfterExecute;
-          }
-          Nan::Set(result, Nan::New<v8::String>("rows").ToLocalChecked(), rowArray);
-          Nan::Set(result, Nan::New<v8::String>("resultSet").ToLocalChecked(), Nan::Undefined());
-        }
-        Nan::Set(result, Nan::New<v8::String>("outBinds").ToLocalChecked(),Nan::Undefined());
-        Nan::Set(result, Nan::New<v8::String>("rowsAffected").ToLocalChecked(), Nan::Undefined());
-        Nan::Set( result, Nan::New<v8::String>("metaData").ToLocalChecked(),
-                  Connection::GetMetaData( executeBaton->mInfo,
-                                           executeBaton->numCols,
-                                           executeBaton->extendedMetaData ) );
-        break;
+    if ( executeBaton->batchErrors )
+    {
+      std::vector<dpi::BatchError> &errors = executeBaton->batchErrorInfo;
+      Local<Array> batchErrors = Nan::New<v8::Array>(
+                                     (unsigned int) errors.size () );
 
-      case DpiStmtBegin:
-      case DpiStmtDeclare:
-      case DpiStmtCall:
-        outBindValue = Connection::GetOutBinds(executeBaton);
-        // If any error report in callback
-        if ( !executeBaton->error.empty () )
-        {
-          argv[0] = v8::Exception::Error (
-                      Nan::New<v8::String> (
-                                    executeBaton->error).ToLocalChecked ());
-          argv[1] = Nan::Undefined ();
-          goto exitAsyncAfterExecute;
-        }
+      for ( unsigned int index = 0; index < errors.size (); index++ )
+      {
+        Local<Object> batchError = Nan::New<v8::Object>();
+
+        Nan::Set(batchError,
+                 Nan::New<v8::String>("offset").ToLocalChecked(),
+                 Nan::New<v8::Integer>(errors[index].offset));
+        Nan::Set(batchError,
+                 Nan::New<v8::String>("errorNum").ToLocalChecked(),
+                 Nan::New<v8::Integer>(errors[index].errNum));
+        Nan::Set(batchError,
+                 Nan::New<v8::String>("message").ToLocalChecked(),
+                 Nan::New<v8::String>(errors[index].message).ToLocalChecked());
+        Nan::Set(batchErrors, index, batchError);
+      }
+      Nan::Set(result, Nan::New<v8::String>("batchErrors").ToLocalChecked(),
+               batchErrors);
+    }
+    else
+    {
+      Nan::Set(result, Nan::New<v8::String>("batchErrors").ToLocalChecked(),
+               Nan::Undefined());
+    }
 
-        Nan::ForceSet(result,
-                      Nan::New<v8::String>("outBinds").ToLocalChecked(),
-                      outBindValue,
-                      v8::ReadOnly);
-        Nan::Set(result, Nan::New<v8::String>("rowsAffected").ToLocalChecked(),
-                 Nan::Undefined());
+    if ( executeBaton->numOutBinds )
+    {
+      Local<Value> outBinds = Connection::GetOutBinds ( executeBaton );
 
-        Nan::Set(result, Nan::New<v8::String>("rows").ToLocalChecked(),
-                 Nan::Undefined());
-        Nan::Set(result, Nan::New<v8::String>("metaData").ToLocalChecked(),
-                 Nan::Undefined());
-        break;
-      default :
-        Nan::ForceSet(result,
-                      Nan::New<v8::String>("rowsAffected").ToLocalChecked(),
-             Nan::New<v8::Integer>((unsigned int) executeBaton->rowsAffected),
-                      v8::ReadOnly);
-        if( executeBaton->numOutBinds )
-        {
-          Nan::ForceSet(result,
-                        Nan::New<v8::String>("outBinds").ToLocalChecked(),
-                        Connection::GetOutBinds(executeBaton), v8::ReadOnly);
-        }
-        else
-        {
-          Nan::Set(result, Nan::New<v8::String>("outBinds").ToLocalChecked(),
-                   Nan::Undefined());
-        }
-        Nan::Set(result, Nan::New<v8::String>("rows").ToLocalChecked(),
-                 Nan::Undefined());
-        Nan::Set(result, Nan::New<v8::String>("metaData").ToLocalChecked(),
-                 Nan::Undefined());
-        break;
+      Nan::Set(result, Nan::New<v8::String>("outBinds").ToLocalChecked(),
+               outBinds);
     }
+
+    argv[0] = Nan::Undefined();
     argv[1] = result;
   }
-exitAsyncAfterExecute:
+
   Local<Function> callback = Nan::New<Function>(executeBaton->cb);
-  executeBaton->getRS = false;  // To cleanup in case of parent SQL execution
   delete executeBaton;
   Nan::MakeCallback( Nan::GetCurrentContext()->Global(), callback, 2, argv );
   if(tc.HasCaught())
@@ -3037,82 +4606,443 @@ v8::Local<v8::Value> Connection::GetMetaData (
                 Nan::New<v8::Boolean>(mInfo[i].isNullable) );
     }
 
-    Nan::Set(metaArray, i, column);
+    Nan::Set(metaArray, i, column);
+  }
+
+  return scope.Escape(metaArray);
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Returns the metaData array of a query executed without a ResultSet.
+
+   PARAMETERS:
+     executeBaton - eBaton struct
+
+   RETURNS:
+     MetaData Handle
+
+   NOTES:
+     When the layout of the query comes from the query cache the array
+     built by an earlier execute is returned again, so the executes of the
+     same query share one metaData array.
+*/
+v8::Local<v8::Value> Connection::GetQueryMetaData ( eBaton* executeBaton )
+{
+  Nan::EscapableHandleScope scope;
+  QueryCacheEntry *entry = executeBaton->cacheEntry;
+  Local<Value>     metaData;
+
+  if ( entry && entry->metaDataValid && entry->mInfo &&
+       entry->mInfo == executeBaton->mInfo )
+  {
+    return scope.Escape ( Nan::New<v8::Array> ( entry->metaData ) );
+  }
+
+  metaData = Connection::GetMetaData ( executeBaton->mInfo,
+                                       executeBaton->numCols,
+                                       executeBaton->extendedMetaData );
+
+  // checkinQuery () keeps mInfo as the layout of an entry without one
+  if ( entry && ( !entry->mInfo || entry->mInfo == executeBaton->mInfo ) )
+  {
+    entry->metaData.Reset ( metaData.As<v8::Array> () );
+    entry->metaDataValid = true;
+  }
+
+  return scope.Escape ( metaData );
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Method to populate Rows Array
+
+   PARAMETERS:
+     eBaton struct
+     colNames    - column name strings to be used as property keys for
+                   OBJECT rows; built here if empty
+     rowTemplate - template of the OBJECT rows, see GetRowTemplate; built
+                   here if empty
+
+   RETURNS:
+     Rows Handle
+
+   NOTES:
+     The same column name handles are used for every row, so each column
+     name is converted from UTF-8 only once per call (or once per ResultSet
+     when the caller passes its cached names).
+     OBJECT rows are instantiated from a template which already has all the
+     column properties, so every row gets the same hidden class with fast
+     properties instead of growing one property at a time.
+*/
+v8::Local<v8::Value> Connection::GetRows ( eBaton* executeBaton,
+                                           Local<Array> colNames,
+                                           Local<ObjectTemplate> rowTemplate )
+{
+  Nan::EscapableHandleScope scope;
+  Local<Array> rowsArray;
+  Local<Value> val;
+  std::vector< Local<Value> > keys;
+  std::vector<ColumnBatch> batch;
+
+  Connection::BeginBatch ( executeBaton, batch );
+
+  switch(executeBaton->outFormat)
+  {
+    case NJS_ROWS_ARRAY :
+      rowsArray = Nan::New<v8::Array>(executeBaton->rowsFetched);
+      for(unsigned int i = 0; i < executeBaton->rowsFetched; i++)
+      {
+        Local<Array> row = Nan::New<v8::Array>(executeBaton->numCols);
+        for(unsigned int j = 0; j < executeBaton->numCols; j++)
+        {
+          val = Connection::GetBatchValue ( executeBaton, batch, j, i );
+          if ( executeBaton->error.empty ())
+          {
+            Nan::Set(row, j, val);
+          }
+          else
+          {
+            goto exitGetRows;
+          }
+        }
+        Nan::Set(rowsArray, i, row);
+      }
+      break;
+    case NJS_ROWS_OBJECT :
+      if ( colNames.IsEmpty () )
+      {
+        colNames = Connection::GetColumnNames ( executeBaton->mInfo,
+                                                executeBaton->numCols );
+      }
+      if ( rowTemplate.IsEmpty () )
+      {
+        rowTemplate = Connection::GetRowTemplate ( executeBaton->mInfo,
+                                                   executeBaton->numCols,
+                                                   colNames );
+      }
+      keys.resize ( executeBaton->numCols );
+      for ( unsigned int j = 0; j < executeBaton->numCols; j++ )
+      {
+        keys[j] = Nan::Get ( colNames, j ).ToLocalChecked ();
+      }
+
+      rowsArray = Nan::New<v8::Array>(executeBaton->rowsFetched);
+      for(unsigned int i =0 ; i < executeBaton->rowsFetched; i++)
+      {
+        Local<Object> row = rowTemplate.IsEmpty () ?
+                         Nan::New<v8::Object>() :
+                         Nan::NewInstance ( rowTemplate ).ToLocalChecked ();
+
+        for(unsigned int j = 0; j < executeBaton->numCols; j++)
+        {
+          val = Connection::GetBatchValue ( executeBaton, batch, j, i );
+          if ( executeBaton->error.empty () )
+          {
+            Nan::Set(row, keys[j], val );
+          }
+          else
+          {
+            goto exitGetRows;
+          }
+        }
+        Nan::Set(rowsArray, i, row);
+      }
+      break;
+    case NJS_ROWS_COLUMNAR :
+      if ( colNames.IsEmpty () )
+      {
+        colNames = Connection::GetColumnNames ( executeBaton->mInfo,
+                                                executeBaton->numCols );
+      }
+      rowsArray = Connection::GetColumns ( executeBaton, colNames, batch );
+      break;
+    default :
+      executeBaton->error = NJSMessages::getErrorMsg(errInvalidPropertyValue,
+                                                     "outFormat");
+      goto exitGetRows;
+      break;
+  }
+  exitGetRows:
+  return scope.Escape(rowsArray);
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Method to create an array of column name strings
+
+   PARAMETERS:
+     mInfo   - an array of structs representing column info
+     numCols - number of columns
+
+   RETURNS:
+     Array of column name strings, indexed by column position
+*/
+v8::Local<v8::Array> Connection::GetColumnNames ( const MetaInfo    *mInfo,
+                                                  const unsigned int numCols )
+{
+  Nan::EscapableHandleScope scope;
+  Local<Array> colNames = Nan::New<v8::Array>( numCols );
+
+  for ( unsigned int col = 0; col < numCols; col++ )
+  {
+    Nan::Set ( colNames, col,
+               Nan::New<v8::String>( mInfo[col].name ).ToLocalChecked() );
+  }
+
+  return scope.Escape ( colNames );
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Method to create the template of the OBJECT rows of a query
+
+   PARAMETERS:
+     mInfo    - an array of structs representing column info
+     numCols  - number of columns
+     colNames - array of column name strings, see GetColumnNames
+
+   RETURNS:
+     Template with one null property per column, in column order; empty
+     if a column name is an array index, which would not be a named
+     property of the rows
+*/
+v8::Local<v8::ObjectTemplate> Connection::GetRowTemplate (
+                                              const MetaInfo    *mInfo,
+                                              const unsigned int numCols,
+                                              Local<Array>       colNames )
+{
+  Nan::EscapableHandleScope scope;
+  Local<ObjectTemplate> rowTemplate = Nan::New<v8::ObjectTemplate> ();
+  std::unordered_set<std::string> names;
+
+  for ( unsigned int col = 0; col < numCols; col++ )
+  {
+    const std::string &name = mInfo[col].name;
+
+    if ( !name.empty () &&
+         name.find_first_not_of ( "0123456789" ) == std::string::npos )
+    {
+      return scope.Escape ( Local<ObjectTemplate> () );
+    }
+
+    // With duplicate names the last column wins, as for plain objects
+    if ( names.insert ( name ).second )
+    {
+      Nan::SetTemplate ( rowTemplate,
+                         Nan::Get ( colNames, col ).ToLocalChecked ().
+                                                         As<v8::String> (),
+                         Nan::Null () );
+    }
   }
 
-  return scope.Escape(metaArray);
+  return scope.Escape ( rowTemplate );
 }
 
 /*****************************************************************************/
 /*
    DESCRIPTION
-     Method to populate Rows Array
+     Method to populate the rows of a query executed without a ResultSet
 
    PARAMETERS:
-     eBaton struct
+     executeBaton - eBaton struct
 
    RETURNS:
      Rows Handle
+
+   NOTES:
+     The column names and the template of the OBJECT rows are kept in the
+     query cache entry along with the layout, so the executes of the same
+     query share the hidden class of their rows.
 */
-v8::Local<v8::Value> Connection::GetRows (eBaton* executeBaton)
+v8::Local<v8::Value> Connection::GetQueryRows ( eBaton* executeBaton )
 {
   Nan::EscapableHandleScope scope;
-  Local<Array> rowsArray;
-  Local<Value> val;
+  QueryCacheEntry      *entry = executeBaton->cacheEntry;
+  Local<Array>          colNames;
+  Local<ObjectTemplate> rowTemplate;
 
-  switch(executeBaton->outFormat)
+  if ( !entry || executeBaton->outFormat != NJS_ROWS_OBJECT )
   {
-    case NJS_ROWS_ARRAY :
-      rowsArray = Nan::New<v8::Array>(executeBaton->rowsFetched);
-      for(unsigned int i = 0; i < executeBaton->rowsFetched; i++)
+    return scope.Escape ( Connection::GetRows ( executeBaton ) );
+  }
+
+  if ( entry->rowShapeValid && entry->mInfo &&
+       entry->mInfo == executeBaton->mInfo )
+  {
+    colNames = Nan::New<v8::Array> ( entry->colNames );
+    if ( !entry->rowTemplate.IsEmpty () )
+    {
+      rowTemplate = Nan::New<v8::ObjectTemplate> ( entry->rowTemplate );
+    }
+  }
+  else
+  {
+    colNames    = Connection::GetColumnNames ( executeBaton->mInfo,
+                                               executeBaton->numCols );
+    rowTemplate = Connection::GetRowTemplate ( executeBaton->mInfo,
+                                               executeBaton->numCols,
+                                               colNames );
+
+    // checkinQuery () keeps mInfo as the layout of an entry without one
+    if ( !entry->mInfo || entry->mInfo == executeBaton->mInfo )
+    {
+      entry->colNames.Reset ( colNames );
+      entry->rowTemplate.Reset ( rowTemplate );
+      entry->rowShapeValid = true;
+    }
+  }
+
+  return scope.Escape ( Connection::GetRows ( executeBaton, colNames,
+                                              rowTemplate ) );
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Method to populate the columns of the COLUMNAR outFormat
+
+   PARAMETERS:
+     executeBaton - eBaton struct
+     colNames     - array of column name strings
+     batch        - state of the columns for this batch, see BeginBatch
+
+   RETURNS:
+     Array with one object per column, holding the column name, the values
+     of the column and a null bitmap
+
+   NOTES:
+     NUMBER and DATE columns are returned as a Float64Array (DATEs as
+     milliseconds since 1970-01-01 UTC) built straight from the define
+     buffers, without creating a JS value per cell.  If the define buffer
+     is not reused for another fetch, it is handed over to the Float64Array
+     instead of being copied.  Other types are returned as an array of the
+     values that ARRAY or OBJECT rows would contain.
+     In the nulls Buffer, bit (row % 8) of byte (row / 8) is set when the
+     value of that row is NULL; NULL numbers and dates are also set to NaN.
+*/
+v8::Local<v8::Array> Connection::GetColumns ( eBaton       *executeBaton,
+                                              Local<Array> colNames,
+                                        std::vector<ColumnBatch> &batch )
+{
+  Nan::EscapableHandleScope scope;
+  unsigned int numRows   = executeBaton->rowsFetched;
+  unsigned int nullsSize = ( numRows + 7 ) / 8;
+  Local<Array>  columns  = Nan::New<v8::Array>( executeBaton->numCols );
+  Local<String> nameKey   = Nan::New<v8::String>("name").ToLocalChecked();
+  Local<String> valuesKey = Nan::New<v8::String>("values").ToLocalChecked();
+  Local<String> nullsKey  = Nan::New<v8::String>("nulls").ToLocalChecked();
+
+  for ( unsigned int col = 0; col < executeBaton->numCols; col++ )
+  {
+    Define        *define  = &(executeBaton->defines[col]);
+    Local<Object> column   = Nan::New<v8::Object>();
+    Local<Object> nulls    = Nan::NewBuffer( nullsSize ).ToLocalChecked();
+    char          *nullBits = node::Buffer::Data( nulls );
+    Local<Value>  values;
+
+    memset ( nullBits, 0, nullsSize );
+
+    if ( define->fetchType == dpi::DpiDouble ||
+         define->fetchType == dpi::DpiTimestampLTZ )
+    {
+      void   *src = define->buf;
+      double *dbl = NULL;
+
+#if NODE_MODULE_VERSION >= NODE_4_0_MODULE_VERSION
+      Local<ArrayBuffer> arrBuf;
+
+      if ( define->ownsBuf && numRows )
       {
-        Local<Array> row = Nan::New<v8::Array>(executeBaton->numCols);
-        for(unsigned int j = 0; j < executeBaton->numCols; j++)
+        // The fetch buffer is not used again, hand it over to V8, which
+        // releases it with free()
+        Local<Object> buf = Nan::NewBuffer ( (char *)define->buf,
+                                     numRows * sizeof ( double ) )
+                                     .ToLocalChecked();
+        define->buf     = NULL;
+        define->ownsBuf = false;
+        arrBuf = buf.As<Uint8Array>()->Buffer();
+        dbl    = (double *)node::Buffer::Data( buf );
+      }
+      else
+      {
+        arrBuf = ArrayBuffer::New ( Isolate::GetCurrent(),
+                                    numRows * sizeof ( double ) );
+        dbl    = (double *)arrBuf->GetContents().Data();
+      }
+#else
+      Local<Array> arr = Nan::New<v8::Array>( numRows );
+
+      dbl = (double *)malloc ( ( numRows ? numRows : 1 ) * sizeof (double) );
+      if ( !dbl )
+      {
+        executeBaton->error = NJSMessages::getErrorMsg(
+                                               errInsufficientMemory );
+        goto exitGetColumns;
+      }
+#endif
+
+      for ( unsigned int row = 0; row < numRows; row++ )
+      {
+        if ( define->ind[row] == -1 )
         {
-          val = Connection::GetValue ( executeBaton, true, j, i );
-          if ( executeBaton->error.empty ())
-          {
-            Nan::Set(row, j, val);
-          }
-          else
-          {
-            goto exitGetRows;
-          }
+          nullBits[row / 8] |= (char) ( 1 << ( row % 8 ) );
+          dbl[row] = std::numeric_limits<double>::quiet_NaN();
+        }
+        else if ( define->fetchType == dpi::DpiTimestampLTZ )
+        {
+          dbl[row] = (double) ((long double *)src)[row];
+        }
+        else if ( dbl != src )
+        {
+          dbl[row] = ((double *)src)[row];
         }
-        Nan::Set(rowsArray, i, row);
       }
-      break;
-    case NJS_ROWS_OBJECT :
-      rowsArray = Nan::New<v8::Array>(executeBaton->rowsFetched);
-      for(unsigned int i =0 ; i < executeBaton->rowsFetched; i++)
+
+#if NODE_MODULE_VERSION >= NODE_4_0_MODULE_VERSION
+      values = Float64Array::New ( arrBuf, 0, numRows );
+#else
+      for ( unsigned int row = 0; row < numRows; row++ )
       {
-        Local<Object> row = Nan::New<v8::Object>();
+        Nan::Set ( arr, row, Nan::New<v8::Number>( dbl[row] ) );
+      }
+      free ( dbl );
+      values = arr;
+#endif
+    }
+    else
+    {
+      Local<Array> arr = Nan::New<v8::Array>( numRows );
+      Local<Value> val;
 
-        for(unsigned int j = 0; j < executeBaton->numCols; j++)
+      for ( unsigned int row = 0; row < numRows; row++ )
+      {
+        val = Connection::GetBatchValue ( executeBaton, batch, col, row );
+        if ( !executeBaton->error.empty () )
         {
-          val = Connection::GetValue ( executeBaton, true, j, i );
-          if ( executeBaton->error.empty () )
-          {
-            Nan::Set(row,
-          Nan::New<v8::String>(executeBaton->mInfo[j].name).ToLocalChecked(),
-                     val );
-          }
-          else
-          {
-            goto exitGetRows;
-          }
+          goto exitGetColumns;
         }
-        Nan::Set(rowsArray, i, row);
+        if ( val->IsNull () )
+        {
+          nullBits[row / 8] |= (char) ( 1 << ( row % 8 ) );
+        }
+        Nan::Set ( arr, row, val );
       }
-      break;
-    default :
-      executeBaton->error = NJSMessages::getErrorMsg(errInvalidPropertyValue,
-                                                     "outFormat");
-      goto exitGetRows;
-      break;
+      values = arr;
+    }
+
+    Nan::Set ( column, nameKey, Nan::Get ( colNames, col ).ToLocalChecked() );
+    Nan::Set ( column, valuesKey, values );
+    Nan::Set ( column, nullsKey, nulls );
+    Nan::Set ( columns, col, column );
   }
-  exitGetRows:
-  return scope.Escape(rowsArray);
+
+exitGetColumns:
+  return scope.Escape ( columns );
 }
 
 /*****************************************************************************/
@@ -3152,14 +5082,17 @@ Local<Value> Connection::GetValue ( eBaton *executeBaton,
       auto ociObj = *(void**)val;
       void* ociObjNullStruct = ((void**)define->ind)[row];
       value = define->udt->ociToJs(ociObj, ociObjNullStruct, executeBaton->outFormat);
-    } else
+    } else if (define->lobInline)
+      value = Connection::GetValueInlineLob ( define, row );
+    else
       value = Connection::GetValueCommon(
                              executeBaton,
                              define->ind[row],
                              define->fetchType,
                              (define->fetchType == DpiTimestampLTZ ) ?
                                (void *) &dblArr[row] : val,
-                             define->len[row] );
+                             define->len[row],
+                             define->ascii );
     return scope.Escape( value );
   }
   else
@@ -3168,7 +5101,23 @@ Local<Value> Connection::GetValue ( eBaton *executeBaton,
     Bind    *bind     = executeBaton->binds[col];
     ExtBind *extBind  = executeBaton->extBinds[col];
 
-    if(executeBaton->stmtIsReturning)
+    if ( bind->iterRows )
+    {
+      // executeMany with RETURNING INTO clause, an array per iteration
+      Local<Array> iterValues = Nan::New<v8::Array> (
+                                             executeBaton->numIterations );
+
+      for ( unsigned int iter = 0; iter < executeBaton->numIterations;
+            iter++ )
+      {
+        Nan::Set ( iterValues, iter,
+                   Connection::GetArrayValue ( executeBaton, bind,
+                        bind->iterRows[iter],
+                        (unsigned long) iter * bind->maxArraySize ) );
+      }
+      return scope.Escape ( iterValues );
+    }
+    else if(executeBaton->stmtIsReturning)
     {
       // SQL statement with RETURNING INTO clause, will return an array
       Local<Value> value = Connection::GetArrayValue (
@@ -3199,15 +5148,152 @@ Local<Value> Connection::GetValue ( eBaton *executeBaton,
     }
     else
     {
+      bool ascii = ( bind->type == DpiVarChar && bind->ind[row] != -1 &&
+                     Connection::IsAscii ( (char *) bind->value,
+                                           bind->len[row] ) );
+
       return scope.Escape ( Connection::GetValueCommon (
                                         executeBaton,
                                         bind->ind[row],
                                         bind->type,
                                         (bind->type == DpiTimestampLTZ ) ?
                                            bind->extvalue : bind->value,
-                                        bind->len[row] ));
+                                        bind->len[row],
+                                        ascii ));
+    }
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Prepares the conversion of a batch of fetched rows.
+
+   PARAMETERS:
+     executeBaton - eBaton struct
+     batch        - state of the columns, left empty if there is none
+
+   NOTES:
+     The define buffer of a RAW column that is not fetched into again is
+     handed over to one Buffer, and the values of the column are created as
+     slices of it instead of copies.  As any slice keeps the whole buffer,
+     the values are still copied if they fill less than half of it.
+     Columns fetched with fetchInfo dedup get a dictionary.
+*/
+void Connection::BeginBatch ( eBaton                   *executeBaton,
+                              std::vector<ColumnBatch> &batch )
+{
+  for ( unsigned int col = 0; col < executeBaton->numCols; col++ )
+  {
+    Define *define = &(executeBaton->defines[col]);
+
+    if ( executeBaton->mInfo[col].dedup ||
+         ( define->fetchType == dpi::DpiRaw && define->ownsBuf ) )
+    {
+      batch.resize ( executeBaton->numCols );
+      break;
+    }
+  }
+
+#if NODE_MODULE_VERSION >= NODE_4_0_MODULE_VERSION
+  for ( unsigned int col = 0; col < batch.size (); col++ )
+  {
+    Define *define  = &(executeBaton->defines[col]);
+    size_t  bufSize = 0;
+    size_t  used    = 0;
+
+    if ( define->fetchType != dpi::DpiRaw || !define->ownsBuf ||
+         !executeBaton->rowsFetched )
+    {
+      continue;
     }
+
+    bufSize = (size_t)define->maxSize * executeBaton->rowsFetched;
+    for ( unsigned int row = 0; row < executeBaton->rowsFetched; row++ )
+    {
+      if ( define->ind[row] != -1 )
+      {
+        used += define->len[row];
+      }
+    }
+
+    // Copy short values rather than keep the whole buffer for them
+    if ( used >= bufSize / 2 )
+    {
+      // V8 releases the buffer with free() when no slice is left
+      batch[col].rawBuf = Nan::NewBuffer ( (char *)define->buf, bufSize )
+                                   .ToLocalChecked();
+      define->buf     = NULL;
+      define->ownsBuf = false;
+    }
+  }
+#endif
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Method to create handle from a define value of a batch of rows
+
+   PARAMETERS:
+     executeBaton - eBaton struct
+     batch        - state of the columns for this batch, see BeginBatch
+     col          - column index in define array
+     row          - row index in define->buf
+
+   RETURNS:
+     Handle
+
+   NOTES:
+     Columns fetched with fetchInfo dedup share one String per distinct
+     value.  This has no HandleScope of its own: the Strings kept in the
+     dictionary must live in the scope of the caller, which converts the
+     whole batch.
+*/
+Local<Value> Connection::GetBatchValue ( eBaton                   *executeBaton,
+                                         std::vector<ColumnBatch> &batch,
+                                         unsigned int             col,
+                                         unsigned int             row )
+{
+  Define        *define = &(executeBaton->defines[col]);
+  Local<String> *value;
+  char          *str;
+
+  if ( batch.empty () )
+  {
+    return Connection::GetValue ( executeBaton, true, col, row );
+  }
+
+#if NODE_MODULE_VERSION >= NODE_4_0_MODULE_VERSION
+  if ( !batch[col].rawBuf.IsEmpty () && define->ind[row] != -1 )
+  {
+    return node::Buffer::New ( Isolate::GetCurrent (),
+                               batch[col].rawBuf.As<Uint8Array>()->Buffer(),
+                               row * define->maxSize,
+                               define->len[row] ).ToLocalChecked();
+  }
+#endif
+
+  if ( !executeBaton->mInfo[col].dedup ||
+       define->fetchType != dpi::DpiVarChar || define->ind[row] == -1 )
+  {
+    return Connection::GetValue ( executeBaton, true, col, row );
   }
+
+  str   = (char *)define->buf + row * define->maxSize;
+  value = batch[col].dict.lookup ( str, define->len[row] );
+  if ( !value )
+  {
+    // Too many distinct values, the rest are created one by one
+    return Connection::NewString ( str, define->len[row], define->ascii );
+  }
+
+  if ( value->IsEmpty () )
+  {
+    *value = Connection::NewString ( str, define->len[row], define->ascii );
+  }
+
+  return *value;
 }
 
 /*****************************************************************************/
@@ -3296,6 +5382,48 @@ Local<Value> Connection::GetValueLob ( eBaton *executeBaton,
   return scope.Escape(value);
 }
 
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Method to create handle for LOB columns fetched as String or Buffer
+
+   PARAMETERS:
+     define - struct define, see ReadInlineLobs
+     row    - row index
+
+   RETURNS:
+     Handle
+*/
+Local<Value> Connection::GetValueInlineLob ( Define *define, unsigned int row )
+{
+  Nan::EscapableHandleScope scope;
+  size_t       start = row ? define->lobEnd[row - 1] : 0;
+  size_t       len   = define->lobEnd[row] - start;
+  const char   *data = len ? &define->lobData[start] : "";
+  Local<Value> value;
+
+  if ( define->ind[row] == -1 )
+  {
+    return Nan::Null();
+  }
+
+  if ( define->fetchType == dpi::DpiBlob )
+  {
+    value = Nan::CopyBuffer ( data, (uint32_t) len ).ToLocalChecked ();
+  }
+  else if ( Connection::IsAscii ( data, len ) )
+  {
+    value = Nan::NewOneByteString ( (const uint8_t *) data,
+                                    (int) len ).ToLocalChecked ();
+  }
+  else
+  {
+    value = Nan::New<v8::String> ( data, (int) len ).ToLocalChecked ();
+  }
+
+  return scope.Escape ( value );
+}
+
 /*****************************************************************************/
 /*
    DESCRIPTION
@@ -3305,7 +5433,8 @@ Local<Value> Connection::GetValueLob ( eBaton *executeBaton,
      ind  - to validate the data,
      type - data type of the value,
      val  - value,
-     len  - length of the value
+     len  - length of the value,
+     ascii - true if a VARCHAR value is known to be 7-bit ASCII
 
    RETURNS:
      Handle
@@ -3313,7 +5442,8 @@ Local<Value> Connection::GetValueLob ( eBaton *executeBaton,
 Local<Value> Connection::GetValueCommon ( eBaton *executeBaton,
                                            short ind,
                                            unsigned short type,
-                                           void* val, DPI_BUFLEN_TYPE len )
+                                           void* val, DPI_BUFLEN_TYPE len,
+                                           bool ascii )
 {
   Nan::EscapableHandleScope scope;
   Local<Value> value;
@@ -3324,7 +5454,7 @@ Local<Value> Connection::GetValueCommon ( eBaton *executeBaton,
      switch(type)
      {
        case (dpi::DpiVarChar) :
-          value = Nan::New<v8::String>((char*)val, len).ToLocalChecked();
+          value = Connection::NewString ( (char*)val, len, ascii );
         break;
        case (dpi::DpiInteger) :
          value = Nan::New<v8::Integer>(*(int*)val);
@@ -3337,9 +5467,8 @@ Local<Value> Connection::GetValueCommon ( eBaton *executeBaton,
          value = date;
         break;
        case (dpi::DpiRaw) :
-         // TODO: We could use NewBuffer to save memory and CPU, but it
-         // gets the ownership of buffer to itself (behaviour changed in
-         // Nan 2.0)
+         // The buffer is reused, see BeginBatch for the values which are
+         // slices of a define buffer handed over to V8
          value = Nan::CopyBuffer((char*)val, len).ToLocalChecked();
          break;
         // The LOB types are hit only by the define code path
@@ -3375,13 +5504,15 @@ Local<Value> Connection::GetValueCommon ( eBaton *executeBaton,
     eBaton   - executeBaton structure
     bind     - bind structure
     count    - row count
+    offset   - first row in the bind buffers (executeMany iteration)
 
   Returns
     v8::Value  - this will be an array (even for 1 row, array or 1).
 */
 v8::Local<v8::Value> Connection::GetArrayValue ( eBaton *executeBaton,
                                                  Bind *binds,
-                                                 unsigned long count )
+                                                 unsigned long count,
+                                                 unsigned long offset )
 {
   Nan::EscapableHandleScope scope;
   Local<Date> date;
@@ -3394,8 +5525,10 @@ v8::Local<v8::Value> Connection::GetArrayValue ( eBaton *executeBaton,
 
   for ( index = 0 ; index < count ; index ++ )
   {
+    unsigned long slot = offset + index;
+
     if(
-        binds->ind[index] == -1 &&
+        binds->ind[slot] == -1 &&
         (
           (binds->type == dpi::DpiVarChar) ||
           (binds->type == dpi::DpiInteger) ||
@@ -3413,29 +5546,33 @@ v8::Local<v8::Value> Connection::GetArrayValue ( eBaton *executeBaton,
     switch ( binds->type )
     {
     case dpi::DpiVarChar:
+    {
+      char            *str = (char *)binds->value +
+                             (slot * binds->maxSize );
+      DPI_BUFLEN_TYPE  len = executeBaton->stmtIsReturning ?
+                               binds->len2[slot] : binds->len[slot];
+
       Nan::Set(arrVal, index,
-                    Nan::New<v8::String> ((char *)binds->value +
-                                        (index * binds->maxSize ),
-                                         executeBaton->stmtIsReturning ?
-                                       binds->len2[index] :
-                                       binds->len[index] ).ToLocalChecked());
-      break;
+               Connection::NewString ( str, len,
+                                       Connection::IsAscii ( str, len ) ));
+    }
+    break;
     case dpi::DpiInteger:
       Nan::Set(arrVal, index,
-                    Nan::New<v8::Integer> ( *((int *)binds->value + index )));
+                    Nan::New<v8::Integer> ( *((int *)binds->value + slot )));
       break;
     case dpi::DpiDouble:
       Nan::Set(arrVal, index,
-                    Nan::New<v8::Number> ( *((double *)binds->value + index )));
+                    Nan::New<v8::Number> ( *((double *)binds->value + slot )));
       break;
     case dpi::DpiTimestampLTZ:
         Nan::Set(arrVal, index,
-                      Nan::New<v8::Date> (*((long double *)binds->extvalue + index )).ToLocalChecked() );
+                      Nan::New<v8::Date> (*((long double *)binds->extvalue + slot )).ToLocalChecked() );
       break;
     case dpi::DpiClob:
     case dpi::DpiBlob:
     {
-      ProtoILob *protoILob = *((ProtoILob **)binds->value + index);
+      ProtoILob *protoILob = *((ProtoILob **)binds->value + slot);
       val = NewLob(executeBaton, protoILob);
       Nan::Set(arrVal, index, val);
       delete protoILob;
@@ -3653,14 +5790,15 @@ NAN_METHOD(Connection::Release)
 exitRelease:
   releaseBaton->req.data  = (void*) releaseBaton;
 
-  int status = uv_queue_work(uv_default_loop(), &releaseBaton->req,
-               Async_Release, (uv_after_work_cb)Async_AfterRelease);
-  // delete the Baton if uv_queue_work fails
+  int status = ThreadPool::queueWork(&releaseBaton->req,
+               Async_Release, (uv_after_work_cb)Async_AfterRelease,
+               connection);
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete releaseBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work", "Release" );
+                                              "queueWork", "Release" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
   info.GetReturnValue().SetUndefined();
@@ -3719,6 +5857,21 @@ void Connection::Async_AfterRelease(uv_work_t *req)
   else
     argv[0] = Nan::Undefined();
 
+  if ( releaseBaton->error.empty() )
+  {
+    releaseBaton->njsconn->clearQueryCache ();
+  }
+
+  /*
+   * Let the pool hand the connection slot to the next queued request. The
+   * pool is still referenced by jsParent_ at this point.
+   */
+  if ( releaseBaton->error.empty() && releaseBaton->njsconn->njspool_ )
+  {
+    releaseBaton->njsconn->njspool_->connectionReleased ();
+    releaseBaton->njsconn->njspool_ = NULL;
+  }
+
   /*
    * When we release the connection, we have to clear the reference of
    * its parent.
@@ -3768,14 +5921,15 @@ NAN_METHOD(Connection::Commit)
 exitCommit:
   commitBaton->req.data  = (void*) commitBaton;
 
-  int status = uv_queue_work(uv_default_loop(), &commitBaton->req,
-               Async_Commit, (uv_after_work_cb)Async_AfterCommit);
-  // delete the Baton if uv_queue_work fails
+  int status = ThreadPool::queueWork(&commitBaton->req,
+               Async_Commit, (uv_after_work_cb)Async_AfterCommit,
+               connection);
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete commitBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work", "Commit" );
+                                              "queueWork", "Commit" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
 
@@ -3875,14 +6029,15 @@ NAN_METHOD(Connection::Rollback)
   rollbackBaton->dpiconn   = connection->dpiconn_;
   exitRollback:
   rollbackBaton->req.data  = (void*) rollbackBaton;
-  int status = uv_queue_work(uv_default_loop(), &rollbackBaton->req,
-               Async_Rollback, (uv_after_work_cb)Async_AfterRollback);
-  // delete the Baton if uv_queue_work fails
+  int status = ThreadPool::queueWork(&rollbackBaton->req,
+               Async_Rollback, (uv_after_work_cb)Async_AfterRollback,
+               connection);
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete rollbackBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work", "Rollback" );
+                                              "queueWork", "Rollback" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
   info.GetReturnValue().SetUndefined();
@@ -3983,14 +6138,18 @@ NAN_METHOD(Connection::Break)
   exitBreak:
   breakBaton->req.data  = (void*) breakBaton;
 
-  int status = uv_queue_work(uv_default_loop(), &breakBaton->req,
+  /*
+   * Not on the worker threads: break must not wait behind the call it is
+   * meant to interrupt.
+   */
+  int status = ThreadPool::queueInterrupt(&breakBaton->req,
                Async_Break, (uv_after_work_cb)Async_AfterBreak);
-  // delete the Baton if uv_queue_work fails
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete breakBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work", "Break" );
+                                              "queueWork", "Break" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
 
@@ -4113,11 +6272,18 @@ void Connection::UpdateDateValue ( eBaton * ebaton, unsigned int index )
   {
     bind->dttmarr = ebaton->dpienv->getDateTimeArray(
                                         ebaton->dpistmt->getError());
-    bind->value = bind->dttmarr->init(1);
+    // One descriptor per iteration, more than one only for executeMany
+    bind->value = bind->dttmarr->init(ebaton->numIterations);
     if (!bind->isOut)
     {
-      bind->dttmarr->setDateTime( 0,
-                                  (*(long double *)bind->extvalue));
+      for (unsigned int row = 0; row < ebaton->numIterations; row++)
+      {
+        if (bind->ind[row] != -1)
+        {
+          bind->dttmarr->setDateTime( row,
+                                  ((long double *)bind->extvalue)[row]);
+        }
+      }
     }
   }
 }
@@ -4169,7 +6335,8 @@ void Connection::cbDynBufferAllocate ( void *ctx, bool dmlReturning,
   {
     if ( !bind->ind )
     {
-      bind->ind = (short *)malloc ( (size_t)nRows * sizeof ( short ) ) ;
+      bind->ind = (short *)executeBaton->arena.alloc (
+                                         (size_t)nRows * sizeof ( short ) ) ;
       if( !bind->ind )
       {
         executeBaton->error = NJSMessages::getErrorMsg(
@@ -4187,7 +6354,8 @@ void Connection::cbDynBufferAllocate ( void *ctx, bool dmlReturning,
     }
     else
     {
-      bind->len2 = ( unsigned int *)malloc ( nRows * sizeof ( unsigned int ) );
+      bind->len2 = ( unsigned int *)executeBaton->arena.alloc (
+                                         nRows * sizeof ( unsigned int ) );
       if( !bind->len2 )
       {
         executeBaton->error = NJSMessages::getErrorMsg(
@@ -4200,7 +6368,7 @@ void Connection::cbDynBufferAllocate ( void *ctx, bool dmlReturning,
   {
     if ( !bind->len )
     {
-      bind->len = (DPI_BUFLEN_TYPE *)malloc ( nRows *
+      bind->len = (DPI_BUFLEN_TYPE *)executeBaton->arena.alloc ( nRows *
                                               sizeof ( DPI_BUFLEN_TYPE ) );
       if ( !bind->len )
       {
@@ -4223,7 +6391,8 @@ void Connection::cbDynBufferAllocate ( void *ctx, bool dmlReturning,
     }
     else
     {
-      bind->value = (char *)malloc( (size_t)( bind->maxSize + 1) * nRows );
+      bind->value = (char *)executeBaton->arena.alloc (
+                                    (size_t)( bind->maxSize + 1) * nRows );
       if( !bind->value )
       {
         executeBaton->error = NJSMessages::getErrorMsg(
@@ -4250,7 +6419,8 @@ void Connection::cbDynBufferAllocate ( void *ctx, bool dmlReturning,
     }
     else
     {
-      bind->value = ( int *) malloc ( sizeof (int) * nRows ) ;
+      bind->value = ( int *) executeBaton->arena.alloc (
+                                                  sizeof (int) * nRows ) ;
       if( !bind->value )
       {
         executeBaton->error = NJSMessages::getErrorMsg(
@@ -4272,7 +6442,8 @@ void Connection::cbDynBufferAllocate ( void *ctx, bool dmlReturning,
     }
     else
     {
-      bind->value = ( unsigned int *)malloc ( sizeof ( unsigned int ) * nRows );
+      bind->value = ( unsigned int *)executeBaton->arena.alloc (
+                                         sizeof ( unsigned int ) * nRows );
       if( !bind->value )
       {
         executeBaton->error = NJSMessages::getErrorMsg(
@@ -4294,7 +6465,8 @@ void Connection::cbDynBufferAllocate ( void *ctx, bool dmlReturning,
     }
     else
     {
-      bind->value = ( double *)malloc ( sizeof ( double ) * nRows );
+      bind->value = ( double *)executeBaton->arena.alloc (
+                                               sizeof ( double ) * nRows );
       if( !bind->value )
       {
         executeBaton->error = NJSMessages::getErrorMsg(
@@ -4326,7 +6498,8 @@ void Connection::cbDynBufferAllocate ( void *ctx, bool dmlReturning,
     }
     else
     {
-      bind->value = (void *)malloc(sizeof(Descriptor *) * nRows);
+      bind->value = (void *)executeBaton->arena.alloc (
+                                             sizeof(Descriptor *) * nRows);
       if( !bind->value )
       {
         executeBaton->error = NJSMessages::getErrorMsg(
@@ -4356,8 +6529,8 @@ void Connection::cbDynBufferAllocate ( void *ctx, bool dmlReturning,
       }
       else
       {
-        bind->extvalue = (long double *) malloc ( sizeof ( long double ) *
-                                                  nRows );
+        bind->extvalue = (long double *) executeBaton->arena.alloc (
+                                          sizeof ( long double ) * nRows );
         if( !bind->extvalue )
         {
           executeBaton->error = NJSMessages::getErrorMsg(
@@ -4389,7 +6562,8 @@ void Connection::cbDynBufferAllocate ( void *ctx, bool dmlReturning,
     }
     else
     {
-      bind->value = (void *)malloc ( (size_t)(bind->maxSize) * nRows ) ;
+      bind->value = (void *)executeBaton->arena.alloc (
+                                         (size_t)(bind->maxSize) * nRows ) ;
       *(bind->len) = (unsigned int)bind->maxSize;
     }
     break;
@@ -4423,6 +6597,7 @@ exitcbDynBufferAllocate:
     NOTE:
       1. DATE/TIMESTAMP not supported
       2. using bind->len2 for DML returning (not bind->len)
+      3. executeMany binds (bind->iterRows) are allocated before execution
 */
 
 int Connection::cbDynBufferGet ( void *ctx, DPI_SZ_TYPE nRows,
@@ -4436,7 +6611,59 @@ int Connection::cbDynBufferGet ( void *ctx, DPI_SZ_TYPE nRows,
 
   int ret = 0;
 
-  if (*piecep == OCI_ONE_PIECE )
+  if ( bind->iterRows )
+  {
+    // executeMany: buffers were sized up front, maxArraySize rows for each
+    // iteration, rows of iteration iter start at slot iter * maxArraySize
+    size_t slot = (size_t) iter * bind->maxArraySize + index;
+
+    if ( index == 0 )
+    {
+      bind->iterRows[iter] = (unsigned int) nRows;
+    }
+
+    if ( *piecep != OCI_ONE_PIECE )
+    {
+      // String longer than maxSize, reported as ORA-24343
+      *piecep = OCI_LAST_PIECE;
+      ret = -1;
+    }
+    else if ( (unsigned long) nRows > bind->maxArraySize ||
+              index >= bind->maxArraySize )
+    {
+      executeBaton->error = NJSMessages::getErrorMsg (
+                                               errTooManyRowsReturned );
+      *piecep = OCI_LAST_PIECE;
+      ret = -1;
+    }
+    else
+    {
+      bind->ind[slot] = -1;
+
+      switch ( bind->type )
+      {
+      case dpi::DpiVarChar:
+        bind->len2[slot] = (unsigned int)bind->maxSize;
+        *bufpp  = (void *)&(((char *)bind->value)[bind->maxSize * slot]);
+        *piecep = OCI_FIRST_PIECE;
+        break;
+
+      case dpi::DpiDouble:
+        bind->len2[slot] = sizeof ( double ) ;
+        *bufpp = (void *)&(((double *)bind->value)[slot]);
+        break;
+
+      case dpi::DpiTimestampLTZ:
+        bind->len2[slot] = sizeof ( void * );
+        *bufpp = (void *)((void **)bind->value)[slot];
+        break;
+      }
+
+      *alenpp = &(bind->len2[slot]);
+      *indpp  = &(bind->ind[slot]);
+    }
+  }
+  else if (*piecep == OCI_ONE_PIECE )
   {
     *piecep = OCI_ONE_PIECE ;  /* Use ONE PIECE by default */
 
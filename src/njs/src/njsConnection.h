@@ -56,9 +56,12 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include "dpi.h"
 #include "njsUtils.h"
 #include "njsOracle.h"
+#include "njsArena.h"
+#include "njsStringDict.h"
 
 using namespace v8;
 using namespace node;
@@ -88,13 +91,16 @@ typedef struct Bind
   unsigned int        curArraySize;
   unsigned int        rowsReturned;     /* number rows returned for
                                            the bind (DML RETURNING) */
+  unsigned int        *iterRows;        /* executeMany DML RETURNING: rows
+                                           returned by each iteration, up to
+                                           maxArraySize */
   dpi::DateTimeArray* dttmarr;
   std::shared_ptr<Udt> udt;
 
   Bind () : key(""), value(NULL), extvalue (NULL), len(NULL), len2(NULL),
             maxSize(0), type(0), ind(NULL), isOut(false), isInOut(false),
             isArray(false), maxArraySize(0), curArraySize(0),
-            rowsReturned(0), dttmarr ( NULL )
+            rowsReturned(0), iterRows(NULL), dttmarr ( NULL )
   {}
 }Bind;
 
@@ -112,9 +118,15 @@ typedef struct Define
   short              *ind;
   dpi::DateTimeArray *dttmarr;   // DPI Date time array of descriptor
   shared_ptr<Udt>    udt;
+  bool               ownsBuf;    // buf is from malloc(), not the arena
+  bool               ascii;      // values of the last fetch are all ASCII
+  bool               lobInline;  // LOB column fetched as String or Buffer
+  std::vector<char>  lobData;    // LOB values of the last fetch, if inline
+  std::vector<size_t> lobEnd;    // end of the value of each row in lobData
 
   Define () :fetchType(0), maxSize(0), buf(NULL), extbuf(NULL),
-             len(0), ind(0), dttmarr(NULL)
+             len(0), ind(0), dttmarr(NULL), ownsBuf(false), ascii(false),
+             lobInline(false)
   {}
 } Define;
 
@@ -139,10 +151,11 @@ typedef struct MetaInfo
   short             precision;              // Precision
   signed   char     scale;                  // Scale, range starts from -127
   unsigned char     isNullable;             // Nullable
+  bool              dedup;                  // Share repeated string values
 
   MetaInfo ()
     : name(""), dbType(0), dpiFetchType(0), njsFetchType(NJS_DATATYPE_UNKNOWN),
-      byteSize(0), precision(0), scale(0), isNullable(false)
+      byteSize(0), precision(0), scale(0), isNullable(false), dedup(false)
   {}
 
 } MetaInfo;
@@ -169,16 +182,76 @@ typedef struct fetchInfo
 {
   std::string name;                     /* DB Column name or expression name */
   DataType    type;                   /* Fetch this column as specfieid type */
+  bool        dedup;              /* Share repeated string values in a fetch */
 
   // Constructor to initialize member variables.
   fetchInfo ()
-    : name (""), type ( NJS_DATATYPE_DEFAULT )
+    : name (""), type ( NJS_DATATYPE_DEFAULT ), dedup ( false )
   {
   }
 
 } FetchInfo;
 
 
+/**
+ * Layout of a query kept by the connection for the next execute of the
+ * same SQL with the same options: the column info, the defines and the
+ * define buffers, which are carved from the entry's arena.
+ **/
+typedef struct QueryCacheEntry
+{
+  MetaInfo          *mInfo;
+  Define            *defines;        // NULL until a successful execute
+  unsigned int      numCols;
+  bool              cacheable;      // false for DML, LOBs, large layouts
+  bool              inUse;          // lent to an execute
+  unsigned long     lastUse;
+  Arena             arena;          // define buffers
+  Nan::Persistent<Array> metaData;  // result.metaData built from mInfo
+  bool              metaDataValid;  // metaData matches mInfo
+  Nan::Persistent<Array> colNames;  // OBJECT rows keys and template
+  Nan::Persistent<ObjectTemplate> rowTemplate;
+  bool              rowShapeValid;  // colNames, rowTemplate match mInfo
+
+  QueryCacheEntry ()
+    : mInfo(NULL), defines(NULL), numCols(0), cacheable(true), inUse(false),
+      lastUse(0), metaDataValid(false), rowShapeValid(false)
+  {}
+
+  ~QueryCacheEntry ()
+  {
+    clear ();
+    metaData.Reset ();
+    colNames.Reset ();
+    rowTemplate.Reset ();
+  }
+
+  // May run in a worker thread: metaData is only marked stale
+  void clear ()
+  {
+    delete [] defines;
+    delete [] mInfo;
+    defines = NULL;
+    mInfo   = NULL;
+    numCols = 0;
+    metaDataValid = false;
+    rowShapeValid = false;
+    arena.reset ();
+  }
+} QueryCacheEntry;
+
+
+/**
+ * State of a column while one batch of fetched rows is converted, see
+ * Connection::BeginBatch
+ **/
+typedef struct ColumnBatch
+{
+  StringDict        dict;           // values of a fetchInfo dedup column
+  Local<Object>     rawBuf;         // RAW define buffer handed over to V8
+} ColumnBatch;
+
+
 /**
 * Baton for Asynchronous Connection methods
 **/
@@ -207,13 +280,23 @@ typedef struct eBaton
   Define                    *defines;
   unsigned int              fetchAsStringTypesCount;
   DataType                  *fetchAsStringTypes;  // Global by type settings
+  unsigned int              fetchAsBufferTypesCount;
+  DataType                  *fetchAsBufferTypes;
   unsigned int              fetchInfoCount;       // Conversion requested count
   FetchInfo                 *fetchInfo;           // Conversion meta data
   Nan::Persistent<Function> cb;
   RefCounter                counter;
   Nan::Persistent<Object>   jsConn;
   bool                      extendedMetaData;
+  bool                      fetchAhead;     // ResultSet background fetch
   MetaInfo                  *mInfo;
+  unsigned int              numIterations;  // # of bind rows (executeMany)
+  bool                      batchErrors;    // executeMany in batch errors mode
+  std::vector<dpi::BatchError> batchErrorInfo;
+  Arena                     arena;          // bind and define buffers
+  Arena                     *defineArena;   // define buffers, the ResultSet's
+                                            // arena for getRows()
+  QueryCacheEntry           *cacheEntry;    // cached layout of the query
 
   eBaton( unsigned int& count, Local<Function> callback,
            Local<Object> jsConnObj ) :
@@ -223,8 +306,11 @@ typedef struct eBaton
              numCols(0), dpistmt(NULL), st(DpiStmtUnknown),
              stmtIsReturning (false), numOutBinds(0), defines(NULL),
              fetchAsStringTypesCount (0), fetchAsStringTypes(NULL),
+             fetchAsBufferTypesCount (0), fetchAsBufferTypes(NULL),
              fetchInfoCount(0), fetchInfo(NULL), counter ( count ),
-             extendedMetaData(false), mInfo(NULL)
+             extendedMetaData(false), fetchAhead(false), mInfo(NULL),
+             numIterations(1),
+             batchErrors(false), defineArena(&arena), cacheEntry(NULL)
   {
     cb.Reset( callback );
     jsConn.Reset ( jsConnObj );
@@ -234,31 +320,17 @@ typedef struct eBaton
    {
      cb.Reset ();
      jsConn.Reset ();
+     // The cached layout stays with the connection
+     if ( cacheEntry && defines && defines == cacheEntry->defines )
+     {
+       defines = NULL;
+       mInfo   = NULL;
+     }
      if( !binds.empty() )
      {
+       // the bind buffers are released with the arena
        for( unsigned int index = 0 ;index < binds.size(); index++ )
        {
-         // do not free refcursor type.
-         if( binds[index]->value && binds[index]->type != DpiRSet )
-         {
-           free(binds[index]->value);
-         }
-         if ( binds[index]->extvalue )
-         {
-           free ( binds[index]->extvalue );
-         }
-         if ( binds[index]->ind )
-         {
-           free ( binds[index]->ind );
-         }
-         if ( binds[index]->len )
-         {
-           free ( binds[index]->len );
-         }
-         if ( binds[index]->len2 )
-         {
-           free ( binds[index]->len2 ) ;
-         }
          delete binds[index];
        }
      }
@@ -299,9 +371,10 @@ typedef struct eBaton
            }
          }
 
-         free(defines[i].buf);
-         free(defines[i].len);
-         free(defines[i].ind);
+         if ( defines[i].ownsBuf )
+         {
+           free(defines[i].buf);
+         }
        }
        delete [] defines;
      }
@@ -314,21 +387,60 @@ typedef struct eBaton
      {
        free (fetchAsStringTypes);
      }
+
+     if ( fetchAsBufferTypes )
+     {
+       free (fetchAsBufferTypes);
+     }
+
+     if ( cacheEntry )
+     {
+       // Nothing was cached, the buffers of this execute are not kept
+       if ( !cacheEntry->defines )
+       {
+         cacheEntry->arena.release ();
+       }
+       cacheEntry->inUse = false;
+     }
    }
 }eBaton;
 
 class Connection: public Nan::ObjectWrap
 {
 public:
-  void setConnection ( dpi::Conn*, Oracledb* oracledb, Local<Object> obj );
+  void setConnection ( dpi::Conn*, Oracledb* oracledb, Local<Object> obj,
+                       Pool* njspool = NULL );
   static Nan::Persistent<FunctionTemplate> connectionTemplate_s;
   static void Init (Handle<Object> target);
-  static Local<Value> GetRows (eBaton* executeBaton);
+  static Local<Value> GetRows ( eBaton* executeBaton,
+                                Local<Array> colNames = Local<Array>(),
+                   Local<ObjectTemplate> rowTemplate = Local<ObjectTemplate>() );
+  static Local<Array> GetColumnNames ( const MetaInfo*    mInfo,
+                                       const unsigned int numCols );
+  static Local<ObjectTemplate> GetRowTemplate ( const MetaInfo*    mInfo,
+                                                const unsigned int numCols,
+                                                Local<Array>       colNames );
+  static Local<Value> GetQueryRows ( eBaton* executeBaton );
+  static Local<Array> GetColumns ( eBaton* executeBaton,
+                                   Local<Array> colNames,
+                                   std::vector<ColumnBatch> &batch );
+  static void BeginBatch ( eBaton* executeBaton,
+                           std::vector<ColumnBatch> &batch );
+  static Local<Value> GetBatchValue ( eBaton* executeBaton,
+                                      std::vector<ColumnBatch> &batch,
+                                      unsigned int col,
+                                      unsigned int row );
   static Local<Value> GetMetaData ( const MetaInfo*    mInfo,
                                     const unsigned int numCols,
                                     const bool         extendedMetaData );
+  static Local<Value> GetQueryMetaData ( eBaton* executeBaton );
   static void DoDefines ( eBaton* executeBaton );
+  static void Redefine ( eBaton* executeBaton );
   static void DoFetch (eBaton* executeBaton);
+  static bool SameMetaData ( const MetaInfo*    mInfo,
+                             const MetaData*    mData,
+                             const unsigned int numCols,
+                             const bool         extendedMetaData );
   static void CopyMetaData ( MetaInfo*            mInfo,
                              eBaton*              executeBaton,
                              const                MetaData* meta,
@@ -354,6 +466,11 @@ private:
   static void Async_Execute (uv_work_t *req);
   static void Async_AfterExecute (uv_work_t *req);
 
+  // ExecuteMany Method on Connection class
+  static NAN_METHOD(ExecuteMany);
+  static void Async_ExecuteMany (uv_work_t *req);
+  static void Async_AfterExecuteMany (uv_work_t *req);
+
   // Release Method on Connection class
   static NAN_METHOD(Release);
   static void Async_Release(uv_work_t *req);
@@ -427,19 +544,38 @@ private:
   static void GetInBindParamsScalar(Local<Value> v8val, Bind *bind, eBaton *executeBaton);
   static void GetInBindParamsArray(Local<Array> v8vals, Bind *bind, eBaton *executeBaton);
   static void GetInBindParamsUdt(Local<Value> v8val, Bind *bind, eBaton *executeBaton);
+  static void GetBindsMany (Local<Array> bindRows, Local<Value> bindDefs,
+                            eBaton* executeBaton);
+  static void GetInBindParamsMany (const std::vector< Local<Object> > &rows,
+                                   Local<Value> key, Local<Value> bindDef,
+                                   Bind *bind, eBaton *executeBaton);
+  static void GetOutBindParamsMany (Local<Value> bindDef, Bind *bind,
+                                    eBaton *executeBaton);
+  static bool IsOutBindDef (Local<Value> bindDef);
   static bool AllocateBindArray(unsigned short dataType, Bind* bind, eBaton *executeBaton, size_t *arrayElementSize);
 
   static void GetOutBindParams (unsigned short dataType, Bind* bind,
                                 eBaton* executeBaton);
   static NJSErrorType Descr2Double ( Define* defines, unsigned int numCols,
-                                     unsigned int rowsFetched, bool getRS );
+                                     unsigned int rowsFetched, bool getRS,
+                                     Arena *arena );
   static void Descr2protoILob ( eBaton *executeBaton, unsigned int numCols,
                                 unsigned int rowsFetched );
+  static void ReadInlineLobs ( eBaton *executeBaton, unsigned int numCols,
+                               unsigned int rowsFetched );
+  static void FlagAsciiColumns ( Define* defines, unsigned int numCols,
+                                 unsigned int rowsFetched );
+  static bool IsAscii ( const char *str, size_t len );
+  // String from client character set data, one-byte if known to be ASCII
+  static v8::Local<v8::String> NewString ( const char *str,
+                                           DPI_BUFLEN_TYPE len,
+                                           bool ascii );
   static v8::Local<v8::Value> GetOutBinds (eBaton* executeBaton);
   static v8::Local<v8::Value> GetOutBindArray (eBaton* executeBaton);
   static v8::Local<v8::Value> GetOutBindObject (eBaton* executeBaton);
   static v8::Local<v8::Value> GetArrayValue (eBaton *executeBaton,
-                                              Bind *bind, unsigned long count);
+                                              Bind *bind, unsigned long count,
+                                              unsigned long offset = 0);
   // to convert DB value to v8::Value
   static v8::Local<v8::Value> GetValue (eBaton *executeBaton,
                                          bool isQuery,
@@ -449,7 +585,8 @@ private:
   static v8::Local<v8::Value> GetValueCommon (eBaton *executeBaton,
                                          short ind,
                                          unsigned short type,
-                                         void* val, DPI_BUFLEN_TYPE len);
+                                         void* val, DPI_BUFLEN_TYPE len,
+                                         bool ascii = false);
   // for refcursor
   static v8::Local<v8::Value> GetValueRefCursor ( eBaton  *executeBaton,
                                                   Bind    *bind,
@@ -457,6 +594,9 @@ private:
   // for lobs
   static v8::Local<v8::Value> GetValueLob (eBaton *executeBaton,
                                             Bind *bind);
+  // for LOB columns fetched as String or Buffer
+  static v8::Local<v8::Value> GetValueInlineLob ( Define *define,
+                                                  unsigned int row );
   static void UpdateDateValue ( eBaton *executeBaton, unsigned int index );
   static void v8Date2OraDate(v8::Local<v8::Value> val, Bind *bind);
   static ConnectionBusyStatus getConnectionBusyStatus ( Connection *conn );
@@ -486,6 +626,13 @@ private:
   static v8::Local<v8::Value> NewLob(eBaton* executeBaton,
                                       ProtoILob *protoILob);
 
+  // Lend/return the cached layout of a query to/from an execute
+  void checkoutQuery ( eBaton *executeBaton );
+  void checkinQuery ( eBaton *executeBaton );
+  void clearQueryCache ();
+  static std::string QueryCacheKey ( eBaton *executeBaton );
+  static bool QueryLayoutCacheable ( eBaton *executeBaton );
+
   static inline ValueType GetValueType ( v8::Local<v8::Value> v )
   {
     ValueType type = NJS_VALUETYPE_INVALID;
@@ -534,6 +681,12 @@ private:
   unsigned int              rsCount_;     // ResultSet operations counter
   unsigned int              dbCount_;     // Connection or DB operations counter
   Nan::Persistent<Object>   jsParent_;
+  Pool*                     njspool_;     // pool the connection came from
+
+  // Query layouts by SQL text and options, at most queryCacheSize_ entries
+  std::unordered_map<std::string, QueryCacheEntry*> queryCache_;
+  unsigned int              queryCacheSize_;
+  unsigned long             queryCacheUses_;  // clock for LRU eviction
 
 };
 
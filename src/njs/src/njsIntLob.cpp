@@ -51,6 +51,7 @@
 
 #include <stdlib.h>
 #include <iostream>
+#include <new>
 using namespace std;
 
 
@@ -64,6 +65,7 @@ using namespace std;
 
 
 #include "njsIntLob.h"
+#include "njsThreadPool.h"
 
 
                                         //peristent ILob class handle
@@ -89,7 +91,10 @@ Nan::Persistent<FunctionTemplate> ILob::iLobTemplate_s;
 ILob::ILob():
   lobLocator_(NULL), njsconn_(NULL), dpiconn_(NULL), svch_(NULL), errh_(NULL),
   isValid_(false), state_(NJS_INACTIVE), buf_(NULL), bufSize_(0), chunkSize_(0),
-  length_(0), offset_(1), amountRead_(0), type_(NJS_DATATYPE_UNKNOWN)
+  length_(0), offset_(1), amountRead_(0), aheadBuf_(NULL), aheadAmount_(0),
+  aheadStart_(0), aheadOffset_(0), aheadCount_(0), aheadActive_(false),
+  aheadReady_(false), releasePending_(false), pendingBaton_(NULL),
+  type_(NJS_DATATYPE_UNKNOWN)
 {
 
 }
@@ -142,6 +147,12 @@ void ILob::cleanup()
     delete [] buf_;
     buf_ = NULL;
   }
+  if (aheadBuf_)
+  {
+    delete [] aheadBuf_;
+    aheadBuf_ = NULL;
+  }
+  aheadReady_ = false;
 
   try
   {
@@ -354,6 +365,8 @@ NAN_METHOD(ILob::New)
   NOTES
     The cleanup() called by Release() only frees OCI error handle and Lob
     locator.  These calls acquire mutex on OCI environment handle very briefly.
+    While the next piece is read ahead, the cleanup is left to
+    Async_AfterReadAhead.
 */
 
 NAN_METHOD(ILob::Release)
@@ -371,6 +384,13 @@ NAN_METHOD(ILob::Release)
     return;
   }
 
+  if (iLob->aheadActive_)
+  {
+    iLob->releasePending_ = true;
+    info.GetReturnValue().SetUndefined();
+    return;
+  }
+
   /*
    * cleanup() will clear the reference of its parent jsConn.
    */
@@ -620,9 +640,9 @@ NAN_SETTER(ILob::SetPieceSize)
   string msg;
 
   NJS_CHECK_OBJECT_VALID(iLob);
-  NJS_SET_PROP_UINT(iLob->bufSize_, value, "pieceSize");
 
-  if (iLob->state_ == NJS_ACTIVE)
+  // checked first, a piece being read ahead uses bufSize_
+  if (iLob->state_ == NJS_ACTIVE || iLob->aheadActive_)
   {
     msg = NJSMessages::getErrorMsg(errBusyLob);
 
@@ -630,6 +650,8 @@ NAN_SETTER(ILob::SetPieceSize)
     return;
   }
 
+  NJS_SET_PROP_UINT(iLob->bufSize_, value, "pieceSize");
+
   if( !iLob->njsconn_->isValid() )
   {
     msg = NJSMessages::getErrorMsg ( errInvalidConnection );
@@ -643,6 +665,14 @@ NAN_SETTER(ILob::SetPieceSize)
     iLob->buf_ = NULL;
   }
 
+  // the piece read ahead has the previous size
+  if (iLob->aheadBuf_)
+  {
+    delete [] iLob->aheadBuf_;
+    iLob->aheadBuf_ = NULL;
+  }
+  iLob->aheadReady_ = false;
+
   if (iLob->fetchType_ == DpiClob)
   {
     try
@@ -738,7 +768,7 @@ NAN_SETTER(ILob::SetOffset)
     NJS_SET_EXCEPTION ( msg.c_str() );
   }
 
-  if (iLob->state_ == NJS_ACTIVE)
+  if (iLob->state_ == NJS_ACTIVE || iLob->aheadActive_)
   {
     msg = NJSMessages::getErrorMsg(errBusyLob);
 
@@ -753,7 +783,8 @@ NAN_SETTER(ILob::SetOffset)
     return;
   }
 
-  iLob->offset_ = (unsigned long long) offset;
+  iLob->offset_     = (unsigned long long) offset;
+  iLob->aheadReady_ = false;      // the piece read ahead is at the old offset
 }
 
 
@@ -868,17 +899,30 @@ NAN_METHOD(ILob::Read)
     goto exitRead;
   }
 
+  // The next piece is being read ahead, queued by Async_AfterReadAhead
+  if (iLob->aheadActive_ && !iLob->pendingBaton_)
+  {
+    lobBaton->req.data  = (void*)lobBaton;
+    iLob->pendingBaton_ = lobBaton;
+    info.GetReturnValue().SetUndefined();
+    return;
+  }
+
+  lobBaton->fromAhead = iLob->aheadReady_;
+  iLob->aheadReady_   = false;
+
  exitRead:
 
   lobBaton->req.data  = (void*)lobBaton;
-  int status = uv_queue_work(uv_default_loop(), &lobBaton->req,
-               Async_Read, (uv_after_work_cb)Async_AfterRead);
-  // delete the Baton if uv_queue_work fails
+  int status = ThreadPool::queueWork(&lobBaton->req,
+               Async_Read, (uv_after_work_cb)Async_AfterRead,
+               iLob->njsconn_);
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete lobBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work", "LobRead" );
+                                              "queueWork", "LobRead" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
 
@@ -910,30 +954,35 @@ void ILob::Async_Read(uv_work_t *req)
   if(!(lobBaton->error).empty())
     goto exitAsyncRead;
 
-  try
+  // The piece was read ahead, swap the buffers.  A write() in between
+  // moves the offset and makes the piece stale.
+  if (lobBaton->fromAhead && iLob->aheadStart_ == iLob->offset_)
   {
-    unsigned long long byteAmount = (unsigned long int)iLob->bufSize_;
-    unsigned long long charAmount = 0;
-    unsigned long long bufl = 0;
+    char *buf = iLob->buf_;
 
-    // Clobs read by characters
-    if (iLob->fetchType_ == DpiClob)
+    iLob->buf_        = iLob->aheadBuf_;
+    iLob->aheadBuf_   = buf;
+    iLob->amountRead_ = iLob->aheadAmount_;
+    iLob->offset_     = iLob->aheadOffset_;
+    lobBaton->error   = iLob->aheadError_;
+    goto exitAsyncRead;
+  }
+
+  try
+  {
+    // The buffer of the previous BLOB read was handed over to a Buffer
+    if (!iLob->buf_)
     {
-      charAmount = iLob->bufSize_;
-      byteAmount = 0;
-      // for CLOBs, buflen is adjusted to handle multi-byte charsets
-      bufl = charAmount * iLob->dpiconn_->getByteExpansionRatio();
+      iLob->buf_ = iLob->newReadBuf ();
+      if (!iLob->buf_)
+      {
+        lobBaton->error = NJSMessages::getErrorMsg(errInsufficientMemory);
+        goto exitAsyncRead;
+      }
     }
-    Lob::read((DpiHandle *)iLob->svch_, (DpiHandle *)iLob->errh_,
-              (Descriptor *)iLob->lobLocator_, byteAmount, charAmount,
-              iLob->offset_, (void *)iLob->buf_, bufl);
 
     // amountRead_ used in Async_AfterRead to construct string
-    iLob->amountRead_ = (unsigned long)byteAmount;
-    if (iLob->fetchType_ == DpiClob)
-      iLob->offset_ += charAmount; // offset for CLOBS is character based
-    else
-      iLob->offset_ += byteAmount;
+    iLob->amountRead_ = iLob->readPiece ( iLob->buf_, iLob->offset_ );
   }
   catch (dpi::Exception& e)
   {
@@ -991,10 +1040,18 @@ void ILob::Async_AfterRead(uv_work_t *req)
                                          iLob->amountRead_).ToLocalChecked();
         argv[1] = str;
       }
+      else if (iLob->amountRead_ >= iLob->bufSize_ / 2)
+      {
+        // Blobs use buffers rather than strings.  The read buffer is
+        // handed over to the Buffer, the next read allocates a new one.
+        Local<Value> buffer = Nan::NewBuffer((char *)iLob->buf_,
+                  iLob->amountRead_, ILob::FreeReadBuf, NULL).ToLocalChecked();
+        iLob->buf_ = NULL;
+        argv[1] = buffer;
+      }
       else
       {
-        // Blobs use buffers rather than strings
-        // TODO: We could use NewBuffer to save memory and CPU, but it gets the ownership of buffer to itself (behaviour changed in Nan 2.0)
+        // Copy a short piece rather than keep the whole buffer for it
         Local<Value> buffer = Nan::CopyBuffer((char *)iLob->buf_,
                                              iLob->amountRead_).ToLocalChecked();
         argv[1] = buffer;
@@ -1006,11 +1063,23 @@ void ILob::Async_AfterRead(uv_work_t *req)
       argv[1] = Nan::Null();
   }
 
-  Local<Function> callback = Nan::New<Function>(lobBaton->cb);
+  bool            readAhead = lobBaton->error.empty() && iLob->amountRead_;
+  Local<Function> callback  = Nan::New<Function>(lobBaton->cb);
+  Local<Object>   jsLob     = Nan::New<Object>(lobBaton->jsLob);
   delete lobBaton;
 
   Nan::MakeCallback(Nan::GetCurrentContext()->Global(), callback, 2, argv);
 
+  // Read the next piece while this one is consumed.  Started only now, the
+  // callback may have set pieceSize or offset, read again or released the
+  // Lob or its connection.
+  if (readAhead && !tc.HasCaught() && iLob->state_ != NJS_ACTIVE &&
+      !iLob->aheadActive_ && iLob->offset_ <= iLob->length_ &&
+      iLob->lobLocator_ && iLob->njsconn_->isValid())
+  {
+    ILob::ReadAhead ( iLob, callback, jsLob );
+  }
+
   if(tc.HasCaught())
   {
     Nan::FatalException(tc);
@@ -1019,6 +1088,238 @@ void ILob::Async_AfterRead(uv_work_t *req)
 
 
 
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Frees a read buffer handed over to a Buffer, when the Buffer is
+     garbage collected
+
+   PARAMETERS
+     data - read buffer
+     hint - not used
+*/
+
+void ILob::FreeReadBuf ( char *data, void *hint )
+{
+  delete [] data;
+}
+
+
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Reads one piece of the Lob.  Called in the worker thread.
+
+   PARAMETERS
+     buf    - buffer for the piece
+     offset - offset of the piece, advanced past it
+
+   RETURNS
+     # of bytes read, 0 at the end of the Lob
+
+   NOTES
+     Throws dpi::Exception.
+*/
+
+unsigned long ILob::readPiece ( char *buf, unsigned long long &offset )
+{
+  unsigned long long byteAmount = (unsigned long int)bufSize_;
+  unsigned long long charAmount = 0;
+  unsigned long long bufl = 0;
+
+  // Clobs read by characters
+  if (fetchType_ == DpiClob)
+  {
+    charAmount = bufSize_;
+    byteAmount = 0;
+    // for CLOBs, buflen is adjusted to handle multi-byte charsets
+    bufl = charAmount * dpiconn_->getByteExpansionRatio();
+  }
+  Lob::read((DpiHandle *)svch_, (DpiHandle *)errh_,
+            (Descriptor *)lobLocator_, byteAmount, charAmount,
+            offset, (void *)buf, bufl);
+
+  if (fetchType_ == DpiClob)
+    offset += charAmount;   // offset for CLOBS is character based
+  else
+    offset += byteAmount;
+
+  return (unsigned long)byteAmount;
+}
+
+
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Allocates a buffer for one piece, sized for multi-byte charsets in
+     case of Clobs
+
+   RETURNS
+     buffer, NULL if out of memory
+
+   NOTES
+     Throws dpi::Exception.
+*/
+
+char * ILob::newReadBuf ()
+{
+  unsigned int size = bufSize_;
+
+  if (fetchType_ == DpiClob)
+    size *= dpiconn_->getByteExpansionRatio();
+
+  return new (std::nothrow) char[size];
+}
+
+
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Queues the read of the piece after the one just read, so that it is
+     fetched from the database while the current piece is consumed.
+
+   PARAMETERS
+     iLob     - ILob object
+     callback - callback of the read just completed, not called
+     jsLob    - JS object of the Lob, kept alive during the read ahead
+
+   NOTES
+     Called in the main thread, after the callback of the read.  The work is queued on the connection, so
+     the next read() runs after it and takes the piece (see Async_Read).
+     It is not counted in LOBCount (): the connection can be released while
+     a piece is read ahead, the release is queued after it.
+*/
+
+void ILob::ReadAhead ( ILob *iLob, Local<Function> callback,
+                       Local<Object> jsLob )
+{
+  LobBaton *aheadBaton = new LobBaton ( iLob->aheadCount_, callback, jsLob );
+
+  aheadBaton->iLob     = iLob;
+  aheadBaton->req.data = (void *)aheadBaton;
+
+  int status = ThreadPool::queueWork ( &aheadBaton->req, Async_ReadAhead,
+                         (uv_after_work_cb)Async_AfterReadAhead,
+                         iLob->njsconn_ );
+  if ( status )
+  {
+    // not fatal, the next read() goes to the database
+    delete aheadBaton;
+    return;
+  }
+
+  iLob->aheadActive_ = true;
+}
+
+
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Worker function of ReadAhead
+
+   PARAMETERS
+     req - UV queue work block
+
+   NOTES
+     The piece, its size and any error are kept for the next read(), the
+     offset_ is left alone until then.
+*/
+
+void ILob::Async_ReadAhead ( uv_work_t *req )
+{
+  LobBaton *aheadBaton = (LobBaton *)req->data;
+  ILob     *iLob       = aheadBaton->iLob;
+
+  iLob->aheadAmount_ = 0;
+  iLob->aheadStart_  = iLob->offset_;
+  iLob->aheadOffset_ = iLob->offset_;
+  iLob->aheadError_.clear ();
+
+  try
+  {
+    if (!iLob->aheadBuf_)
+    {
+      iLob->aheadBuf_ = iLob->newReadBuf ();
+      if (!iLob->aheadBuf_)
+      {
+        iLob->aheadError_ = NJSMessages::getErrorMsg(errInsufficientMemory);
+        return;
+      }
+    }
+
+    iLob->aheadAmount_ = iLob->readPiece ( iLob->aheadBuf_,
+                                           iLob->aheadOffset_ );
+  }
+  catch (dpi::Exception& e)
+  {
+    NJS_SET_CONN_ERR_STATUS ( e.errnum(), iLob->dpiconn_ );
+    iLob->aheadError_ = std::string(e.what());
+  }
+}
+
+
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Callback function of ReadAhead
+
+   PARAMETERS
+     req - UV queue work block
+
+   NOTES
+     Queues the read() that came in meanwhile, or completes the release()
+     that was deferred.
+*/
+
+void ILob::Async_AfterReadAhead ( uv_work_t *req )
+{
+  Nan::HandleScope scope;
+
+  LobBaton *aheadBaton = (LobBaton *)req->data;
+  ILob     *iLob       = aheadBaton->iLob;
+  LobBaton *lobBaton   = iLob->pendingBaton_;
+
+  iLob->aheadActive_  = false;
+  iLob->aheadReady_   = true;
+  iLob->pendingBaton_ = NULL;
+
+  if (iLob->releasePending_)
+  {
+    iLob->releasePending_ = false;
+    iLob->cleanup ();
+    if (lobBaton)
+    {
+      lobBaton->error = NJSMessages::getErrorMsg(errInvalidLob);
+    }
+  }
+
+  if (lobBaton)
+  {
+    lobBaton->fromAhead = iLob->aheadReady_;
+    iLob->aheadReady_   = false;
+
+    int status = ThreadPool::queueWork ( &lobBaton->req, Async_Read,
+                           (uv_after_work_cb)Async_AfterRead,
+                           iLob->njsconn_ );
+    if ( status )
+    {
+      lobBaton->fromAhead = false;
+      lobBaton->error = NJSMessages::getErrorMsg ( errInternalError,
+                                                   "queueWork", "LobRead" );
+      Async_AfterRead ( &lobBaton->req );
+    }
+  }
+
+  delete aheadBaton;
+}
+
+
+
 /*****************************************************************************/
 /*
   DESCRIPTION
@@ -1075,14 +1376,15 @@ NAN_METHOD(ILob::Write)
  exitWrite:
 
   lobBaton->req.data  = (void*)lobBaton;
-  int status = uv_queue_work(uv_default_loop(), &lobBaton->req,
-               Async_Write, (uv_after_work_cb)Async_AfterWrite);
-  // delete the Baton if uv_queue_work fails
+  int status = ThreadPool::queueWork(&lobBaton->req,
+               Async_Write, (uv_after_work_cb)Async_AfterWrite,
+               iLob->njsconn_);
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete lobBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work", "LobWrite" );
+                                              "queueWork", "LobWrite" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
 
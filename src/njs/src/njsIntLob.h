@@ -81,6 +81,7 @@ typedef struct LobBaton
   ILob                      *iLob;
   char                      *writebuf;
   unsigned long long         writelen;
+  bool                       fromAhead;   // read the piece read ahead
   RefCounter                 counter;
 
   Nan::Persistent<Function>  cb;
@@ -90,7 +91,7 @@ typedef struct LobBaton
   LobBaton( unsigned int& count, Local<Function> callback,
             Local<Object> jsLobObj ):
     error(""), dpienv(NULL), dpiconn(NULL), iLob(NULL), writebuf(NULL),
-    writelen(0), counter( count )
+    writelen(0), fromAhead(false), counter( count )
   {
     cb.Reset( callback );
     jsLob.Reset ( jsLobObj );
@@ -99,7 +100,7 @@ typedef struct LobBaton
   LobBaton( unsigned int& count, Local<Object> buffer_obj,
             Local<Function> callback, Local<Object> jsLobObj ):
     error(""), dpienv(NULL), dpiconn(NULL), iLob(NULL), writebuf(NULL),
-    writelen(0), counter( count )
+    writelen(0), fromAhead(false), counter( count )
   {
     cb.Reset( callback );
     lobbuf.Reset(buffer_obj);
@@ -203,6 +204,15 @@ class ILob : public Nan::ObjectWrap
   static NAN_METHOD(Read);
   static void Async_Read (uv_work_t *req);
   static void Async_AfterRead (uv_work_t *req);
+  static void FreeReadBuf ( char *data, void *hint );
+  unsigned long readPiece ( char *buf, unsigned long long &offset );
+  char * newReadBuf ();
+
+                                // Reads the next piece ahead
+  static void ReadAhead ( ILob *iLob, Local<Function> callback,
+                          Local<Object> jsLob );
+  static void Async_ReadAhead ( uv_work_t *req );
+  static void Async_AfterReadAhead ( uv_work_t *req );
 
                                 // Write Method on ILob class
   static NAN_METHOD(Write);
@@ -219,12 +229,26 @@ class ILob : public Nan::ObjectWrap
   bool                      isValid_;
   State                     state_;
 
-  char                     *buf_;
+  char                     *buf_;         // NULL once handed to a Buffer
   unsigned int              bufSize_;
   unsigned int              chunkSize_;
   unsigned long long        length_;
   unsigned long long        offset_;
   unsigned long             amountRead_;
+
+  // Read ahead of the next piece: the next read() takes the piece read
+  // ahead instead of going to the database.  aheadActive_ and aheadReady_
+  // are only used in the main thread.
+  char                     *aheadBuf_;
+  unsigned long             aheadAmount_;
+  unsigned long long        aheadStart_;   // offset of the piece
+  unsigned long long        aheadOffset_;  // offset after the piece
+  std::string               aheadError_;
+  unsigned int              aheadCount_;   // not counted in LOBCount ()
+  bool                      aheadActive_;  // read ahead queued
+  bool                      aheadReady_;   // piece read ahead not yet taken
+  bool                      releasePending_; // release() while reading ahead
+  LobBaton                 *pendingBaton_;   // read() while reading ahead
   unsigned long long        amountWritten_;
   unsigned int              type_;
   Nan::Persistent<Object>   jsParent_;
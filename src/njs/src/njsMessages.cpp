@@ -84,6 +84,13 @@ static const char *errMsg[] =
   "NJS-045: cannot load the oracledb add-on binary", // errCannotLoadBinary
   "NJS-046: pool alias \"%s\" already exists in the connection pool cache", // errPoolWithAliasAlreadyExists
   "NJS-047: pool alias \"%s\" not found in connection pool cache", // errPoolWithAliasNotFound
+  "NJS-048: all bind rows must be of the same type as the first row", // errInconsistentBindRows
+  "NJS-049: queries cannot be executed with executeMany()", // errQueryNotAllowed
+  "NJS-050: number of rows to fetch cannot change when fetchAhead is enabled", // errFetchAheadRowsChanged
+  "NJS-051: ioThreads cannot be changed after the first database call", // errIOThreadsStarted
+  "NJS-052: OUT binds of executeMany() require a RETURNING INTO clause", // errOutBindsNotReturning
+  "NJS-053: more rows returned than maxArraySize allows", // errTooManyRowsReturned
+  "NJS-054: pool is busy or terminating",          // errPoolBusy
 };
 
 string NJSMessages::getErrorMsg ( NJSErrorType err, ... )
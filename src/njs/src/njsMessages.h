@@ -83,6 +83,13 @@ typedef enum
   errCannotLoadBinary,
   errPoolWithAliasAlreadyExists,
   errPoolWithAliasNotFound,
+  errInconsistentBindRows,
+  errQueryNotAllowed,
+  errFetchAheadRowsChanged,
+  errIOThreadsStarted,
+  errOutBindsNotReturning,
+  errTooManyRowsReturned,
+  errPoolBusy,
 
   // New ones should be added here
 
@@ -56,6 +56,7 @@
 #include "njsResultSet.h"
 #include "njsMessages.h"
 #include "njsIntLob.h"
+#include "njsThreadPool.h"
 #include <sstream>
                                         //peristent Oracledb class handle
 Nan::Persistent<FunctionTemplate> Oracledb::oracledbTemplate_s;
@@ -94,6 +95,8 @@ Oracledb::Oracledb()
   externalAuth_            = false;
   fetchAsStringTypes_      = NULL;
   fetchAsStringTypesCount_ = 0;
+  fetchAsBufferTypes_      = NULL;
+  fetchAsBufferTypesCount_ = 0;
   lobPrefetchSize_         = NJS_LOB_PREFETCH_SIZE;
 }
 
@@ -111,6 +114,13 @@ Oracledb::~Oracledb()
     fetchAsStringTypesCount_ = 0;
   }
 
+  if ( fetchAsBufferTypes_ )
+  {
+    free ( fetchAsBufferTypes_ );
+    fetchAsBufferTypes_ = NULL ;
+    fetchAsBufferTypesCount_ = 0;
+  }
+
   if (this->dpienv_)
   {
     dpienv_->terminate();
@@ -224,11 +234,21 @@ void Oracledb::Init(Handle<Object> target)
     Nan::New<v8::String>("fetchAsString").ToLocalChecked(),
     Oracledb::GetFetchAsString,
     Oracledb::SetFetchAsString);
+  Nan::SetAccessor(
+    temp->InstanceTemplate(),
+    Nan::New<v8::String>("fetchAsBuffer").ToLocalChecked(),
+    Oracledb::GetFetchAsBuffer,
+    Oracledb::SetFetchAsBuffer);
   Nan::SetAccessor(
     temp->InstanceTemplate(),
     Nan::New<v8::String>("lobPrefetchSize").ToLocalChecked(),
     Oracledb::GetLobPrefetchSize,
     Oracledb::SetLobPrefetchSize);
+  Nan::SetAccessor(
+    temp->InstanceTemplate(),
+    Nan::New<v8::String>("ioThreads").ToLocalChecked(),
+    Oracledb::GetIOThreads,
+    Oracledb::SetIOThreads);
   Nan::SetAccessor(
     temp->InstanceTemplate (),
     Nan::New<v8::String>("oracleClientVersion").ToLocalChecked(),
@@ -247,7 +267,7 @@ void Oracledb::Init(Handle<Object> target)
 */
 NAN_METHOD(Oracledb::New)
 {
-  sword     majorVer = 0, minorVer = 0, updateVer = 0, portVer = 0,
+  int       majorVer = 0, minorVer = 0, updateVer = 0, portVer = 0,
             portUpdateVer = 0;
 
   dpi::Common::clientVersion ( &majorVer, &minorVer, &updateVer,
@@ -627,6 +647,47 @@ NAN_SETTER(Oracledb::SetLobPrefetchSize)
   NJS_SET_PROP_UINT(oracledb->lobPrefetchSize_, value, "lobPrefetchSize");
 }
 
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Get Accessor of ioThreads property
+*/
+NAN_GETTER(Oracledb::GetIOThreads)
+{
+  Oracledb* oracledb = Nan::ObjectWrap::Unwrap<Oracledb>(info.Holder());
+  NJS_CHECK_OBJECT_VALID2(oracledb, info);
+  Local<Integer> value = Nan::New<v8::Integer>(ThreadPool::getSize());
+  info.GetReturnValue().Set(value);
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Set Accessor of ioThreads property
+
+   NOTES:
+     The worker threads are started by the first database call, after
+     which their number cannot change.
+*/
+NAN_SETTER(Oracledb::SetIOThreads)
+{
+  Oracledb* oracledb = Nan::ObjectWrap::Unwrap<Oracledb>(info.Holder());
+  NJS_CHECK_OBJECT_VALID(oracledb);
+
+  if ( !value->IsUint32() ||
+       value->ToUint32()->Value() > NJS_IO_THREADS_MAX )
+  {
+    string errMsg = NJSMessages::getErrorMsg ( errInvalidPropertyValue,
+                                               "ioThreads" );
+    NJS_SET_EXCEPTION ( errMsg.c_str() );
+  }
+  else if ( !ThreadPool::setSize ( value->ToUint32()->Value() ) )
+  {
+    string errMsg = NJSMessages::getErrorMsg ( errIOThreadsStarted );
+    NJS_SET_EXCEPTION ( errMsg.c_str() );
+  }
+}
+
 /*****************************************************************************/
 /*
    DESCRIPTION
@@ -714,6 +775,91 @@ NAN_SETTER(Oracledb::SetFetchAsString)
   }
 }
 
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Get Accessor of FetchAsBuffer property
+*/
+NAN_GETTER(Oracledb::GetFetchAsBuffer)
+{
+  Oracledb* oracledb = Nan::ObjectWrap::Unwrap<Oracledb>(info.Holder());
+  Local<Array> typeArray = Nan::New <v8::Array>(0);
+
+  NJS_CHECK_OBJECT_VALID2(oracledb, info);
+  if ( oracledb->fetchAsBufferTypes_ )
+  {
+    typeArray = Nan::New<v8::Array>( oracledb->fetchAsBufferTypesCount_ );
+    for ( unsigned int t = 0; t < oracledb->fetchAsBufferTypesCount_ ; t ++ )
+    {
+      typeArray->Set (t, Nan::New<v8::Integer>(oracledb->fetchAsBufferTypes_[t]));
+    }
+  }
+
+  info.GetReturnValue().Set(typeArray);
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Set Accessor of FetchAsBuffer property
+
+   NOTES
+     Only BLOB can be fetched as Buffer.
+*/
+NAN_SETTER(Oracledb::SetFetchAsBuffer)
+{
+  Oracledb* oracledb = Nan::ObjectWrap::Unwrap<Oracledb>(info.Holder());
+  Local<Array> array;
+  DataType *types;
+  string msg;
+
+  NJS_CHECK_OBJECT_VALID (oracledb);
+  if ( !value->IsArray () )
+  {
+    msg = NJSMessages::getErrorMsg ( errEmptyArrayForFetchAs );
+    NJS_SET_EXCEPTION ( msg.c_str() );
+    return;
+  }
+
+  array = value.As<v8::Array> ();
+  for ( unsigned int t = 0 ; t < array->Length () ; t ++ )
+  {
+    if ( array->Get(t).As<v8::Integer>()->ToInt32()->Value () !=
+         NJS_DATATYPE_BLOB )
+    {
+      msg = NJSMessages::getErrorMsg ( errInvalidTypeForConversion );
+      NJS_SET_EXCEPTION ( msg.c_str() );
+      return;
+    }
+  }
+
+  types = NULL;
+  if ( array->Length () > 0 )
+  {
+    // Overflow check is not required as number of fetchAsBuffer is NOT
+    // expected to be huge.
+    types = (DataType *)malloc ( array->Length() * sizeof ( DataType ) );
+    if ( !types )
+    {
+      msg = NJSMessages::getErrorMsg ( errInsufficientMemory ) ;
+      NJS_SET_EXCEPTION ( msg.c_str () );
+      return;
+    }
+
+    for ( unsigned int t = 0 ; t < array->Length () ; t ++ )
+    {
+      types[t] = NJS_DATATYPE_BLOB;
+    }
+  }
+
+  if ( oracledb->fetchAsBufferTypes_ )
+  {
+    free ( oracledb->fetchAsBufferTypes_ );
+  }
+  oracledb->fetchAsBufferTypes_      = types;
+  oracledb->fetchAsBufferTypesCount_ = array->Length ();
+}
+
 /*****************************************************************************/
 /*
   DESCRIPTION
@@ -795,15 +941,15 @@ exitGetConnection :
   // This needs to be called even in error case to make the control
   // fall through uv_after_work_cb. In case of error being present in
   // baton, the worker thread anyway returns
-  int status = uv_queue_work( uv_default_loop(), &connBaton->req,
+  int status = ThreadPool::queueWork(&connBaton->req,
                Async_GetConnection,
                (uv_after_work_cb) Async_AfterGetConnection );
-  // delete the Baton if uv_queue_work fails
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete connBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work",
+                                              "queueWork",
                                               "GetConnection" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
@@ -947,6 +1093,29 @@ NAN_METHOD(Oracledb::CreatePool)
   NJS_GET_BOOL_FROM_JSON   ( poolBaton->externalAuth, poolBaton->error,
                              poolProps, "externalAuth", 0, exitCreatePool );
 
+  /*
+   * queueRequests, queueTimeout and poolPingInterval defaults are kept on
+   * the JS oracledb object; a value in the pool attributes overrides them.
+   */
+  NJS_GET_BOOL_FROM_JSON   ( poolBaton->queueRequests, poolBaton->error,
+                             info.Holder(), "queueRequests", 0,
+                             exitCreatePool );
+  NJS_GET_UINT_FROM_JSON   ( poolBaton->queueTimeout, poolBaton->error,
+                             info.Holder(), "queueTimeout", 0,
+                             exitCreatePool );
+  NJS_GET_INT_FROM_JSON    ( poolBaton->poolPingInterval, poolBaton->error,
+                             info.Holder(), "poolPingInterval", 0,
+                             exitCreatePool );
+  NJS_GET_BOOL_FROM_JSON   ( poolBaton->queueRequests, poolBaton->error,
+                             poolProps, "queueRequests", 0, exitCreatePool );
+  NJS_GET_UINT_FROM_JSON   ( poolBaton->queueTimeout, poolBaton->error,
+                             poolProps, "queueTimeout", 0, exitCreatePool );
+  NJS_GET_UINT_FROM_JSON   ( poolBaton->poolMinIdle, poolBaton->error,
+                             poolProps, "poolMinIdle", 0, exitCreatePool );
+  NJS_GET_INT_FROM_JSON    ( poolBaton->poolPingInterval, poolBaton->error,
+                             poolProps, "poolPingInterval", 0,
+                             exitCreatePool );
+
   poolBaton->oracledb  =  oracledb;
   poolBaton->dpienv    =  oracledb->dpienv_;
   poolBaton->lobPrefetchSize =  oracledb->lobPrefetchSize_;
@@ -954,16 +1123,15 @@ NAN_METHOD(Oracledb::CreatePool)
 exitCreatePool:
   poolBaton->req.data = (void *)poolBaton;
 
-  int status = uv_queue_work(uv_default_loop(),
-               &poolBaton->req,
+  int status = ThreadPool::queueWork(&poolBaton->req,
                Async_CreatePool,
                (uv_after_work_cb) Async_AfterCreatePool);
-  // delete the Baton if uv_queue_work fails
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete poolBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work", "CreatePool" );
+                                              "queueWork", "CreatePool" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
 
@@ -1002,6 +1170,7 @@ void Oracledb::Async_CreatePool (uv_work_t *req)
                                                   poolBaton->stmtCacheSize,
                                                   poolBaton->externalAuth,
                                    poolBaton->externalAuth ? false : true  );
+    poolBaton->dpipool->pingInterval ( poolBaton->poolPingInterval );
   }
   catch (dpi::Exception &e)
   {
@@ -1051,6 +1220,10 @@ void Oracledb::Async_AfterCreatePool (uv_work_t *req)
                                             poolBaton->poolTimeout,
                                             poolBaton->stmtCacheSize,
                                             poolBaton->lobPrefetchSize,
+                                            poolBaton->queueRequests,
+                                            poolBaton->queueTimeout,
+                                            poolBaton->poolMinIdle,
+                                            poolBaton->poolPingInterval,
                                             Nan::New( poolBaton->jsOradb ) );
     argv[1] = njsPool;
   }
@@ -1122,6 +1295,41 @@ const DataType * Oracledb::getFetchAsStringTypes () const
 }
 
 
+/*****************************************************************************/
+/*
+  DESCRIPTION
+    To obtain Fetch-As-Buffer-Types, a new array is allocated and types are
+    copied and returned and expected to be freed at the end of execution
+
+  PARAMETERS
+    -NONE-
+
+  RETURNS
+    array of DataType element to Fetch As Buffer
+*/
+const DataType * Oracledb::getFetchAsBufferTypes () const
+{
+  DataType *types = NULL;
+
+  if ( fetchAsBufferTypes_ )
+  {
+    unsigned int count = fetchAsBufferTypesCount_;
+
+    types = (DataType * )malloc ( sizeof ( DataType ) * count ) ;
+    // Memory allocation failure is reported to application by the caller.
+    if ( types )
+    {
+      for ( unsigned int i = 0 ; i < count ; i ++ )
+      {
+        types[i] = fetchAsBufferTypes_[i];
+      }
+    }
+  }
+
+  return types;
+}
+
+
 
 /* end of file njsOracle.cpp */
 
@@ -105,6 +105,11 @@ class Oracledb: public Nan::ObjectWrap
    unsigned int       getFetchAsStringTypesCount () const
    {  return fetchAsStringTypesCount_ ;   }
 
+   const DataType*    getFetchAsBufferTypes () const;
+
+   unsigned int       getFetchAsBufferTypesCount () const
+   {  return fetchAsBufferTypesCount_ ;   }
+
 private:
    const string driverName() const;
 
@@ -138,7 +143,9 @@ private:
    static NAN_GETTER(GetExternalAuth);
    static NAN_GETTER(GetPrefetchRows);
    static NAN_GETTER(GetFetchAsString);
+   static NAN_GETTER(GetFetchAsBuffer);
    static NAN_GETTER(GetLobPrefetchSize);
+   static NAN_GETTER(GetIOThreads);
    static NAN_GETTER(GetOracleClientVersion);
 
    // Define Setter Accessors to Properties
@@ -156,7 +163,9 @@ private:
    static NAN_SETTER(SetExternalAuth);
    static NAN_SETTER(SetPrefetchRows);
    static NAN_SETTER(SetFetchAsString);
+   static NAN_SETTER(SetFetchAsBuffer);
    static NAN_SETTER(SetLobPrefetchSize);
+   static NAN_SETTER(SetIOThreads);
    static NAN_SETTER(SetOracleClientVersion);
 
    Oracledb();
@@ -180,6 +189,8 @@ private:
    bool         externalAuth_;
    DataType     *fetchAsStringTypes_;
    unsigned int fetchAsStringTypesCount_;
+   DataType     *fetchAsBufferTypes_;
+   unsigned int fetchAsBufferTypesCount_;
    unsigned int lobPrefetchSize_;
    unsigned int oraClientVer_;
 };
@@ -205,6 +216,10 @@ typedef struct connectionBaton
   int                        poolTimeout;
   int                        stmtCacheSize;
   unsigned int               lobPrefetchSize;
+  bool                       queueRequests;
+  unsigned int               queueTimeout;
+  unsigned int               poolMinIdle;
+  int                        poolPingInterval;
 
   unsigned int               maxRows;
   unsigned int               outFormat;
@@ -220,8 +235,10 @@ typedef struct connectionBaton
                       user(""), pswrd(""), connStr(""), connClass(""),
                       externalAuth(false), error(""),
                       poolMax(0), poolMin(0), poolIncrement(0),
-                      poolTimeout(0), stmtCacheSize(0), maxRows(0),
-                      outFormat(0), dpienv(NULL),
+                      poolTimeout(0), stmtCacheSize(0),
+                      queueRequests(true), queueTimeout(0), poolMinIdle(0),
+                      poolPingInterval(-1), maxRows(0), outFormat(0),
+                      dpienv(NULL),
                       dpiconn(NULL), dpipool(NULL)
   {
     cb.Reset( callback );
@@ -51,11 +51,13 @@
 #include "node.h"
 
 #include <string>
+#include <vector>
 
 #include "njsOracle.h"
 #include "njsPool.h"
 #include "njsConnection.h"
 #include "njsUtils.h"
+#include "njsThreadPool.h"
 
 using namespace std;
 using namespace node;
@@ -63,8 +65,148 @@ using namespace v8;
                                         //peristent Pool class handle
 Nan::Persistent<FunctionTemplate> Pool::poolTemplate_s;
 
-Pool::Pool(){}
-Pool::~Pool(){}
+                                        // milliseconds
+const double PoolHistogram::bounds_[NJS_POOL_HISTOGRAM_BUCKETS - 1] =
+  { 0.5, 1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000 };
+
+PoolHistogram::PoolHistogram ()
+  : count_ ( 0 ), sum_ ( 0 ), max_ ( 0 )
+{
+  for ( unsigned int i = 0; i < NJS_POOL_HISTOGRAM_BUCKETS; i++ )
+  {
+    counts_[i] = 0;
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Adds a duration to the histogram.
+
+   PARAMETERS:
+     ms - duration in milliseconds
+*/
+void PoolHistogram::add ( double ms )
+{
+  unsigned int i = 0;
+
+  while ( i < NJS_POOL_HISTOGRAM_BUCKETS - 1 && ms > bounds_[i] )
+  {
+    i++;
+  }
+  counts_[i]++;
+  count_++;
+  sum_ += ms;
+  if ( ms > max_ )
+  {
+    max_ = ms;
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Estimates a percentile of the durations.
+
+   PARAMETERS:
+     fraction - 0.5 for the median, 0.99 for the 99th percentile...
+
+   RETURNS:
+     upper bound of the bucket holding the percentile (the largest duration
+     if it is lower), 0 if the histogram is empty
+*/
+double PoolHistogram::percentile ( double fraction ) const
+{
+  double rank = fraction * count_;
+  double cum  = 0;
+
+  if ( !count_ )
+  {
+    return 0;
+  }
+
+  for ( unsigned int i = 0; i < NJS_POOL_HISTOGRAM_BUCKETS - 1; i++ )
+  {
+    cum += counts_[i];
+    if ( cum >= rank )
+    {
+      return ( bounds_[i] < max_ ) ? bounds_[i] : max_;
+    }
+  }
+  return max_;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Converts the histogram to a JS object.
+
+   NOTES:
+     The bucket counts are cumulative and keyed by their upper bound, the
+     last key being "+Inf", as in the Prometheus exposition format.
+*/
+Local<Object> PoolHistogram::toObject () const
+{
+  Nan::EscapableHandleScope scope;
+  Local<Object> obj     = Nan::New<v8::Object>();
+  Local<Object> buckets = Nan::New<v8::Object>();
+  double        cum     = 0;
+
+  for ( unsigned int i = 0; i < NJS_POOL_HISTOGRAM_BUCKETS; i++ )
+  {
+    cum += counts_[i];
+    if ( i < NJS_POOL_HISTOGRAM_BUCKETS - 1 )
+    {
+      Nan::Set ( buckets,
+                 Nan::To<v8::String>(
+                       Nan::New<v8::Number>(bounds_[i])).ToLocalChecked(),
+                 Nan::New<v8::Number>(cum) );
+    }
+    else
+    {
+      Nan::Set ( buckets, Nan::New<v8::String>("+Inf").ToLocalChecked(),
+                 Nan::New<v8::Number>(cum) );
+    }
+  }
+
+  Nan::Set ( obj, Nan::New<v8::String>("count").ToLocalChecked(),
+             Nan::New<v8::Number>(count_) );
+  Nan::Set ( obj, Nan::New<v8::String>("sum").ToLocalChecked(),
+             Nan::New<v8::Number>(sum_) );
+  Nan::Set ( obj, Nan::New<v8::String>("max").ToLocalChecked(),
+             Nan::New<v8::Number>(max_) );
+  Nan::Set ( obj, Nan::New<v8::String>("p50").ToLocalChecked(),
+             Nan::New<v8::Number>(percentile ( 0.5 )) );
+  Nan::Set ( obj, Nan::New<v8::String>("p90").ToLocalChecked(),
+             Nan::New<v8::Number>(percentile ( 0.9 )) );
+  Nan::Set ( obj, Nan::New<v8::String>("p99").ToLocalChecked(),
+             Nan::New<v8::Number>(percentile ( 0.99 )) );
+  Nan::Set ( obj, Nan::New<v8::String>("buckets").ToLocalChecked(),
+             buckets );
+
+  return scope.Escape ( obj );
+}
+
+Pool::Pool()
+{
+  queueTimer_       = NULL;
+  warmUpActive_     = false;
+  terminating_      = false;
+  pendingTerminate_ = NULL;
+}
+
+Pool::~Pool()
+{
+  /*
+   * Queued requests keep the pool object alive, so the timer cannot be
+   * active here; the handle is freed once libuv has closed it.
+   */
+  if ( queueTimer_ )
+  {
+    uv_close ( (uv_handle_t *) queueTimer_, Async_CloseQueueTimer );
+    queueTimer_ = NULL;
+  }
+}
 
 /*****************************************************************************/
 /*
@@ -74,7 +216,9 @@ Pool::~Pool(){}
 void Pool::setPool( dpi::SPool *dpipool, Oracledb* oracledb, unsigned int poolMax,
                     unsigned int poolMin, unsigned int poolIncrement,
                     unsigned int poolTimeout, unsigned stmtCacheSize,
-                    unsigned int lobPrefetchSize, Local<Object> jsOradb )
+                    unsigned int lobPrefetchSize, bool queueRequests,
+                    unsigned int queueTimeout, unsigned int poolMinIdle,
+                    int poolPingInterval, Local<Object> jsOradb )
 {
   this->dpipool_         = dpipool;
   this->isValid_         = true;
@@ -85,8 +229,37 @@ void Pool::setPool( dpi::SPool *dpipool, Oracledb* oracledb, unsigned int poolMa
   this->poolTimeout_     = poolTimeout;
   this->stmtCacheSize_   = stmtCacheSize;
   this->lobPrefetchSize_ = lobPrefetchSize;
+  this->queueRequests_   = queueRequests;
+  this->queueTimeout_    = queueTimeout;
+  this->connectionsOut_  = 0;
+  this->poolMinIdle_     = poolMinIdle;
+  this->poolPingInterval_ = poolPingInterval;
+
+  this->totalConnectionRequests_ = 0;
+  this->totalRequestsEnqueued_   = 0;
+  this->totalRequestsDequeued_   = 0;
+  this->totalFailedRequests_     = 0;
+  this->totalRequestTimeouts_    = 0;
+  this->maxQueueLength_          = 0;
+  this->totalTimeInQueue_        = 0;
+  this->minTimeInQueue_          = 0;
+  this->maxTimeInQueue_          = 0;
+
+  this->connectionsOpen_         = 0;
+  this->connectionsInUse_        = 0;
+  this->maxConnectionsOpen_      = 0;
+  this->maxConnectionsInUse_     = 0;
+  this->sessionsCreated_         = 0;
+  this->sessionsDestroyed_       = 0;
+  sampleSessions ();                  // the poolMin sessions
 
   this->jsParent_.Reset ( jsOradb );
+
+  // Validate the sessions opened with the pool and open the idle ones
+  if ( poolMinIdle_ )
+  {
+    warmUp ( ( poolMin > poolMinIdle ) ? poolMin : poolMinIdle, true );
+  }
 }
 
 /*****************************************************************************/
@@ -105,6 +278,8 @@ void Pool::Init(Handle<Object> target)
 
   Nan::SetPrototypeMethod(temp, "terminate", Terminate);
   Nan::SetPrototypeMethod(temp, "getConnection", GetConnection);
+  Nan::SetPrototypeMethod(temp, "_getQueueStats", GetQueueStats);
+  Nan::SetPrototypeMethod(temp, "getStatistics", GetStatistics);
 
   Nan::SetAccessor(temp->InstanceTemplate(),
     Nan::New<v8::String>("poolMax").ToLocalChecked(),
@@ -134,6 +309,22 @@ void Pool::Init(Handle<Object> target)
     Nan::New<v8::String>("stmtCacheSize").ToLocalChecked(),
     Pool::GetStmtCacheSize,
     Pool::SetStmtCacheSize );
+  Nan::SetAccessor(temp->InstanceTemplate(),
+    Nan::New<v8::String>("queueRequests").ToLocalChecked(),
+    Pool::GetQueueRequests,
+    Pool::SetQueueRequests );
+  Nan::SetAccessor(temp->InstanceTemplate(),
+    Nan::New<v8::String>("queueTimeout").ToLocalChecked(),
+    Pool::GetQueueTimeout,
+    Pool::SetQueueTimeout );
+  Nan::SetAccessor(temp->InstanceTemplate(),
+    Nan::New<v8::String>("poolMinIdle").ToLocalChecked(),
+    Pool::GetPoolMinIdle,
+    Pool::SetPoolMinIdle );
+  Nan::SetAccessor(temp->InstanceTemplate(),
+    Nan::New<v8::String>("poolPingInterval").ToLocalChecked(),
+    Pool::GetPoolPingInterval,
+    Pool::SetPoolPingInterval );
 
   poolTemplate_s.Reset( temp );
   Nan::Set(target, Nan::New<v8::String>("Pool").ToLocalChecked(),
@@ -294,6 +485,68 @@ NAN_GETTER(Pool::GetStmtCacheSize)
   info.GetReturnValue().Set(getPoolProperty( njsPool, njsPool->stmtCacheSize_));
 }
 
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Get Accessor of queueRequests Property
+*/
+NAN_GETTER(Pool::GetQueueRequests)
+{
+  Pool* njsPool = Nan::ObjectWrap::Unwrap<Pool>(info.Holder());
+  NJS_CHECK_OBJECT_VALID2(njsPool, info);
+  if(!njsPool->isValid_)
+  {
+    string msg = NJSMessages::getErrorMsg(errInvalidPool);
+    NJS_SET_EXCEPTION ( msg.c_str() );
+    info.GetReturnValue().SetUndefined();
+    return;
+  }
+  info.GetReturnValue().Set(Nan::New<v8::Boolean>(njsPool->queueRequests_));
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Get Accessor of queueTimeout Property
+*/
+NAN_GETTER(Pool::GetQueueTimeout)
+{
+  Pool* njsPool = Nan::ObjectWrap::Unwrap<Pool>(info.Holder());
+  NJS_CHECK_OBJECT_VALID2(njsPool, info);
+  info.GetReturnValue().Set(getPoolProperty( njsPool, njsPool->queueTimeout_));
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Get Accessor of poolMinIdle Property
+*/
+NAN_GETTER(Pool::GetPoolMinIdle)
+{
+  Pool* njsPool = Nan::ObjectWrap::Unwrap<Pool>(info.Holder());
+  NJS_CHECK_OBJECT_VALID2(njsPool, info);
+  info.GetReturnValue().Set(getPoolProperty( njsPool, njsPool->poolMinIdle_));
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Get Accessor of poolPingInterval Property
+*/
+NAN_GETTER(Pool::GetPoolPingInterval)
+{
+  Pool* njsPool = Nan::ObjectWrap::Unwrap<Pool>(info.Holder());
+  NJS_CHECK_OBJECT_VALID2(njsPool, info);
+  if(!njsPool->isValid_)
+  {
+    string msg = NJSMessages::getErrorMsg(errInvalidPool);
+    NJS_SET_EXCEPTION ( msg.c_str() );
+    info.GetReturnValue().SetUndefined();
+    return;
+  }
+  info.GetReturnValue().Set(Nan::New<v8::Integer>(njsPool->poolPingInterval_));
+}
+
 /*****************************************************************************/
 /*
    DESCRIPTION
@@ -383,6 +636,47 @@ NAN_SETTER(Pool::SetStmtCacheSize)
   setPoolProperty(Nan::ObjectWrap::Unwrap<Pool>(info.Holder()), "stmtCacheSize");
 }
 
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Set Accessor of queueRequests Property - throws error
+*/
+NAN_SETTER(Pool::SetQueueRequests)
+{
+  setPoolProperty(Nan::ObjectWrap::Unwrap<Pool>(info.Holder()), "queueRequests");
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Set Accessor of queueTimeout Property - throws error
+*/
+NAN_SETTER(Pool::SetQueueTimeout)
+{
+  setPoolProperty(Nan::ObjectWrap::Unwrap<Pool>(info.Holder()), "queueTimeout");
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Set Accessor of poolMinIdle Property - throws error
+*/
+NAN_SETTER(Pool::SetPoolMinIdle)
+{
+  setPoolProperty(Nan::ObjectWrap::Unwrap<Pool>(info.Holder()), "poolMinIdle");
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Set Accessor of poolPingInterval Property - throws error
+*/
+NAN_SETTER(Pool::SetPoolPingInterval)
+{
+  setPoolProperty(Nan::ObjectWrap::Unwrap<Pool>(info.Holder()),
+                  "poolPingInterval");
+}
+
 /*****************************************************************************/
 /*
    DESCRIPTION
@@ -411,19 +705,49 @@ NAN_METHOD(Pool::GetConnection)
   connBaton->njspool   = njsPool;
   connBaton->connClass = njsPool->oracledb_->getConnectionClass ();
   connBaton->lobPrefetchSize =  njsPool->lobPrefetchSize_;
+  connBaton->requestTime     =  uv_hrtime ();
+  njsPool->totalConnectionRequests_++;
 
-exitGetConnection:
-  connBaton->req.data = (void *)connBaton;
+  if ( njsPool->queueRequests_ )
+  {
+    if ( njsPool->connectionsOut_ >= njsPool->poolMax_ )
+    {
+      // Park the request; it is dispatched when a connection is released
+      connBaton->req.data    = (void *)connBaton;
+      connBaton->enqueueTime = uv_now ( uv_default_loop () );
+      njsPool->connRequestQueue_.push_back ( connBaton );
+      njsPool->totalRequestsEnqueued_++;
+      if ( njsPool->connRequestQueue_.size () > njsPool->maxQueueLength_ )
+      {
+        njsPool->maxQueueLength_ =
+                         (unsigned int) njsPool->connRequestQueue_.size ();
+      }
+      if ( njsPool->connRequestQueue_.size () == 1 )
+      {
+        njsPool->startQueueTimer ();
+      }
+      info.GetReturnValue().SetUndefined();
+      return;
+    }
+
+    /*
+     * Count the connection as out before the async call so that other
+     * requests made meanwhile cannot exceed poolMax.
+     */
+    njsPool->connectionsOut_++;
+    connBaton->connOut = true;
+  }
 
-  int status = uv_queue_work(uv_default_loop(), &connBaton->req,
-               Async_GetConnection,
-               (uv_after_work_cb)Async_AfterGetConnection);
-  // delete the Baton if uv_queue_work fails
-  if ( status )
+exitGetConnection:
+  if ( !queueGetConnection ( connBaton ) )
   {
+    if ( connBaton->connOut )
+    {
+      connBaton->njspool->connectionsOut_--;
+    }
     delete connBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work",
+                                              "queueWork",
                                               "GetConnection" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
@@ -431,6 +755,560 @@ exitGetConnection:
   info.GetReturnValue().SetUndefined();
 }
 
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Queues the worker of the Get Connection method.
+
+   PARAMETERS:
+     connBaton - baton of the connection request
+
+   RETURNS:
+     false if queueWork fails, in which case the caller owns the baton
+*/
+bool Pool::queueGetConnection ( poolBaton *connBaton )
+{
+  connBaton->req.data = (void *)connBaton;
+
+  int status = ThreadPool::queueWork(&connBaton->req,
+               Async_GetConnection,
+               (uv_after_work_cb)Async_AfterGetConnection);
+
+  return ( status == 0 );
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Hands a free slot of the pool to the oldest queued connection request,
+     if any.
+
+   NOTES:
+     Called on the main thread whenever connectionsOut_ is decremented, so
+     a released connection goes to the next waiter without a round trip
+     through JavaScript.
+*/
+void Pool::checkRequestQueue ()
+{
+  if ( connRequestQueue_.empty () || connectionsOut_ >= poolMax_ )
+  {
+    return;
+  }
+
+  poolBaton *connBaton = connRequestQueue_.front ();
+  connRequestQueue_.pop_front ();
+  startQueueTimer ();
+
+  uint64_t waitTime = uv_now ( uv_default_loop () ) - connBaton->enqueueTime;
+
+  if ( totalRequestsDequeued_ == 0 || waitTime < minTimeInQueue_ )
+  {
+    minTimeInQueue_ = waitTime;
+  }
+  if ( waitTime > maxTimeInQueue_ )
+  {
+    maxTimeInQueue_ = waitTime;
+  }
+  totalTimeInQueue_ += waitTime;
+  totalRequestsDequeued_++;
+  queueTimes_.add ( (double) waitTime );
+
+  connectionsOut_++;
+  connBaton->connOut = true;
+
+  if ( !queueGetConnection ( connBaton ) )
+  {
+    connBaton->error = NJSMessages::getErrorMsg ( errInternalError,
+                                                  "queueWork",
+                                                  "GetConnection" );
+    Async_AfterGetConnection ( &connBaton->req );
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Arms the queue timer for the request at the head of the queue, or stops
+     it when the queue is empty.
+
+   NOTES:
+     Requests are queued in arrival order and share the same queueTimeout,
+     so the head of the queue always expires first.
+*/
+void Pool::startQueueTimer ()
+{
+  if ( !queueTimeout_ )
+  {
+    return;
+  }
+
+  if ( !queueTimer_ )
+  {
+    queueTimer_ = new uv_timer_t;
+    uv_timer_init ( uv_default_loop (), queueTimer_ );
+    queueTimer_->data = (void *) this;
+  }
+
+  if ( connRequestQueue_.empty () )
+  {
+    uv_timer_stop ( queueTimer_ );
+    return;
+  }
+
+  uint64_t now      = uv_now ( uv_default_loop () );
+  uint64_t deadline = connRequestQueue_.front ()->enqueueTime + queueTimeout_;
+
+  uv_timer_start ( queueTimer_, (uv_timer_cb) Async_QueueTimeout,
+                   ( deadline > now ) ? deadline - now : 0, 0 );
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Callback of the queue timer. Fails every queued request whose
+     queueTimeout has elapsed with NJS-040.
+
+   PARAMETERS:
+     timer - queue timer of the pool
+*/
+void Pool::Async_QueueTimeout ( uv_timer_t *timer )
+{
+  Nan::HandleScope scope;
+  Pool     *njsPool = (Pool *) timer->data;
+  uint64_t  now     = uv_now ( uv_default_loop () );
+
+  while ( !njsPool->connRequestQueue_.empty () )
+  {
+    poolBaton *connBaton = njsPool->connRequestQueue_.front ();
+
+    if ( now - connBaton->enqueueTime < njsPool->queueTimeout_ )
+    {
+      break;
+    }
+
+    njsPool->connRequestQueue_.pop_front ();
+    njsPool->totalRequestTimeouts_++;
+    njsPool->totalTimeInQueue_ += now - connBaton->enqueueTime;
+    njsPool->queueTimes_.add ( (double) ( now - connBaton->enqueueTime ) );
+
+    // Timeouts are not counted as failed requests
+    connBaton->njspool = NULL;
+    connBaton->error = NJSMessages::getErrorMsg ( errConnRequestTimeout );
+    Async_AfterGetConnection ( &connBaton->req );
+  }
+
+  njsPool->startQueueTimer ();
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Frees the queue timer once libuv has closed it.
+*/
+void Pool::Async_CloseQueueTimer ( uv_handle_t *handle )
+{
+  delete (uv_timer_t *) handle;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Fails all queued connection requests with the given error.
+*/
+void Pool::failQueuedRequests ( const string &error )
+{
+  while ( !connRequestQueue_.empty () )
+  {
+    poolBaton *connBaton = connRequestQueue_.front ();
+    connRequestQueue_.pop_front ();
+
+    connBaton->njspool = NULL;
+    connBaton->error = error;
+    Async_AfterGetConnection ( &connBaton->req );
+  }
+
+  startQueueTimer ();
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Invoked when a connection obtained from this pool has been released.
+*/
+void Pool::connectionReleased ()
+{
+  sampleSessions ();
+
+  if ( queueRequests_ && connectionsOut_ > 0 )
+  {
+    connectionsOut_--;
+    checkRequestQueue ();
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Starts a warm-up if fewer than poolMinIdle sessions of the pool are
+     idle.
+
+   NOTES:
+     Called on the main thread after a connection is handed out, with the
+     session counts just sampled by sampleSessions.
+*/
+void Pool::checkIdleSessions ()
+{
+  unsigned int open  = connectionsOpen_;
+  unsigned int inUse = connectionsInUse_;
+
+  if ( !poolMinIdle_ || warmUpActive_ || terminating_ || !isValid_ )
+  {
+    return;
+  }
+
+  if ( open - inUse < poolMinIdle_ && open < poolMax_ )
+  {
+    warmUp ( poolMinIdle_, false );
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Queues a warm-up of the pool.
+
+   PARAMETERS:
+     numSessions - # of sessions to check out, the idle ones included
+     validate    - ping each session checked out
+
+   NOTES:
+     OCI hands out the idle sessions first, so checking out numSessions
+     sessions at once opens the ones missing. The sessions are counted in
+     connectionsOut_ while the warm-up holds them: requests made meanwhile
+     wait in the queue instead of failing when poolMax is reached.  Without
+     queueRequests they would fail, so there is no warm-up.
+*/
+void Pool::warmUp ( unsigned int numSessions, bool validate )
+{
+  if ( warmUpActive_ || terminating_ || !isValid_ || !queueRequests_ )
+  {
+    return;
+  }
+
+  if ( numSessions > poolMax_ - connectionsOut_ )
+  {
+    numSessions = poolMax_ - connectionsOut_;
+  }
+  connectionsOut_ += numSessions;
+  if ( !numSessions )
+  {
+    return;
+  }
+
+  poolBaton *warmUpBaton = new poolBaton ( Local<Function>(), handle () );
+
+  warmUpBaton->njspool     = this;
+  warmUpBaton->connClass   = oracledb_->getConnectionClass ();
+  warmUpBaton->numSessions = numSessions;
+  warmUpBaton->validate    = validate;
+  warmUpBaton->connOut     = true;
+  warmUpBaton->req.data    = (void *)warmUpBaton;
+
+  int status = ThreadPool::queueWork(&warmUpBaton->req,
+               Async_WarmUp,
+               (uv_after_work_cb)Async_AfterWarmUp);
+
+  if ( status )
+  {
+    connectionsOut_ -= numSessions;
+    delete warmUpBaton;
+    return;
+  }
+
+  warmUpActive_ = true;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Worker function of the warm-up.
+
+   PARAMETERS:
+     UV queue work block
+
+   NOTES:
+     The warm-up is best effort: it stops at the first session that cannot
+     be had (poolMax reached, database down). A session failing validation
+     is dropped when it is released, instead of going back to the pool.
+*/
+void Pool::Async_WarmUp ( uv_work_t *req )
+{
+  poolBaton *warmUpBaton = (poolBaton *)req->data;
+  std::vector<dpi::Conn *> conns;
+
+  try
+  {
+    while ( conns.size () < warmUpBaton->numSessions )
+    {
+      conns.push_back ( warmUpBaton->njspool->dpipool_->getConnection (
+                                                 warmUpBaton->connClass ) );
+      if ( warmUpBaton->validate )
+      {
+        try
+        {
+          conns.back ()->ping ();
+        }
+        catch (dpi::Exception &)
+        {
+          // ping() marks the session to be dropped on release
+        }
+      }
+    }
+  }
+  catch (dpi::Exception &e)
+  {
+    warmUpBaton->error = std::string (e.what());
+  }
+
+  for ( size_t i = 0; i < conns.size (); i++ )
+  {
+    try
+    {
+      conns[i]->release ();
+    }
+    catch (dpi::Exception &e)
+    {
+      warmUpBaton->error = std::string (e.what());
+    }
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Callback function of the warm-up.
+
+   PARAMETERS:
+     UV queue work block
+
+   NOTES:
+     Gives back the slots held in connectionsOut_ to the queued requests and
+     runs a terminate() made during the warm-up. Errors are not reported,
+     the next connection request gets them if they persist.
+*/
+void Pool::Async_AfterWarmUp ( uv_work_t *req )
+{
+  Nan::HandleScope scope;
+  poolBaton *warmUpBaton = (poolBaton *)req->data;
+  Pool      *njsPool     = warmUpBaton->njspool;
+
+  njsPool->warmUpActive_ = false;
+  njsPool->sampleSessions ();
+
+  if ( warmUpBaton->connOut )
+  {
+    njsPool->connectionsOut_ -= warmUpBaton->numSessions;
+    for ( unsigned int i = 0; i < warmUpBaton->numSessions; i++ )
+    {
+      njsPool->checkRequestQueue ();
+    }
+  }
+
+  if ( njsPool->pendingTerminate_ )
+  {
+    poolBaton *terminateBaton = njsPool->pendingTerminate_;
+    njsPool->pendingTerminate_ = NULL;
+
+    int status = ThreadPool::queueWork(&terminateBaton->req,
+                 Async_Terminate,
+                 (uv_after_work_cb)Async_AfterTerminate);
+    if ( status )
+    {
+      terminateBaton->error = NJSMessages::getErrorMsg ( errInternalError,
+                                                         "queueWork",
+                                                         "Terminate" );
+      Async_AfterTerminate ( &terminateBaton->req );
+    }
+  }
+
+  delete warmUpBaton;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Returns the connection request queue statistics of the pool.
+
+   PARAMETERS:
+     None
+*/
+NAN_METHOD(Pool::GetQueueStats)
+{
+  Pool *njsPool = Nan::ObjectWrap::Unwrap<Pool>(info.Holder());
+  NJS_CHECK_OBJECT_VALID2(njsPool, info);
+
+  Local<Object> stats = Nan::New<v8::Object>();
+
+  Nan::Set ( stats,
+             Nan::New<v8::String>("totalConnectionRequests").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->totalConnectionRequests_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("totalRequestsEnqueued").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->totalRequestsEnqueued_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("totalRequestsDequeued").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->totalRequestsDequeued_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("totalFailedRequests").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->totalFailedRequests_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("totalRequestTimeouts").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->totalRequestTimeouts_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("totalTimeInQueue").ToLocalChecked(),
+             Nan::New<v8::Number>((double) njsPool->totalTimeInQueue_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("maxQueueLength").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->maxQueueLength_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("minTimeInQueue").ToLocalChecked(),
+             Nan::New<v8::Number>((double) njsPool->minTimeInQueue_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("maxTimeInQueue").ToLocalChecked(),
+             Nan::New<v8::Number>((double) njsPool->maxTimeInQueue_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("connectionsOut").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->connectionsOut_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("queueLength").ToLocalChecked(),
+             Nan::New<v8::Number>((double) njsPool->connRequestQueue_.size ()) );
+
+  info.GetReturnValue().Set(stats);
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Samples the session counts of the pool for the statistics.
+
+   NOTES:
+     Called on the main thread. The counts are attributes of the OCI pool,
+     reading them does not need a round trip.
+*/
+void Pool::sampleSessions ()
+{
+  unsigned int open  = 0;
+  unsigned int inUse = 0;
+
+  if ( !isValid_ )
+  {
+    return;
+  }
+
+  try
+  {
+    open  = dpipool_->connectionsOpen ();
+    inUse = dpipool_->connectionsInUse ();
+  }
+  catch (dpi::Exception &)
+  {
+    return;
+  }
+
+  if ( open > connectionsOpen_ )
+  {
+    sessionsCreated_ += open - connectionsOpen_;
+  }
+  else
+  {
+    sessionsDestroyed_ += connectionsOpen_ - open;
+  }
+  connectionsOpen_  = open;
+  connectionsInUse_ = ( inUse < open ) ? inUse : open;
+
+  if ( connectionsOpen_ > maxConnectionsOpen_ )
+  {
+    maxConnectionsOpen_ = connectionsOpen_;
+  }
+  if ( connectionsInUse_ > maxConnectionsInUse_ )
+  {
+    maxConnectionsInUse_ = connectionsInUse_;
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Returns the statistics of the pool since it was created.
+
+   PARAMETERS:
+     None
+
+   NOTES:
+     The counters are maintained as connections are requested, handed out
+     and released; this only samples the session counts and copies the
+     counters, so it may be called as often as metrics are collected.
+*/
+NAN_METHOD(Pool::GetStatistics)
+{
+  Pool *njsPool = Nan::ObjectWrap::Unwrap<Pool>(info.Holder());
+  NJS_CHECK_OBJECT_VALID2(njsPool, info);
+
+  if(!njsPool->isValid_)
+  {
+    string msg = NJSMessages::getErrorMsg(errInvalidPool);
+    NJS_SET_EXCEPTION ( msg.c_str() );
+    info.GetReturnValue().SetUndefined();
+    return;
+  }
+
+  njsPool->sampleSessions ();
+
+  Local<Object> stats = Nan::New<v8::Object>();
+
+  Nan::Set ( stats,
+             Nan::New<v8::String>("connectionsOpen").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->connectionsOpen_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("connectionsInUse").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->connectionsInUse_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("maxConnectionsOpen").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->maxConnectionsOpen_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("maxConnectionsInUse").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->maxConnectionsInUse_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("sessionsCreated").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->sessionsCreated_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("sessionsDestroyed").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->sessionsDestroyed_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("connectionRequests").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->totalConnectionRequests_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("failedConnectionRequests").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->totalFailedRequests_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("requestTimeouts").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->totalRequestTimeouts_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("queueLength").ToLocalChecked(),
+             Nan::New<v8::Number>((double) njsPool->connRequestQueue_.size ()) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("maxQueueLength").ToLocalChecked(),
+             Nan::New<v8::Number>(njsPool->maxQueueLength_) );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("checkoutTime").ToLocalChecked(),
+             njsPool->checkoutTimes_.toObject () );
+  Nan::Set ( stats,
+             Nan::New<v8::String>("timeInQueue").ToLocalChecked(),
+             njsPool->queueTimes_.toObject () );
+
+  info.GetReturnValue().Set(stats);
+}
+
 /*****************************************************************************/
 /*
    DESCRIPTION
@@ -440,7 +1318,8 @@ exitGetConnection:
      UV queue work block
 
    NOTES:
-     DPI call execution.
+     DPI call execution. A session idle for poolPingInterval seconds is
+     pinged by the pool before it is handed out, see dpi PoolImpl.
 */
 void Pool::Async_GetConnection(uv_work_t *req)
 {
@@ -482,11 +1361,25 @@ void Pool::Async_AfterGetConnection(uv_work_t *req)
   Nan::TryCatch tc;
   Local<Value> argv[2];
 
+  Pool *njsPool = NULL;
+
   if(!(connBaton->error).empty())
   {
     argv[0] = v8::Exception::Error(
                      Nan::New<v8::String>(connBaton->error).ToLocalChecked());
     argv[1] = Nan::Undefined();
+
+    if ( connBaton->njspool )
+    {
+      connBaton->njspool->totalFailedRequests_++;
+
+      // The slot was not used; offer it to the next queued request
+      if ( connBaton->connOut )
+      {
+        connBaton->njspool->connectionsOut_--;
+        njsPool = connBaton->njspool;
+      }
+    }
   }
   else
   {
@@ -496,12 +1389,26 @@ void Pool::Async_AfterGetConnection(uv_work_t *req)
     (Nan::ObjectWrap::Unwrap<Connection> (connection))->
                                  setConnection( connBaton->dpiconn,
                                                 connBaton->njspool->oracledb_,
-                                                Nan::New( connBaton->jsPool ) );
+                                                Nan::New( connBaton->jsPool ),
+                                                connBaton->njspool );
     argv[1] = connection;
+
+    connBaton->njspool->checkoutTimes_.add (
+                ( uv_hrtime () - connBaton->requestTime ) / 1000000.0 );
+    connBaton->njspool->sampleSessions ();
+
+    // Open the sessions the next requests will need, if any
+    connBaton->njspool->checkIdleSessions ();
   }
 
   Local<Function> callback = Nan::New<Function>(connBaton->cb);
   delete connBaton;
+
+  if ( njsPool )
+  {
+    njsPool->checkRequestQueue ();
+  }
+
   Nan::MakeCallback( Nan::GetCurrentContext()->Global(),
                       callback, 2, argv );
 
@@ -536,20 +1443,35 @@ NAN_METHOD(Pool::Terminate)
     terminateBaton->error = NJSMessages::getErrorMsg( errInvalidPool );
     goto exitTerminate;
   }
+  // Only one terminate() can wait for the warm-up
+  if ( njsPool->pendingTerminate_ )
+  {
+    terminateBaton->error = NJSMessages::getErrorMsg( errPoolBusy );
+    goto exitTerminate;
+  }
   terminateBaton->njspool      = njsPool;
+  njsPool->terminating_        = true;
+
+  // The warm-up holds sessions of the pool; terminate once it is done
+  if ( njsPool->warmUpActive_ )
+  {
+    njsPool->pendingTerminate_ = terminateBaton;
+    info.GetReturnValue().SetUndefined();
+    return;
+  }
 
 exitTerminate:
   terminateBaton->req.data = (void *)terminateBaton;
 
-  int status = uv_queue_work(uv_default_loop(), &terminateBaton->req,
+  int status = ThreadPool::queueWork(&terminateBaton->req,
                Async_Terminate,
                (uv_after_work_cb)Async_AfterTerminate);
-  // delete the Baton if uv_queue_work fails
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete terminateBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work", "Terminate" );
+                                              "queueWork", "Terminate" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
 
@@ -612,13 +1534,19 @@ void Pool::Async_AfterTerminate(uv_work_t *req)
     argv[0] = Nan::Undefined();
     // pool is not valid after terminate succeeds.
     terminateBaton-> njspool-> isValid_ = false;
+    terminateBaton-> njspool-> failQueuedRequests (
+                           NJSMessages::getErrorMsg ( errInvalidPool ) );
   }
 
   /*
    * When we release the iLob, we have to clear the reference of
-   * its parent.
+   * its parent.  A terminate() rejected before it started has no pool.
    */
-  terminateBaton->njspool->jsParent_.Reset ();
+  if ( terminateBaton->njspool )
+  {
+    terminateBaton->njspool->terminating_ = false;
+    terminateBaton->njspool->jsParent_.Reset ();
+  }
   Local<Function> callback = Nan::New<Function>(terminateBaton->cb);
   delete terminateBaton;
   Nan::MakeCallback( Nan::GetCurrentContext()->Global(),
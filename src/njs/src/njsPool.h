@@ -55,10 +55,43 @@
 #include <node.h>
 #include "nan.h"
 #include <string>
+#include <deque>
 
 using namespace v8;
 using namespace node;
 
+struct poolBaton;
+
+// # of buckets of a PoolHistogram, the last one has no upper bound
+#define NJS_POOL_HISTOGRAM_BUCKETS  15
+
+/*
+ * Histogram of durations in milliseconds, with fixed buckets (see
+ * PoolHistogram::bounds_) so that adding a value costs a few comparisons.
+ */
+class PoolHistogram
+{
+public:
+
+  PoolHistogram ();
+
+  void add ( double ms );
+
+  // Upper bound of the bucket holding the given fraction of the values
+  double percentile ( double fraction ) const;
+
+  // count, sum, max, p50/p90/p99 and the cumulative bucket counts
+  Local<Object> toObject () const;
+
+private:
+
+  static const double bounds_[NJS_POOL_HISTOGRAM_BUCKETS - 1];
+
+  double       counts_[NJS_POOL_HISTOGRAM_BUCKETS];
+  double       count_;
+  double       sum_;
+  double       max_;
+};
 
 class Pool: public Nan::ObjectWrap {
 public:
@@ -68,7 +101,12 @@ public:
    void setPool ( dpi::SPool *, Oracledb* oracledb, unsigned int poolMax,
                   unsigned int poolMin, unsigned int poolIncrement,
                   unsigned int poolTimeout, unsigned stmtCacheSize,
-                  unsigned int lobPrefetchSize, Local<Object> jsOraDB );
+                  unsigned int lobPrefetchSize, bool queueRequests,
+                  unsigned int queueTimeout, unsigned int poolMinIdle,
+                  int poolPingInterval, Local<Object> jsOraDB );
+
+   // Invoked by Connection when a connection of this pool is released
+   void connectionReleased ();
 
    // Define Pool Constructor
    static Nan::Persistent<FunctionTemplate> poolTemplate_s ;
@@ -82,6 +120,25 @@ private:
    static void Async_GetConnection(uv_work_t* req);
    static void Async_AfterGetConnection(uv_work_t* req);
 
+   // Connection Request Queue Methods
+   static NAN_METHOD(GetQueueStats);
+   bool queueGetConnection ( poolBaton *connBaton );
+   void checkRequestQueue ();
+   void startQueueTimer ();
+   void failQueuedRequests ( const string &error );
+   static void Async_QueueTimeout ( uv_timer_t *timer );
+   static void Async_CloseQueueTimer ( uv_handle_t *handle );
+
+   // Warm-up Methods
+   void checkIdleSessions ();
+   void warmUp ( unsigned int numSessions, bool validate );
+   static void Async_WarmUp ( uv_work_t *req );
+   static void Async_AfterWarmUp ( uv_work_t *req );
+
+  // Statistics Methods
+   static NAN_METHOD(GetStatistics);
+   void sampleSessions ();
+
   // Terminate Methods
    static NAN_METHOD(Terminate);
    static void Async_Terminate(uv_work_t* req);
@@ -95,6 +152,10 @@ private:
   static NAN_GETTER(GetConnectionsOpen);
   static NAN_GETTER(GetConnectionsInUse);
   static NAN_GETTER(GetStmtCacheSize);
+  static NAN_GETTER(GetQueueRequests);
+  static NAN_GETTER(GetQueueTimeout);
+  static NAN_GETTER(GetPoolMinIdle);
+  static NAN_GETTER(GetPoolPingInterval);
 
   static Local<Primitive> getPoolProperty(Pool* njsPool, unsigned int poolProperty);
 
@@ -106,6 +167,10 @@ private:
   static NAN_SETTER(SetConnectionsOpen);
   static NAN_SETTER(SetConnectionsInUse);
   static NAN_SETTER(SetStmtCacheSize);
+  static NAN_SETTER(SetQueueRequests);
+  static NAN_SETTER(SetQueueTimeout);
+  static NAN_SETTER(SetPoolMinIdle);
+  static NAN_SETTER(SetPoolPingInterval);
 
   static void setPoolProperty(Pool* njsPool, string property);
 
@@ -122,7 +187,56 @@ private:
    unsigned int              poolTimeout_;
    unsigned int              stmtCacheSize_;
    unsigned int              lobPrefetchSize_;
+   int                       poolPingInterval_;  // seconds, < 0 = no ping
    Nan::Persistent<Object>   jsParent_;
+
+   /*
+    * Connection request queue. Requests made while poolMax connections are
+    * out wait here in FIFO order; all of them share the same queueTimeout,
+    * so the head always has the earliest deadline and one timer suffices.
+    */
+   bool                      queueRequests_;
+   unsigned int              queueTimeout_;      // milliseconds, 0 = no limit
+   unsigned int              connectionsOut_;
+   std::deque<poolBaton*>    connRequestQueue_;
+   uv_timer_t               *queueTimer_;
+
+   // Queue statistics (reported by _logStats)
+   unsigned int              totalConnectionRequests_;
+   unsigned int              totalRequestsEnqueued_;
+   unsigned int              totalRequestsDequeued_;
+   unsigned int              totalFailedRequests_;
+   unsigned int              totalRequestTimeouts_;
+   unsigned int              maxQueueLength_;
+   uint64_t                  totalTimeInQueue_;
+   uint64_t                  minTimeInQueue_;
+   uint64_t                  maxTimeInQueue_;
+
+   /*
+    * Statistics (reported by getStatistics). The session counts are
+    * sampled on the main thread when connections are handed out and
+    * released: sessions opened and closed by OCI in between are seen as
+    * the difference of connectionsOpen.
+    */
+   PoolHistogram             checkoutTimes_;     // request to callback
+   PoolHistogram             queueTimes_;
+   unsigned int              connectionsOpen_;   // last sample
+   unsigned int              connectionsInUse_;  // last sample
+   unsigned int              maxConnectionsOpen_;
+   unsigned int              maxConnectionsInUse_;
+   double                    sessionsCreated_;
+   double                    sessionsDestroyed_;
+
+   /*
+    * Warm-up. Sessions are opened ahead of demand by a worker which checks
+    * out numSessions sessions at once (so that OCI has to open the missing
+    * ones) and releases them. One warm-up runs at a time; a terminate()
+    * made meanwhile waits for it, none starts while terminate() runs.
+    */
+   unsigned int              poolMinIdle_;       // idle sessions, 0 = none
+   bool                      warmUpActive_;
+   bool                      terminating_;       // no warm-up once set
+   poolBaton                *pendingTerminate_;
 };
 
 typedef struct poolBaton
@@ -134,11 +248,19 @@ typedef struct poolBaton
   dpi::Conn*                 dpiconn;
   Pool*                      njspool;
   unsigned int               lobPrefetchSize;
+  bool                       connOut;       // counted in connectionsOut_
+  uint64_t                   enqueueTime;   // loop time when queued
+  uint64_t                   requestTime;   // uv_hrtime when requested
+  unsigned int               numSessions;   // warm-up: sessions checked out
+  bool                       validate;      // warm-up: ping the sessions
   Nan::Persistent<Object>    jsPool;
 
   poolBaton( Local<Function> callback, Local<Object> poolObj ) :
                  error(""), connClass(""),
-                 dpiconn(NULL), njspool(NULL), lobPrefetchSize(0)
+                 dpiconn(NULL), njspool(NULL), lobPrefetchSize(0),
+                 connOut(false), enqueueTime(0), requestTime(0),
+                 numSessions(0),
+                 validate(false)
   {
     cb.Reset( callback );
     jsPool.Reset ( poolObj );
@@ -51,6 +51,7 @@
 #include <string>
 #include "njsResultSet.h"
 #include "njsConnection.h"
+#include "njsThreadPool.h"
 
 #include <iostream>
 
@@ -92,6 +93,16 @@ void ResultSet::setResultSet ( dpi::Stmt          *stmt,   eBaton *executeBaton,
   this->rsEmpty_          = false;
   this->defineBuffers_    = NULL;
   this->extendedMetaData_ = executeBaton->extendedMetaData;
+  this->fetchAhead_       = executeBaton->fetchAhead && mInfo;
+  this->aheadActive_      = false;
+  this->aheadReady_       = false;
+  this->aheadBuffers_     = NULL;
+  this->aheadRowCount_    = 0;
+  this->aheadNumRows_     = 0;
+  this->aheadRowsFetched_ = 0;
+  this->pendingBaton_     = NULL;
+  this->pendingWork_      = NULL;
+  this->pendingAfter_     = NULL;
   this->mInfo_            = new MetaInfo [ this->numCols_ ];
 
   if ( !this->mInfo_ )
@@ -106,6 +117,22 @@ void ResultSet::setResultSet ( dpi::Stmt          *stmt,   eBaton *executeBaton,
     for ( unsigned int col = 0; col < this->numCols_; col++ )
     {
       this->mInfo_[col] = mInfo[col];
+
+      /*
+       * LOB and object values are processed with OCI calls while the rows
+       * are converted, so they are not fetched ahead
+       */
+      switch ( this->mInfo_[col].dbType )
+      {
+        case dpi::DpiClob:
+        case dpi::DpiBlob:
+        case dpi::DpiBfile:
+        case dpi::DpiUDT:
+          this->fetchAhead_ = false;
+          break;
+        default:
+          break;
+      }
     }
   }
 
@@ -353,17 +380,40 @@ void ResultSet::GetRowsCommon(rsBaton *getRowsBaton)
   ebaton->numCols            = njsRS->numCols_;
   ebaton->mInfo              = njsRS->mInfo_;
 
+  /*
+   * The batch fetched ahead was sized by the previous request, so the
+   * number of rows cannot change while fetching ahead
+   */
+  if ( ( njsRS->aheadActive_ || njsRS->aheadReady_ ) &&
+       getRowsBaton->numRows != njsRS->aheadNumRows_ )
+  {
+    getRowsBaton->error = NJSMessages::getErrorMsg (
+                                          errFetchAheadRowsChanged );
+    goto exitGetRowsCommon;
+  }
+
+  // Wait for the fetch ahead to complete, it queues this request
+  if ( njsRS->aheadActive_ )
+  {
+    getRowsBaton->req.data = (void *)getRowsBaton;
+    njsRS->pendingBaton_   = getRowsBaton;
+    njsRS->pendingWork_    = Async_GetRows;
+    njsRS->pendingAfter_   = (uv_after_work_cb)Async_AfterGetRows;
+    return;
+  }
+
 exitGetRowsCommon:
   getRowsBaton->req.data  = (void *)getRowsBaton;
 
-  int status = uv_queue_work(uv_default_loop(), &getRowsBaton->req,
-               Async_GetRows, (uv_after_work_cb)Async_AfterGetRows);
-  // delete the Baton if uv_queue_work fails
+  int status = ThreadPool::queueWork(&getRowsBaton->req,
+               Async_GetRows, (uv_after_work_cb)Async_AfterGetRows,
+               getRowsBaton->njsRS->njsconn_);
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete getRowsBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work",
+                                              "queueWork",
                                               "GetRowsCommon" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
@@ -389,12 +439,41 @@ void ResultSet::Async_GetRows(uv_work_t *req)
 
   if(!(getRowsBaton->error).empty()) goto exitAsyncGetRows;
 
+  if(njsRS->aheadReady_)
+  {
+    // This batch was fetched ahead, swap it in as the current buffers
+    Define       *defines  = njsRS->defineBuffers_;
+    unsigned int rowCount  = njsRS->fetchRowCount_;
+
+    Arena        *arena    = njsRS->defineArena_;
+
+    njsRS->defineBuffers_  = njsRS->aheadBuffers_;
+    njsRS->fetchRowCount_  = njsRS->aheadRowCount_;
+    njsRS->defineArena_    = njsRS->aheadArena_;
+    njsRS->aheadBuffers_   = defines;
+    njsRS->aheadRowCount_  = rowCount;
+    njsRS->aheadArena_     = arena;
+    njsRS->aheadReady_     = false;
+
+    ebaton->defines        = njsRS->defineBuffers_;
+    ebaton->rowsFetched    = njsRS->aheadRowsFetched_;
+    if ( !njsRS->aheadError_.empty () )
+    {
+      getRowsBaton->error = njsRS->aheadError_;
+      njsRS->aheadError_.clear ();
+    }
+    goto exitAsyncGetRows;
+  }
+
   if(njsRS->rsEmpty_)
   {
     ebaton->rowsFetched = 0;
     goto exitAsyncGetRows;
   }
 
+  // The fetch buffers belong to the ResultSet and are reused by getRows()
+  ebaton->defineArena = njsRS->defineArena_;
+
   try
   {
     // Allocate if not already done, or need more buffer
@@ -404,7 +483,7 @@ void ResultSet::Async_GetRows(uv_work_t *req)
       if( njsRS->defineBuffers_ )
       {
         ResultSet::clearFetchBuffer(njsRS->defineBuffers_, njsRS->numCols_,
-                                    njsRS->fetchRowCount_);
+                                    njsRS->fetchRowCount_, njsRS->defineArena_);
         getRowsBaton-> njsRS-> defineBuffers_ = NULL;
       }
       Connection::DoDefines( ebaton );
@@ -445,6 +524,13 @@ void ResultSet::Async_GetRows(uv_work_t *req)
           break;
         }
       }
+
+      // The statement may still be defined to the fetch ahead buffers
+      if ( njsRS->aheadBuffers_ )
+      {
+        ResultSet::redefine ( njsRS->dpistmt_, njsRS->defineBuffers_,
+                              njsRS->numCols_ );
+      }
     }
     ebaton->defines      = njsRS->defineBuffers_;
     Connection::DoFetch(ebaton);
@@ -499,7 +585,44 @@ void ResultSet::Async_AfterGetRows(uv_work_t *req)
 
     if(ebaton->rowsFetched)
     {
-      rowsArray = Connection::GetRows(ebaton);
+      ResultSet *njsRS = getRowsBaton->njsRS;
+      Local<Array> colNames;
+      Local<ObjectTemplate> rowTemplate;
+
+      // Fetch the next batch while this one is converted
+      if ( njsRS->fetchAhead_ && !njsRS->rsEmpty_ )
+      {
+        ResultSet::FetchAhead ( getRowsBaton );
+      }
+
+      /*
+       * Column names and the template of the OBJECT rows are built once
+       * and reused by every subsequent getRows() call on this ResultSet, so
+       * all its rows share one hidden class.
+       */
+      if ( njsRS->outFormat_ == NJS_ROWS_OBJECT ||
+           njsRS->outFormat_ == NJS_ROWS_COLUMNAR )
+      {
+        if ( njsRS->colNames_.IsEmpty () )
+        {
+          njsRS->colNames_.Reset ( Connection::GetColumnNames (
+                                               njsRS->mInfo_,
+                                               njsRS->numCols_ ) );
+          if ( njsRS->outFormat_ == NJS_ROWS_OBJECT )
+          {
+            njsRS->rowTemplate_.Reset ( Connection::GetRowTemplate (
+                                            njsRS->mInfo_, njsRS->numCols_,
+                                            Nan::New ( njsRS->colNames_ ) ) );
+          }
+        }
+        colNames = Nan::New ( njsRS->colNames_ );
+        if ( !njsRS->rowTemplate_.IsEmpty () )
+        {
+          rowTemplate = Nan::New ( njsRS->rowTemplate_ );
+        }
+      }
+
+      rowsArray = Connection::GetRows(ebaton, colNames, rowTemplate);
       if(!(ebaton->error).empty())
       {
         argv[0] = v8::Exception::Error(
@@ -507,7 +630,9 @@ void ResultSet::Async_AfterGetRows(uv_work_t *req)
         argv[1] = Nan::Undefined();
         goto exitAsyncAfterGetRows;
       }
-      rowsArrayValue =  Local<Array>::Cast(rowsArray)->Get(0);
+      // COLUMNAR results are column based, getRow() returns the columns
+      rowsArrayValue = ( njsRS->outFormat_ == NJS_ROWS_COLUMNAR ) ?
+                         rowsArray : Local<Array>::Cast(rowsArray)->Get(0);
     }
     argv[1] = (getRowsBaton->fetchMultiple) ? rowsArray : rowsArrayValue;
   }
@@ -528,6 +653,168 @@ void ResultSet::Async_AfterGetRows(uv_work_t *req)
   }
 }
 
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Start fetching the next batch of rows into the fetch ahead buffers
+
+   PARAMETERS:
+     getRowsBaton - baton of the getRow()/getRows() call being completed
+
+   NOTES:
+     Called from Async_AfterGetRows before the current batch is converted,
+     so the round trip for the next batch overlaps with the conversion.
+     The baton holds the connection busy and keeps the ResultSet object
+     alive; its callback is never invoked.
+*/
+void ResultSet::FetchAhead ( rsBaton *getRowsBaton )
+{
+  ResultSet *njsRS = getRowsBaton->njsRS;
+  rsBaton   *aheadBaton;
+  eBaton    *ebaton;
+
+  aheadBaton = new rsBaton ( njsRS->njsconn_->RSCount (),
+                             Nan::New ( getRowsBaton->ebaton->cb ),
+                             Nan::New ( getRowsBaton->jsRS ),
+                             Nan::New ( njsRS->jsParent_ ) );
+  aheadBaton->njsRS   = njsRS;
+  aheadBaton->numRows = getRowsBaton->numRows;
+
+  ebaton              = aheadBaton->ebaton;
+  ebaton->maxRows     = aheadBaton->numRows;
+  ebaton->dpistmt     = njsRS->dpistmt_;
+  ebaton->getRS       = true;
+  ebaton->dpienv      = njsRS->njsconn_->oracledb_->getDpiEnv();
+  ebaton->outFormat   = njsRS->outFormat_;
+  ebaton->njsconn     = njsRS->njsconn_;
+  ebaton->dpiconn     = njsRS->njsconn_->getDpiConn();
+  ebaton->numCols     = njsRS->numCols_;
+  ebaton->mInfo       = njsRS->mInfo_;
+
+  aheadBaton->req.data = (void *)aheadBaton;
+  njsRS->aheadActive_  = true;
+  njsRS->aheadNumRows_ = aheadBaton->numRows;
+
+  int status = ThreadPool::queueWork(&aheadBaton->req,
+               Async_FetchAhead, (uv_after_work_cb)Async_AfterFetchAhead,
+               njsRS->njsconn_);
+  // Fall back to fetching on request if queueWork fails
+  if ( status )
+  {
+    njsRS->aheadActive_ = false;
+    delete aheadBaton;
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Worker function of FetchAhead
+
+   PARAMETERS:
+     req - UV queue work block
+
+   NOTES:
+     DPI call execution.  Errors are kept and reported by the next
+     getRow()/getRows() call.
+*/
+void ResultSet::Async_FetchAhead(uv_work_t *req)
+{
+  rsBaton   *aheadBaton = (rsBaton*)req->data;
+  ResultSet *njsRS      = aheadBaton->njsRS;
+  eBaton    *ebaton     = aheadBaton->ebaton;
+
+  njsRS->aheadRowsFetched_ = 0;
+  ebaton->defineArena      = njsRS->aheadArena_;
+
+  try
+  {
+    if ( !njsRS->aheadBuffers_ ||
+         njsRS->aheadRowCount_ < aheadBaton->numRows )
+    {
+      if ( njsRS->aheadBuffers_ )
+      {
+        ResultSet::clearFetchBuffer ( njsRS->aheadBuffers_, njsRS->numCols_,
+                                      njsRS->aheadRowCount_,
+                                      njsRS->aheadArena_ );
+        njsRS->aheadBuffers_ = NULL;
+      }
+      Connection::DoDefines ( ebaton );
+      if ( !ebaton->error.empty () )
+      {
+        njsRS->aheadError_ = ebaton->error;
+        goto exitAsyncFetchAhead;
+      }
+      njsRS->aheadRowCount_ = aheadBaton->numRows;
+      njsRS->aheadBuffers_  = ebaton->defines;
+    }
+    else
+    {
+      ResultSet::redefine ( njsRS->dpistmt_, njsRS->aheadBuffers_,
+                            njsRS->numCols_ );
+    }
+    ebaton->defines = njsRS->aheadBuffers_;
+    Connection::DoFetch ( ebaton );
+    if ( !ebaton->error.empty () )
+    {
+      njsRS->aheadError_ = ebaton->error;
+      goto exitAsyncFetchAhead;
+    }
+
+    njsRS->aheadRowsFetched_ = ebaton->rowsFetched;
+    if ( ebaton->rowsFetched != aheadBaton->numRows )
+      njsRS->rsEmpty_ = true;
+  }
+  catch (dpi::Exception &e)
+  {
+    NJS_SET_CONN_ERR_STATUS ( e.errnum(), njsRS->njsconn_->getDpiConn() );
+    njsRS->aheadError_ = std::string (e.what());
+  }
+  exitAsyncFetchAhead:
+  ;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Callback function of FetchAhead
+
+   PARAMETERS:
+     req - UV queue work block
+
+   NOTES:
+     Queues the getRow()/getRows()/close() request that arrived while the
+     batch was being fetched, if any.
+*/
+void ResultSet::Async_AfterFetchAhead(uv_work_t *req)
+{
+  Nan::HandleScope scope;
+
+  rsBaton   *aheadBaton = (rsBaton*)req->data;
+  ResultSet *njsRS      = aheadBaton->njsRS;
+  rsBaton   *pending    = njsRS->pendingBaton_;
+
+  njsRS->aheadActive_  = false;
+  njsRS->aheadReady_   = true;
+  njsRS->pendingBaton_ = NULL;
+  delete aheadBaton;
+
+  if ( pending )
+  {
+    int status = ThreadPool::queueWork(&pending->req,
+                               njsRS->pendingWork_, njsRS->pendingAfter_,
+                               njsRS->njsconn_);
+    // Report the failure through the callback of the waiting request
+    if ( status )
+    {
+      pending->error = NJSMessages::getErrorMsg ( errInternalError,
+                                                  "queueWork",
+                                                  "AfterFetchAhead" );
+      njsRS->pendingAfter_ ( &pending->req, status );
+    }
+  }
+}
+
 /*****************************************************************************/
 /*
    DESCRIPTION
@@ -577,17 +864,29 @@ NAN_METHOD(ResultSet::Close)
   }
 
 
+  // Wait for the fetch ahead to complete, it queues this request
+  if ( njsResultSet->aheadActive_ )
+  {
+    closeBaton->req.data         = (void *)closeBaton;
+    njsResultSet->pendingBaton_  = closeBaton;
+    njsResultSet->pendingWork_   = Async_Close;
+    njsResultSet->pendingAfter_  = (uv_after_work_cb)Async_AfterClose;
+    info.GetReturnValue().SetUndefined();
+    return;
+  }
+
 exitClose:
   closeBaton->req.data = (void *)closeBaton;
 
-  int status = uv_queue_work(uv_default_loop(), &closeBaton->req,
-               Async_Close, (uv_after_work_cb)Async_AfterClose);
-  // delete the Baton if uv_queue_work fails
+  int status = ThreadPool::queueWork(&closeBaton->req,
+               Async_Close, (uv_after_work_cb)Async_AfterClose,
+               njsResultSet->njsconn_);
+  // delete the Baton if queueWork fails
   if ( status )
   {
     delete closeBaton;
     string error = NJSMessages::getErrorMsg ( errInternalError,
-                                              "uv_queue_work",
+                                              "queueWork",
                                               "ResultSetClose" );
     NJS_SET_EXCEPTION ( error.c_str() );
   }
@@ -621,9 +920,21 @@ void ResultSet::Async_Close(uv_work_t *req)
     if(defineBuffers)
     {
       ResultSet::clearFetchBuffer(defineBuffers, numCols,
-                                  closeBaton-> njsRS-> fetchRowCount_);
+                                  closeBaton-> njsRS-> fetchRowCount_,
+                                  closeBaton-> njsRS-> defineArena_);
       closeBaton-> njsRS-> defineBuffers_ = NULL;
     }
+    if ( closeBaton-> njsRS-> aheadBuffers_ )
+    {
+      ResultSet::clearFetchBuffer ( closeBaton-> njsRS-> aheadBuffers_,
+                                    numCols,
+                                    closeBaton-> njsRS-> aheadRowCount_,
+                                    closeBaton-> njsRS-> aheadArena_ );
+      closeBaton-> njsRS-> aheadBuffers_ = NULL;
+      closeBaton-> njsRS-> aheadReady_   = false;
+    }
+    closeBaton-> njsRS-> defineArena_-> release ();
+    closeBaton-> njsRS-> aheadArena_-> release ();
     if ( closeBaton-> njsRS-> mInfo_ )
     {
       delete [] closeBaton->njsRS->mInfo_;
@@ -678,6 +989,8 @@ void ResultSet::Async_AfterClose(uv_work_t *req)
    * its parent.
    */
   closeBaton->njsRS->jsParent_.Reset ();
+  closeBaton->njsRS->colNames_.Reset ();
+  closeBaton->njsRS->rowTemplate_.Reset ();
 
   Local<Function> callback = Nan::New(closeBaton->ebaton->cb);
   delete closeBaton;
@@ -697,9 +1010,12 @@ void ResultSet::Async_AfterClose(uv_work_t *req)
    PARAMETERS:
     defineBuffers    -  Define bufferes from njsResultSet,
     numCols          -  # of columns
+    numRows          -  # of rows
+    arena            -  arena the buffers were allocated from, its blocks
+                        are kept for the next buffers
 */
 void ResultSet::clearFetchBuffer( Define* defineBuffers, unsigned int numCols,
-                                  unsigned int numRows )
+                                  unsigned int numRows, Arena *arena )
 {
    for( unsigned int i=0; i<numCols; i++ )
    {
@@ -721,14 +1037,38 @@ void ResultSet::clearFetchBuffer( Define* defineBuffers, unsigned int numCols,
          }
        }
      }
-
-     free(defineBuffers[i].buf);
-     free(defineBuffers[i].len);
-     free(defineBuffers[i].ind);
    }
    delete [] defineBuffers;
+   arena->reset ();
    defineBuffers = NULL;
 }
 
+/*****************************************************************************/
+/*
+   DESCRIPTION
+    Define the statement to the given fetch buffers
+
+   PARAMETERS:
+    dpistmt          -  DPI statement
+    defineBuffers    -  Define buffers to fetch into
+    numCols          -  # of columns
+
+   NOTES:
+    Used when switching between the buffers of a fetch ahead ResultSet.
+    Dates are fetched into descriptor arrays, which are held in extbuf.
+*/
+void ResultSet::redefine ( dpi::Stmt* dpistmt, Define* defineBuffers,
+                           unsigned int numCols )
+{
+  for ( unsigned int col = 0; col < numCols; col++ )
+  {
+    dpistmt->define ( col + 1, defineBuffers[col].fetchType,
+                      ( defineBuffers[col].dttmarr ) ?
+                        defineBuffers[col].extbuf : defineBuffers[col].buf,
+                      defineBuffers[col].maxSize, defineBuffers[col].ind,
+                      defineBuffers[col].len, defineBuffers[col].udt );
+  }
+}
+
 /* end of file njsPool.cpp */
 
@@ -103,8 +103,15 @@ typedef struct rsBaton
 //ResultSet Class
 class ResultSet: public Nan::ObjectWrap {
 public:
-   ResultSet(){}
-   ~ResultSet(){}
+   ResultSet() : defineArena_ ( new Arena () ), aheadArena_ ( new Arena () )
+   {}
+   ~ResultSet()
+   {
+     colNames_.Reset ();
+     rowTemplate_.Reset ();
+     delete defineArena_;
+     delete aheadArena_;
+   }
 
    static void Init(Handle<Object> target);
 
@@ -126,6 +133,11 @@ private:
    static void Async_AfterGetRows(uv_work_t  *req);
    static void GetRowsCommon(rsBaton*);
 
+   // Fetch ahead Methods
+   static void FetchAhead(rsBaton*);
+   static void Async_FetchAhead(uv_work_t *req);
+   static void Async_AfterFetchAhead(uv_work_t *req);
+
    // Close Methods
    static NAN_METHOD(Close);
    static void Async_Close(uv_work_t *req);
@@ -138,7 +150,10 @@ private:
   static NAN_SETTER(SetMetaData);
 
   static void clearFetchBuffer( Define* defineBuffers,
-                                unsigned int numCols, unsigned int numRows );
+                                unsigned int numCols, unsigned int numRows,
+                                Arena *arena );
+  static void redefine( dpi::Stmt* dpistmt, Define* defineBuffers,
+                        unsigned int numCols );
 
 
   dpi::Stmt                 *dpistmt_;
@@ -147,12 +162,33 @@ private:
   State                     state_;
   bool                      rsEmpty_;
   Define                    *defineBuffers_;
+  Arena                     *defineArena_;    // defineBuffers_ buffers
   unsigned int              numCols_;
   unsigned int              fetchRowCount_;
   unsigned int              outFormat_;
   bool                      extendedMetaData_;
   Nan::Persistent<Object>   jsParent_;
   MetaInfo                  *mInfo_;
+  Nan::Persistent<Array>    colNames_;  // column names for OBJECT rows
+  Nan::Persistent<ObjectTemplate> rowTemplate_;  // of the OBJECT rows
+
+  /*
+   * With fetchAhead, the next batch is fetched into aheadBuffers_ while the
+   * current batch is converted.  A getRows()/close() request made before
+   * that fetch completes is queued once it is done.
+   */
+  bool                      fetchAhead_;
+  bool                      aheadActive_;     // fetch ahead in progress
+  bool                      aheadReady_;      // aheadBuffers_ has next batch
+  Define                    *aheadBuffers_;
+  Arena                     *aheadArena_;     // aheadBuffers_ buffers
+  unsigned int              aheadRowCount_;   // rows allocated in aheadBuffers_
+  unsigned int              aheadNumRows_;    // rows requested by fetch ahead
+  unsigned int              aheadRowsFetched_;
+  std::string               aheadError_;
+  rsBaton                   *pendingBaton_;
+  uv_work_cb                pendingWork_;
+  uv_after_work_cb          pendingAfter_;
 };
 
 
@@ -0,0 +1,102 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *  njsStringDict.cpp
+ *
+ * DESCRIPTION
+ *  StringDict class implementation.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "njsStringDict.h"
+
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Looks up a value in the dictionary, adding it if not found.
+
+   PARAMETERS:
+     str - value, must stay valid as long as the dictionary is used
+     len - # of bytes
+
+   RETURNS:
+     slot of the value, its handle is empty if the value was added;
+     NULL if the dictionary is full and the value was not found
+
+   NOTES:
+     Open addressing with linear probing; the table is never more than half
+     full.
+*/
+v8::Local<v8::String> * StringDict::lookup ( const char *str, size_t len )
+{
+  uint32_t     h    = hash ( str, len );
+  unsigned int mask = NJS_STRING_DICT_SLOTS - 1;
+  unsigned int idx  = h & mask;
+
+  if ( slots_.empty () )
+  {
+    slots_.resize ( NJS_STRING_DICT_SLOTS );
+  }
+
+  while ( slots_[idx].str )
+  {
+    Slot &slot = slots_[idx];
+
+    if ( slot.hash == h && slot.len == len &&
+         memcmp ( slot.str, str, len ) == 0 )
+    {
+      return &slot.value;
+    }
+    idx = ( idx + 1 ) & mask;
+  }
+
+  if ( count_ == NJS_STRING_DICT_MAX_VALUES )
+  {
+    return NULL;
+  }
+
+  count_++;
+  slots_[idx].str  = str;
+  slots_[idx].len  = len;
+  slots_[idx].hash = h;
+
+  return &slots_[idx].value;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     FNV-1a hash of a value.
+*/
+uint32_t StringDict::hash ( const char *str, size_t len )
+{
+  uint32_t h = 2166136261U;
+
+  for ( size_t i = 0; i < len; i++ )
+  {
+    h ^= (unsigned char) str[i];
+    h *= 16777619U;
+  }
+
+  return h;
+}
+
+
+/* end of file njsStringDict.cpp */
@@ -0,0 +1,70 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *  njsStringDict.h
+ *
+ * DESCRIPTION
+ *  StringDict class
+ *
+ *  Dictionary of the distinct values of a fetched column, so that the rows
+ *  of one batch share a single String per value.  The keys point into the
+ *  define buffer and the handles belong to the HandleScope of the caller:
+ *  a dictionary is only valid while one batch of rows is converted.
+ *
+ ******************************************************************************/
+
+#ifndef __NJSSTRINGDICT_H__
+#define __NJSSTRINGDICT_H__
+
+#include <node.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#define NJS_STRING_DICT_MAX_VALUES   256    // distinct values interned
+#define NJS_STRING_DICT_SLOTS        512    // power of 2, twice the values
+
+class StringDict
+{
+public:
+
+  StringDict () : count_ ( 0 ) {}
+
+  // Returns the slot of the value, an empty handle the first time it is
+  // seen, or NULL once the dictionary is full
+  v8::Local<v8::String> * lookup ( const char *str, size_t len );
+
+private:
+
+  typedef struct Slot
+  {
+    const char             *str;
+    size_t                  len;
+    uint32_t                hash;
+    v8::Local<v8::String>   value;
+
+    Slot () : str ( NULL ), len ( 0 ), hash ( 0 ) {}
+  } Slot;
+
+  static uint32_t hash ( const char *str, size_t len );
+
+  std::vector<Slot>  slots_;            // allocated on first lookup
+  unsigned int       count_;
+};
+
+#endif                                             /* __NJSSTRINGDICT_H__ */
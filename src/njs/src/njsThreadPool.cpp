@@ -0,0 +1,314 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *  njsThreadPool.cpp
+ *
+ * DESCRIPTION
+ *  ThreadPool class implementation.
+ *
+ *****************************************************************************/
+
+#include "njsThreadPool.h"
+
+using namespace std;
+
+unsigned int                     ThreadPool::size_    = NJS_IO_THREADS;
+bool                             ThreadPool::started_ = false;
+vector<ThreadPool::Worker*>      ThreadPool::workers_;
+map<const void*, ThreadPool::Affinity> ThreadPool::affinity_;
+unsigned int                     ThreadPool::pending_ = 0;
+uv_mutex_t                       ThreadPool::mutex_;
+deque<ThreadPool::Task*>         ThreadPool::done_;
+uv_async_t                       ThreadPool::async_;
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Sets the number of worker threads.
+
+   PARAMETERS:
+     size - number of threads, 0 to use the libuv thread pool
+
+   RETURNS:
+     false if the workers have already been started with a different size
+*/
+bool ThreadPool::setSize ( unsigned int size )
+{
+  if ( started_ )
+  {
+    return ( size == size_ );
+  }
+
+  size_ = size;
+  return true;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Queues work on a worker thread.
+
+   PARAMETERS:
+     req   - work request, req->data is passed through untouched
+     work  - function run on the worker thread
+     after - function run on the main loop once work has returned
+     key   - affinity key, work with the same key runs in queue order;
+             NULL if the work has no ordering requirement
+
+   RETURNS:
+     0 on success, non-zero otherwise (as uv_queue_work)
+*/
+int ThreadPool::queueWork ( uv_work_t *req, uv_work_cb work,
+                            uv_after_work_cb after, const void *key )
+{
+  if ( !started_ && size_ && start () )
+  {
+    size_ = 0;                      // fall back to the libuv thread pool
+  }
+
+  if ( !size_ )
+  {
+    return uv_queue_work ( uv_default_loop (), req, work, after );
+  }
+
+  Task *task  = new Task;
+  task->req   = req;
+  task->work  = work;
+  task->after = after;
+  task->key   = key;
+
+  if ( key )
+  {
+    map<const void*, Affinity>::iterator it = affinity_.find ( key );
+
+    if ( it != affinity_.end () )
+    {
+      it->second.pending++;
+      task->worker = it->second.worker;
+    }
+    else
+    {
+      task->worker = leastBusyWorker ();
+      affinity_[key].worker  = task->worker;
+      affinity_[key].pending = 1;
+    }
+  }
+  else
+  {
+    task->worker = leastBusyWorker ();
+  }
+
+  Worker *worker = workers_[task->worker];
+  worker->pending++;
+
+  // Keep the loop alive while work is outstanding
+  if ( pending_++ == 0 )
+  {
+    uv_ref ( (uv_handle_t *) &async_ );
+  }
+
+  uv_mutex_lock ( &mutex_ );
+  worker->tasks.push_back ( task );
+  uv_cond_signal ( &worker->cond );
+  uv_mutex_unlock ( &mutex_ );
+
+  return 0;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Queues work that interrupts a call running on a worker thread.
+
+   PARAMETERS:
+     req   - work request, req->data is passed through untouched
+     work  - function run on a libuv thread
+     after - function run on the main loop once work has returned
+
+   RETURNS:
+     0 on success, non-zero otherwise (as uv_queue_work)
+
+   NOTES:
+     Any worker, even the least busy one, may be running the call to
+     interrupt, or have it queued: the work goes to the libuv thread pool.
+*/
+int ThreadPool::queueInterrupt ( uv_work_t *req, uv_work_cb work,
+                                 uv_after_work_cb after )
+{
+  return uv_queue_work ( uv_default_loop (), req, work, after );
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Starts the worker threads.
+
+   RETURNS:
+     0 if at least one worker could be started
+*/
+int ThreadPool::start ()
+{
+  started_ = true;
+
+  if ( size_ > NJS_IO_THREADS_MAX )
+  {
+    size_ = NJS_IO_THREADS_MAX;
+  }
+
+  if ( uv_mutex_init ( &mutex_ ) )
+  {
+    return -1;
+  }
+
+  if ( uv_async_init ( uv_default_loop (), &async_,
+                       (uv_async_cb) Async_AfterWork ) )
+  {
+    return -1;
+  }
+  uv_unref ( (uv_handle_t *) &async_ );
+
+  for ( unsigned int i = 0; i < size_; i++ )
+  {
+    Worker *worker  = new Worker;
+    worker->pending = 0;
+
+    if ( uv_cond_init ( &worker->cond ) )
+    {
+      delete worker;
+      break;
+    }
+
+    if ( uv_thread_create ( &worker->thread, run, worker ) )
+    {
+      uv_cond_destroy ( &worker->cond );
+      delete worker;
+      break;
+    }
+
+    workers_.push_back ( worker );
+  }
+
+  size_ = (unsigned int) workers_.size ();
+
+  return workers_.empty () ? -1 : 0;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Returns the index of the worker with the least outstanding work.
+*/
+unsigned int ThreadPool::leastBusyWorker ()
+{
+  unsigned int idx = 0;
+
+  for ( unsigned int i = 1; i < workers_.size (); i++ )
+  {
+    if ( workers_[i]->pending < workers_[idx]->pending )
+    {
+      idx = i;
+    }
+  }
+
+  return idx;
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Main function of a worker thread.
+
+   PARAMETERS:
+     arg - Worker
+
+   NOTES:
+     Workers run until the process exits.
+*/
+void ThreadPool::run ( void *arg )
+{
+  Worker *worker = (Worker *) arg;
+
+  for ( ;; )
+  {
+    uv_mutex_lock ( &mutex_ );
+    while ( worker->tasks.empty () )
+    {
+      uv_cond_wait ( &worker->cond, &mutex_ );
+    }
+    Task *task = worker->tasks.front ();
+    worker->tasks.pop_front ();
+    uv_mutex_unlock ( &mutex_ );
+
+    task->work ( task->req );
+
+    uv_mutex_lock ( &mutex_ );
+    done_.push_back ( task );
+    uv_mutex_unlock ( &mutex_ );
+
+    uv_async_send ( &async_ );
+  }
+}
+
+/*****************************************************************************/
+/*
+   DESCRIPTION
+     Runs the after-work functions of completed tasks on the main loop.
+
+   PARAMETERS:
+     async - completion handle
+*/
+void ThreadPool::Async_AfterWork ( uv_async_t *async )
+{
+  deque<Task*> done;
+
+  uv_mutex_lock ( &mutex_ );
+  done.swap ( done_ );
+  uv_mutex_unlock ( &mutex_ );
+
+  while ( !done.empty () )
+  {
+    Task *task = done.front ();
+    done.pop_front ();
+
+    workers_[task->worker]->pending--;
+
+    if ( task->key )
+    {
+      map<const void*, Affinity>::iterator it = affinity_.find ( task->key );
+
+      if ( it != affinity_.end () && --it->second.pending == 0 )
+      {
+        affinity_.erase ( it );
+      }
+    }
+
+    if ( --pending_ == 0 )
+    {
+      uv_unref ( (uv_handle_t *) &async_ );
+    }
+
+    uv_work_t        *req   = task->req;
+    uv_after_work_cb  after = task->after;
+    delete task;
+
+    // The after-work function may queue more work
+    after ( req, 0 );
+  }
+}
+
+/* end of file njsThreadPool.cpp */
@@ -0,0 +1,108 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * NAME
+ *  njsThreadPool.h
+ *
+ * DESCRIPTION
+ *  ThreadPool class
+ *
+ *  Worker threads owned by the driver which run the blocking OCI calls of
+ *  the Async_* methods, so that they do not compete with fs, dns and crypto
+ *  requests for the libuv thread pool. The interface follows uv_queue_work:
+ *  the work function runs on a worker thread and the after-work function
+ *  runs on the main loop.
+ *
+ *  Work queued with the same affinity key (a Connection) runs on the same
+ *  worker for as long as the key has outstanding work, so calls made on one
+ *  connection complete in the order they were made. Work without a key goes
+ *  to the least busy worker. Work interrupting a call, such as a break, runs
+ *  on the libuv thread pool so that it never waits behind that call.
+ *
+ ******************************************************************************/
+
+#ifndef __NJSTHREADPOOL_H__
+#define __NJSTHREADPOOL_H__
+
+#include <uv.h>
+#include <deque>
+#include <vector>
+#include <map>
+
+#define NJS_IO_THREADS              4
+#define NJS_IO_THREADS_MAX        128
+
+class ThreadPool
+{
+public:
+
+  // Queues work; returns 0 on success like uv_queue_work
+  static int queueWork ( uv_work_t *req, uv_work_cb work,
+                         uv_after_work_cb after, const void *key = NULL );
+
+  // Queues work which must not wait behind the queued work
+  static int queueInterrupt ( uv_work_t *req, uv_work_cb work,
+                              uv_after_work_cb after );
+
+  // Number of worker threads; 0 runs work on the libuv thread pool
+  static unsigned int getSize ()   { return size_; }
+
+  // Returns false once the workers have been started with another size
+  static bool setSize ( unsigned int size );
+
+private:
+
+  typedef struct Task
+  {
+    uv_work_t        *req;
+    uv_work_cb        work;
+    uv_after_work_cb  after;
+    const void       *key;
+    unsigned int      worker;
+  } Task;
+
+  typedef struct Worker
+  {
+    uv_thread_t        thread;
+    uv_cond_t          cond;           // signalled when a task is queued
+    std::deque<Task*>  tasks;          // protected by mutex_
+    unsigned int       pending;        // queued or running, main loop only
+  } Worker;
+
+  typedef struct Affinity
+  {
+    unsigned int       worker;
+    unsigned int       pending;
+  } Affinity;
+
+  static int  start ();
+  static unsigned int leastBusyWorker ();
+  static void run ( void *arg );
+  static void Async_AfterWork ( uv_async_t *async );
+
+  static unsigned int                      size_;
+  static bool                              started_;
+  static std::vector<Worker*>              workers_;
+  static std::map<const void*, Affinity>   affinity_;   // main loop only
+  static unsigned int                      pending_;    // main loop only
+
+  static uv_mutex_t                        mutex_;
+  static std::deque<Task*>                 done_;       // protected by mutex_
+  static uv_async_t                        async_;
+};
+
+#endif                                        /* __NJSTHREADPOOL_H__ */
@@ -87,7 +87,8 @@ typedef enum
 {
   NJS_ROWS_UNKNOWN  = -1,
   NJS_ROWS_ARRAY    = 4001,
-  NJS_ROWS_OBJECT   = 4002
+  NJS_ROWS_OBJECT   = 4002,
+  NJS_ROWS_COLUMNAR = 4003
 }RowsType;
 
 // states
@@ -317,6 +318,37 @@ private:
   }                                                                           \
 }
 
+/*
+ * Get the int value from JSON for the given key.
+ * index is the argument index in the caller.
+ * DO NOT SET ANY VALUE to val IF NULL OR UNDEFINED
+ */
+#define NJS_GET_INT_FROM_JSON( val, err, obj, key, index, exitCode )          \
+{                                                                             \
+  Local<Value> v8value = obj->Get(Nan::New<v8::String>(key).ToLocalChecked());\
+  err.clear();                                                                \
+  if( v8value->IsInt32() )                                                    \
+  {                                                                           \
+    val = v8value->ToInt32()->Value();                                        \
+  }                                                                           \
+  else if(v8value->IsUndefined())                                             \
+  {                                                                           \
+    ;                                                                         \
+  }                                                                           \
+  else if(v8value->IsNumber())                                                \
+  {                                                                           \
+    err = NJSMessages::getErrorMsg ( errInvalidPropertyValueInParam,          \
+                                     key, index+1 );                          \
+    goto exitCode;                                                            \
+  }                                                                           \
+  else                                                                        \
+  {                                                                           \
+    err = NJSMessages::getErrorMsg ( errInvalidPropertyTypeInParam,           \
+                                     key, index+1 );                          \
+    goto exitCode;                                                            \
+  }                                                                           \
+}
+
 /*
  * Get the boolean value from JSON for the given key.
  * index is the argument index in the caller.
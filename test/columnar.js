@@ -0,0 +1,242 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The node-oracledb test suite uses 'mocha', 'should' and 'async'.
+ * See LICENSE.md for relevant licenses.
+ *
+ * NAME
+ *   71. columnar.js
+ *
+ * DESCRIPTION
+ *   Testing the COLUMNAR outFormat.
+ *
+ * NUMBERING RULE
+ *   Test numbers follow this numbering rule:
+ *     1  - 20  are reserved for basic functional tests
+ *     21 - 50  are reserved for data type supporting tests
+ *     51 onwards are for other tests
+ *
+ *****************************************************************************/
+'use strict';
+
+var oracledb = require('oracledb');
+var should   = require('should');
+var async    = require('async');
+var dbConfig = require('./dbconfig.js');
+
+describe('71. columnar.js', function() {
+
+  var connection = null;
+  var created = new Date(2016, 5, 30, 12, 34, 56);
+  var rows = [
+    [1, 'one', created],
+    [2, null, null],
+    [null, 'three', created]
+  ];
+
+  var isNull = function(column, row) {
+    return (column.nulls[Math.floor(row / 8)] & (1 << (row % 8))) !== 0;
+  };
+
+  before(function(done) {
+
+    async.series([
+      function getConn(cb) {
+        oracledb.getConnection(
+          dbConfig,
+          function(err, conn) {
+            should.not.exist(err);
+            connection = conn;
+            cb();
+          }
+        );
+      },
+      function createTab(cb) {
+        var proc = "BEGIN \n" +
+                   "    DECLARE \n" +
+                   "        e_table_missing EXCEPTION; \n" +
+                   "        PRAGMA EXCEPTION_INIT(e_table_missing, -00942); \n" +
+                   "    BEGIN \n" +
+                   "        EXECUTE IMMEDIATE('DROP TABLE nodb_columnar'); \n" +
+                   "    EXCEPTION \n" +
+                   "        WHEN e_table_missing \n" +
+                   "        THEN NULL; \n" +
+                   "    END; \n" +
+                   "    EXECUTE IMMEDIATE (' \n" +
+                   "        CREATE TABLE nodb_columnar ( \n" +
+                   "            num      NUMBER, \n" +
+                   "            content  VARCHAR2(20), \n" +
+                   "            created  DATE \n" +
+                   "        ) \n" +
+                   "    '); \n" +
+                   "END; ";
+
+        connection.execute(
+          proc,
+          function(err) {
+            should.not.exist(err);
+            cb();
+          }
+        );
+      },
+      function insertRows(cb) {
+        connection.executeMany(
+          "INSERT INTO nodb_columnar VALUES (:1, :2, :3)",
+          rows,
+          { autoCommit: true },
+          function(err) {
+            should.not.exist(err);
+            cb();
+          }
+        );
+      }
+    ], done);
+
+  }); // before
+
+  after(function(done) {
+    async.series([
+      function(cb) {
+        connection.execute(
+          "DROP TABLE nodb_columnar",
+          function(err) {
+            should.not.exist(err);
+            cb();
+          }
+        );
+      },
+      function(cb) {
+        connection.release(function(err) {
+          should.not.exist(err);
+          cb();
+        });
+      }
+    ], done);
+  }); // after
+
+  var checkColumns = function(columns) {
+    (columns.length).should.eql(3);
+    (columns[0].name).should.eql('NUM');
+    (columns[1].name).should.eql('CONTENT');
+    (columns[2].name).should.eql('CREATED');
+
+    (columns[0].values.length).should.eql(3);
+    (columns[0].values[0]).should.eql(1);
+    (columns[0].values[1]).should.eql(2);
+    isNaN(columns[0].values[2]).should.be.true();
+    isNull(columns[0], 0).should.be.false();
+    isNull(columns[0], 2).should.be.true();
+
+    (columns[1].values).should.eql(['one', null, 'three']);
+    isNull(columns[1], 1).should.be.true();
+    isNull(columns[1], 2).should.be.false();
+
+    (columns[2].values[0]).should.eql(created.getTime());
+    isNaN(columns[2].values[1]).should.be.true();
+    isNull(columns[2], 1).should.be.true();
+  };
+
+  it('71.1 returns the rows of a query as columns', function(done) {
+    connection.execute(
+      "SELECT num, content, created FROM nodb_columnar ORDER BY num",
+      [],
+      { outFormat: oracledb.COLUMNAR },
+      function(err, result) {
+        should.not.exist(err);
+        checkColumns(result.rows);
+        done();
+      }
+    );
+  }); // 71.1
+
+  it('71.2 returns NUMBER columns as Float64Array', function(done) {
+    if (typeof Float64Array === 'undefined' ||
+        process.versions.node.split('.')[0] < 4) {
+      return done();
+    }
+
+    connection.execute(
+      "SELECT num FROM nodb_columnar ORDER BY num",
+      [],
+      { outFormat: oracledb.COLUMNAR },
+      function(err, result) {
+        should.not.exist(err);
+        (result.rows[0].values).should.be.an.instanceOf(Float64Array);
+        (result.rows[0].nulls).should.be.an.instanceOf(Buffer);
+        done();
+      }
+    );
+  }); // 71.2
+
+  it('71.3 returns empty columns when no rows are selected', function(done) {
+    connection.execute(
+      "SELECT num, content FROM nodb_columnar WHERE 1 = 0",
+      [],
+      { outFormat: oracledb.COLUMNAR },
+      function(err, result) {
+        should.not.exist(err);
+        (result.rows.length).should.eql(2);
+        (result.rows[0].values.length).should.eql(0);
+        (result.rows[1].values.length).should.eql(0);
+        done();
+      }
+    );
+  }); // 71.3
+
+  it('71.4 fetches columns from a ResultSet', function(done) {
+    connection.execute(
+      "SELECT num, content, created FROM nodb_columnar ORDER BY num",
+      [],
+      { outFormat: oracledb.COLUMNAR, resultSet: true },
+      function(err, result) {
+        should.not.exist(err);
+
+        result.resultSet.getRows(10, function(err, columns) {
+          should.not.exist(err);
+          checkColumns(columns);
+
+          result.resultSet.getRows(10, function(err, columns) {
+            should.not.exist(err);
+            (columns).should.eql([]);
+            result.resultSet.close(done);
+          });
+        });
+      }
+    );
+  }); // 71.4
+
+  it('71.5 fetches one row as columns with getRow()', function(done) {
+    connection.execute(
+      "SELECT num, content FROM nodb_columnar ORDER BY num",
+      [],
+      { outFormat: oracledb.COLUMNAR, resultSet: true },
+      function(err, result) {
+        should.not.exist(err);
+
+        result.resultSet.getRow(function(err, columns) {
+          should.not.exist(err);
+          (columns.length).should.eql(2);
+          (columns[0].values.length).should.eql(1);
+          (columns[0].values[0]).should.eql(1);
+          (columns[1].values[0]).should.eql('one');
+          result.resultSet.close(done);
+        });
+      }
+    );
+  }); // 71.5
+
+});
@@ -528,6 +528,57 @@ describe('1. connection.js', function(){
       ], done);
     })
 
+    it('1.4.3 re-executed query sees a column renamed by another connection', function(done) {
+      connection.should.be.ok();
+      var sql = "SELECT * FROM nodb_conn_emp4 WHERE id = 1001";
+      var conn2 = false;
+
+      var query = function(colName, callback) {
+        connection.execute(
+          sql,
+          [],
+          { outFormat: oracledb.OBJECT },
+          function(err, result) {
+            should.not.exist(err);
+            (result.metaData[1].name).should.eql(colName);
+            (result.rows[0][colName]).should.eql('Chris Jones');
+            callback();
+          }
+        );
+      };
+
+      async.series([
+        function(callback) {
+          query('NAME', callback);
+        },
+        function(callback) {
+          query('NAME', callback);
+        },
+        function(callback) {
+          oracledb.getConnection(credentials, function(err, conn) {
+            should.not.exist(err);
+            conn2 = conn;
+            conn2.execute(
+              "ALTER TABLE nodb_conn_emp4 RENAME COLUMN name TO ename",
+              function(err) {
+                should.not.exist(err);
+                callback();
+              }
+            );
+          });
+        },
+        function(callback) {
+          query('ENAME', callback);
+        },
+        function(callback) {
+          conn2.release(function(err) {
+            should.not.exist(err);
+            callback();
+          });
+        }
+      ], done);
+    })
+
   })
 
   describe('1.5 Testing commit() & rollback() functions', function() {
@@ -913,4 +964,41 @@ describe('1. connection.js', function(){
     });
   });
 
+  describe('1.8 break() method', function() {
+    it('1.8.1 interrupts a long call when ioThreads is 1', function(done) {
+      // ioThreads is fixed by the first database call of this process
+      var script =
+        "var oracledb = require(" + JSON.stringify(require.resolve('oracledb')) + ");" +
+        "var dbConfig = require(" + JSON.stringify(require.resolve('./dbconfig.js')) + ");" +
+        "oracledb.ioThreads = 1;" +
+        "oracledb.getConnection(dbConfig, function(err, conn) {" +
+        "  if (err) { console.log(err.message); process.exit(1); }" +
+        "  var start = Date.now();" +
+        "  conn.execute(" +
+        "    \"DECLARE t TIMESTAMP := SYSTIMESTAMP; \" +" +
+        "    \"BEGIN LOOP EXIT WHEN SYSTIMESTAMP > t + INTERVAL '60' SECOND; END LOOP; END;\"," +
+        "    function(err) {" +
+        "      console.log((err ? err.message : 'completed') + ' after ' + (Date.now() - start));" +
+        "      conn.release(function() { process.exit(0); });" +
+        "    });" +
+        "  setTimeout(function() {" +
+        "    conn.break(function(err) { if (err) console.log(err.message); });" +
+        "  }, 2000);" +
+        "});";
+
+      require('child_process').execFile(
+        process.execPath,
+        [ '-e', script ],
+        { cwd: __dirname },
+        function(err, stdout) {
+          should.not.exist(err);
+          // ORA-01013: user requested cancel of current operation
+          stdout.should.startWith('ORA-01013');
+          parseInt(stdout.split(' after ')[1]).should.be.below(30000);
+          done();
+        }
+      );
+    });
+  });
+
 });
@@ -79,6 +79,7 @@ describe('18. constants.js', function() {
     (oracledb.BIND_OUT).should.be.exactly(3003);
     (oracledb.ARRAY).should.be.exactly(4001);
     (oracledb.OBJECT).should.be.exactly(4002);
+    (oracledb.COLUMNAR).should.be.exactly(4003);
 
   });
 
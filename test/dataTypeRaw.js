@@ -402,4 +402,82 @@ describe('42. dataTypeRaw.js', function() {
     })
   }) // 42.4
 
+  describe('42.5 RAW values of queries are slices of the fetch buffer', function() {
+    var sliceTable = "nodb_raw_slice";
+
+    // Buffers are Uint8Arrays sharing an ArrayBuffer from Node.js 4 onwards
+    var slicing = parseInt(process.versions.node.split('.')[0]) >= 4;
+
+    before('create table, insert data', function(done) {
+      var sql = "BEGIN \n" +
+                "  EXECUTE IMMEDIATE 'CREATE TABLE " + sliceTable +
+                " (id NUMBER, content RAW(16), small RAW(2000))'; \n" +
+                "  FOR i IN 1..3 LOOP \n" +
+                "    INSERT INTO " + sliceTable + " VALUES (i, \n" +
+                "      HEXTORAW('0123456789ABCDEF0123456789ABCDE' || i), \n" +
+                "      HEXTORAW('0' || i)); \n" +
+                "  END LOOP; \n" +
+                "END;";
+
+      connection.execute(sql, [], { autoCommit: true }, function(err) {
+        should.not.exist(err);
+        done();
+      });
+    })
+
+    after(function(done) {
+      connection.execute(
+        "DROP TABLE " + sliceTable,
+        function(err) {
+          should.not.exist(err);
+          done();
+        }
+      );
+    })
+
+    it('42.5.1 repeated queries get slices with the default stmtCacheSize', function(done) {
+      if (!slicing) return done();
+      (oracledb.stmtCacheSize).should.eql(30);
+
+      var query = function(callback) {
+        connection.execute(
+          "SELECT content FROM " + sliceTable + " ORDER BY id",
+          function(err, result) {
+            should.not.exist(err);
+            result.rows.length.should.eql(3);
+            for (var i = 0; i < 3; i++) {
+              var value = result.rows[i][0];
+              value.length.should.eql(16);
+              value[15].should.eql(0xE0 + i + 1);
+              (value.buffer === result.rows[0][0].buffer).should.be.true();
+              value.byteOffset.should.eql(result.rows[0][0].byteOffset + i * 16);
+            }
+            callback();
+          }
+        );
+      };
+
+      async.series([ query, query, query ], done);
+    })
+
+    it('42.5.2 short values are copied rather than keep the fetch buffer', function(done) {
+      connection.execute(
+        "SELECT small FROM " + sliceTable + " ORDER BY id",
+        function(err, result) {
+          should.not.exist(err);
+          result.rows.length.should.eql(3);
+          for (var i = 0; i < 3; i++) {
+            var value = result.rows[i][0];
+            value.length.should.eql(1);
+            value[0].should.eql(i + 1);
+            if (slicing && i > 0)
+              (value.buffer === result.rows[0][0].buffer).should.be.false();
+          }
+          done();
+        }
+      );
+    })
+
+  }) // 42.5
+
 })
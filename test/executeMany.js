@@ -0,0 +1,376 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The node-oracledb test suite uses 'mocha', 'should' and 'async'.
+ * See LICENSE.md for relevant licenses.
+ *
+ * NAME
+ *   70. executeMany.js
+ *
+ * DESCRIPTION
+ *   Testing connection.executeMany() for array DML execution.
+ *
+ * NUMBERING RULE
+ *   Test numbers follow this numbering rule:
+ *     1  - 20  are reserved for basic functional tests
+ *     21 - 50  are reserved for data type supporting tests
+ *     51 onwards are for other tests
+ *
+ *****************************************************************************/
+'use strict';
+
+var oracledb = require('oracledb');
+var should   = require('should');
+var async    = require('async');
+var dbConfig = require('./dbconfig.js');
+
+describe('70. executeMany.js', function() {
+
+  var connection = null;
+  before(function(done) {
+
+    async.series([
+      function getConn(cb) {
+        oracledb.getConnection(
+          dbConfig,
+          function(err, conn) {
+            should.not.exist(err);
+            connection = conn;
+            cb();
+          }
+        );
+      },
+      function createTab(cb) {
+        var proc = "BEGIN \n" +
+                   "    DECLARE \n" +
+                   "        e_table_missing EXCEPTION; \n" +
+                   "        PRAGMA EXCEPTION_INIT(e_table_missing, -00942); \n" +
+                   "    BEGIN \n" +
+                   "        EXECUTE IMMEDIATE('DROP TABLE nodb_execmany'); \n" +
+                   "    EXCEPTION \n" +
+                   "        WHEN e_table_missing \n" +
+                   "        THEN NULL; \n" +
+                   "    END; \n" +
+                   "    EXECUTE IMMEDIATE (' \n" +
+                   "        CREATE TABLE nodb_execmany ( \n" +
+                   "            id       NUMBER PRIMARY KEY, \n" +
+                   "            content  VARCHAR2(20), \n" +
+                   "            created  DATE, \n" +
+                   "            bin      RAW(20) \n" +
+                   "        ) \n" +
+                   "    '); \n" +
+                   "END; ";
+
+        connection.execute(
+          proc,
+          function(err) {
+            should.not.exist(err);
+            cb();
+          }
+        );
+      }
+    ], done);
+
+  }); // before
+
+  after(function(done) {
+    async.series([
+      function(cb) {
+        connection.execute(
+          "DROP TABLE nodb_execmany",
+          function(err) {
+            should.not.exist(err);
+            cb();
+          }
+        );
+      },
+      function(cb) {
+        connection.release(function(err) {
+          should.not.exist(err);
+          cb();
+        });
+      }
+    ], done);
+  }); // after
+
+  afterEach(function(done) {
+    connection.execute(
+      "DELETE FROM nodb_execmany",
+      [],
+      { autoCommit: true },
+      function(err) {
+        should.not.exist(err);
+        done();
+      }
+    );
+  }); // afterEach
+
+  var checkRowCount = function(expected, callback) {
+    connection.execute(
+      "SELECT COUNT(*) FROM nodb_execmany",
+      function(err, result) {
+        should.not.exist(err);
+        (result.rows[0][0]).should.eql(expected);
+        callback();
+      }
+    );
+  };
+
+  it('70.1 inserts rows bound by position', function(done) {
+    var rows = [
+      [1, 'one', new Date(2016, 0, 1), new Buffer('aa')],
+      [2, 'two', null, null],
+      [3, null, new Date(2016, 2, 3), new Buffer('cc')]
+    ];
+
+    connection.executeMany(
+      "INSERT INTO nodb_execmany VALUES (:1, :2, :3, :4)",
+      rows,
+      function(err, result) {
+        should.not.exist(err);
+        (result.rowsAffected).should.eql(3);
+        (result.batchRowsAffected).should.eql([3]);
+        should.not.exist(result.batchErrors);
+
+        connection.execute(
+          "SELECT id, content, created, bin FROM nodb_execmany ORDER BY id",
+          function(err, result) {
+            should.not.exist(err);
+            (result.rows.length).should.eql(3);
+            (result.rows[0][1]).should.eql('one');
+            (result.rows[0][2]).should.eql(rows[0][2]);
+            (result.rows[0][3]).should.eql(rows[0][3]);
+            should.not.exist(result.rows[1][2]);
+            should.not.exist(result.rows[2][1]);
+            done();
+          }
+        );
+      }
+    );
+  }); // 70.1
+
+  it('70.2 inserts rows bound by name in several batches', function(done) {
+    var rows = [];
+
+    for (var i = 1; i <= 25; i++) {
+      rows.push({ id: i, content: 'row ' + i });
+    }
+
+    connection.executeMany(
+      "INSERT INTO nodb_execmany (id, content) VALUES (:id, :content)",
+      rows,
+      { batchSize: 10 },
+      function(err, result) {
+        should.not.exist(err);
+        (result.rowsAffected).should.eql(25);
+        (result.batchRowsAffected).should.eql([10, 10, 5]);
+        checkRowCount(25, done);
+      }
+    );
+  }); // 70.2
+
+  it('70.3 reports the failed rows with batchErrors', function(done) {
+    var rows = [ [1, 'a'], [2, 'b'], [1, 'duplicate'], [3, 'c'], [2, 'duplicate'] ];
+
+    connection.executeMany(
+      "INSERT INTO nodb_execmany (id, content) VALUES (:1, :2)",
+      rows,
+      { batchErrors: true, batchSize: 4 },
+      function(err, result) {
+        should.not.exist(err);
+        (result.rowsAffected).should.eql(3);
+        (result.batchErrors.length).should.eql(2);
+        (result.batchErrors[0].offset).should.eql(2);
+        (result.batchErrors[0].errorNum).should.eql(1);
+        (result.batchErrors[0].message).should.startWith('ORA-00001');
+        (result.batchErrors[1].offset).should.eql(4);
+        checkRowCount(3, done);
+      }
+    );
+  }); // 70.3
+
+  it('70.4 fails the whole execution without batchErrors', function(done) {
+    var rows = [ [1, 'a'], [1, 'duplicate'] ];
+
+    connection.executeMany(
+      "INSERT INTO nodb_execmany (id, content) VALUES (:1, :2)",
+      rows,
+      function(err, result) {
+        should.exist(err);
+        (err.message).should.startWith('ORA-00001');
+        should.not.exist(result);
+        connection.rollback(function(err) {
+          should.not.exist(err);
+          checkRowCount(0, done);
+        });
+      }
+    );
+  }); // 70.4
+
+  it('70.5 uses bindDefs when the first values are null', function(done) {
+    var rows = [ { id: 1, content: null }, { id: 2, content: 'a longer value' } ];
+
+    connection.executeMany(
+      "INSERT INTO nodb_execmany (id, content) VALUES (:id, :content)",
+      rows,
+      { bindDefs: { content: { type: oracledb.STRING, maxSize: 20 } } },
+      function(err, result) {
+        should.not.exist(err);
+        (result.rowsAffected).should.eql(2);
+        checkRowCount(2, done);
+      }
+    );
+  }); // 70.5
+
+  it('70.6 rejects rows of mixed types', function(done) {
+    connection.executeMany(
+      "INSERT INTO nodb_execmany (id, content) VALUES (:1, :2)",
+      [ [1, 'a'], { id: 2, content: 'b' } ],
+      function(err) {
+        should.exist(err);
+        (err.message).should.startWith('NJS-048');
+        done();
+      }
+    );
+  }); // 70.6
+
+  it('70.7 rejects incompatible values for one bind variable', function(done) {
+    connection.executeMany(
+      "INSERT INTO nodb_execmany (id, content) VALUES (:1, :2)",
+      [ [1, 'a'], [2, 3] ],
+      function(err) {
+        should.exist(err);
+        (err.message).should.startWith('NJS-037');
+        done();
+      }
+    );
+  }); // 70.7
+
+  it('70.8 does not allow queries', function(done) {
+    connection.executeMany(
+      "SELECT * FROM nodb_execmany WHERE id = :1",
+      [ [1], [2] ],
+      function(err) {
+        should.exist(err);
+        (err.message).should.startWith('NJS-049');
+        done();
+      }
+    );
+  }); // 70.8
+
+  it('70.9 rejects an empty array of rows', function(done) {
+    connection.executeMany(
+      "INSERT INTO nodb_execmany (id) VALUES (:1)",
+      [],
+      function(err) {
+        should.exist(err);
+        (err.message).should.startWith('NJS-039');
+        done();
+      }
+    );
+  }); // 70.9
+
+  it('70.10 returns the values of RETURNING INTO for each row', function(done) {
+    var rows = [ { id: 1, content: 'a' }, { id: 2, content: 'b' } ];
+
+    connection.executeMany(
+      "INSERT INTO nodb_execmany (id, content) VALUES (:id, :content) " +
+      "RETURNING id, content INTO :rid, :rcontent",
+      rows,
+      {
+        bindDefs: {
+          rid:      { dir: oracledb.BIND_OUT, type: oracledb.NUMBER },
+          rcontent: { dir: oracledb.BIND_OUT, type: oracledb.STRING, maxSize: 20 }
+        }
+      },
+      function(err, result) {
+        should.not.exist(err);
+        (result.rowsAffected).should.eql(2);
+        (result.outBinds.rid).should.eql([ [1], [2] ]);
+        (result.outBinds.rcontent).should.eql([ ['a'], ['b'] ]);
+        done();
+      }
+    );
+  }); // 70.10
+
+  it('70.11 returns several rows per execution up to maxArraySize', function(done) {
+    async.series([
+      function(cb) {
+        connection.executeMany(
+          "INSERT INTO nodb_execmany (id, content) VALUES (:1, :2)",
+          [ [1, 'x'], [2, 'x'], [3, 'y'] ],
+          cb
+        );
+      },
+      function(cb) {
+        connection.executeMany(
+          "UPDATE nodb_execmany SET content = content || 'z' " +
+          "WHERE content = :1 RETURNING id INTO :2",
+          [ ['x'], ['y'], ['none'] ],
+          {
+            bindDefs: [ null, { dir: oracledb.BIND_OUT, type: oracledb.NUMBER, maxArraySize: 5 } ],
+            batchSize: 2
+          },
+          function(err, result) {
+            should.not.exist(err);
+            (result.rowsAffected).should.eql(3);
+            (result.outBinds[0]).should.eql([ [1, 2], [3], [] ]);
+            cb();
+          }
+        );
+      }
+    ], done);
+  }); // 70.11
+
+  it('70.12 rejects more returned rows than maxArraySize', function(done) {
+    async.series([
+      function(cb) {
+        connection.executeMany(
+          "INSERT INTO nodb_execmany (id, content) VALUES (:1, :2)",
+          [ [1, 'x'], [2, 'x'] ],
+          cb
+        );
+      },
+      function(cb) {
+        connection.executeMany(
+          "DELETE FROM nodb_execmany WHERE content = :c RETURNING id INTO :rid",
+          [ { c: 'x' } ],
+          { bindDefs: { rid: { dir: oracledb.BIND_OUT, type: oracledb.NUMBER, maxArraySize: 1 } } },
+          function(err) {
+            should.exist(err);
+            (err.message).should.startWith('NJS-053');
+            cb();
+          }
+        );
+      }
+    ], done);
+  }); // 70.12
+
+  it('70.13 requires RETURNING INTO for OUT binds', function(done) {
+    connection.executeMany(
+      "INSERT INTO nodb_execmany (id) VALUES (:id)",
+      [ { id: 1 } ],
+      { bindDefs: { rid: { dir: oracledb.BIND_OUT, type: oracledb.NUMBER } } },
+      function(err) {
+        should.exist(err);
+        (err.message).should.startWith('NJS-052');
+        done();
+      }
+    );
+  }); // 70.13
+
+});
@@ -0,0 +1,245 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved. */
+
+/******************************************************************************
+ *
+ * You may not use the identified files except in compliance with the Apache
+ * License, Version 2.0 (the "License.")
+ *
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The node-oracledb test suite uses 'mocha', 'should' and 'async'.
+ * See LICENSE.md for relevant licenses.
+ *
+ * NAME
+ *   72. fetchAhead.js
+ *
+ * DESCRIPTION
+ *   Testing the fetchAhead option of ResultSets.
+ *
+ * NUMBERING RULE
+ *   Test numbers follow this numbering rule:
+ *     1  - 20  are reserved for basic functional tests
+ *     21 - 50  are reserved for data type supporting tests
+ *     51 onwards are for other tests
+ *
+ *****************************************************************************/
+'use strict';
+
+var oracledb = require('oracledb');
+var should   = require('should');
+var async    = require('async');
+var dbConfig = require('./dbconfig.js');
+
+describe('72. fetchAhead.js', function() {
+
+  var connection = null;
+  var numRows = 1050;
+
+  before(function(done) {
+
+    async.series([
+      function getConn(cb) {
+        oracledb.getConnection(
+          dbConfig,
+          function(err, conn) {
+            should.not.exist(err);
+            connection = conn;
+            cb();
+          }
+        );
+      },
+      function createTab(cb) {
+        var proc = "BEGIN \n" +
+                   "    DECLARE \n" +
+                   "        e_table_missing EXCEPTION; \n" +
+                   "        PRAGMA EXCEPTION_INIT(e_table_missing, -00942); \n" +
+                   "    BEGIN \n" +
+                   "        EXECUTE IMMEDIATE('DROP TABLE nodb_fetchahead'); \n" +
+                   "    EXCEPTION \n" +
+                   "        WHEN e_table_missing \n" +
+                   "        THEN NULL; \n" +
+                   "    END; \n" +
+                   "    EXECUTE IMMEDIATE (' \n" +
+                   "        CREATE TABLE nodb_fetchahead ( \n" +
+                   "            id       NUMBER, \n" +
+                   "            content  VARCHAR2(20), \n" +
+                   "            created  DATE \n" +
+                   "        ) \n" +
+                   "    '); \n" +
+                   "    FOR i IN 1.." + numRows + " LOOP \n" +
+                   "        INSERT INTO nodb_fetchahead \n" +
+                   "        VALUES (i, 'row ' || i, SYSDATE - i); \n" +
+                   "    END LOOP; \n" +
+                   "    COMMIT; \n" +
+                   "END; ";
+
+        connection.execute(
+          proc,
+          function(err) {
+            should.not.exist(err);
+            cb();
+          }
+        );
+      }
+    ], done);
+
+  }); // before
+
+  after(function(done) {
+    async.series([
+      function(cb) {
+        connection.execute(
+          "DROP TABLE nodb_fetchahead",
+          function(err) {
+            should.not.exist(err);
+            cb();
+          }
+        );
+      },
+      function(cb) {
+        connection.release(function(err) {
+          should.not.exist(err);
+          cb();
+        });
+      }
+    ], done);
+  }); // after
+
+  var query = "SELECT id, content, created FROM nodb_fetchahead ORDER BY id";
+
+  it('72.1 fetches all rows in order with getRows()', function(done) {
+    connection.execute(
+      query,
+      [],
+      { resultSet: true, fetchAhead: true },
+      function(err, result) {
+        var expected = 1;
+        should.not.exist(err);
+
+        function fetchRows() {
+          result.resultSet.getRows(100, function(err, rows) {
+            should.not.exist(err);
+
+            for (var i = 0; i < rows.length; i++) {
+              (rows[i][0]).should.eql(expected);
+              (rows[i][1]).should.eql('row ' + expected);
+              (rows[i][2]).should.be.an.instanceOf(Date);
+              expected++;
+            }
+
+            if (rows.length) {
+              fetchRows();
+            } else {
+              (expected - 1).should.eql(numRows);
+              result.resultSet.close(done);
+            }
+          });
+        }
+        fetchRows();
+      }
+    );
+  }); // 72.1
+
+  it('72.2 fetches all rows in order with getRow()', function(done) {
+    connection.execute(
+      query,
+      [],
+      { resultSet: true, fetchAhead: true, outFormat: oracledb.OBJECT },
+      function(err, result) {
+        var expected = 1;
+        should.not.exist(err);
+
+        function fetchRow() {
+          result.resultSet.getRow(function(err, row) {
+            should.not.exist(err);
+
+            if (row) {
+              (row.ID).should.eql(expected);
+              expected++;
+              fetchRow();
+            } else {
+              (expected - 1).should.eql(numRows);
+              result.resultSet.close(done);
+            }
+          });
+        }
+        fetchRow();
+      }
+    );
+  }); // 72.2
+
+  it('72.3 can be closed while the next batch is being fetched', function(done) {
+    connection.execute(
+      query,
+      [],
+      { resultSet: true, fetchAhead: true },
+      function(err, result) {
+        should.not.exist(err);
+
+        result.resultSet.getRows(10, function(err, rows) {
+          should.not.exist(err);
+          (rows.length).should.eql(10);
+          result.resultSet.close(function(err) {
+            should.not.exist(err);
+            done();
+          });
+        });
+      }
+    );
+  }); // 72.3
+
+  it('72.4 does not allow the number of rows to change', function(done) {
+    connection.execute(
+      query,
+      [],
+      { resultSet: true, fetchAhead: true },
+      function(err, result) {
+        should.not.exist(err);
+
+        result.resultSet.getRows(10, function(err, rows) {
+          should.not.exist(err);
+          (rows.length).should.eql(10);
+
+          result.resultSet.getRows(20, function(err) {
+            should.exist(err);
+            (err.message).should.startWith('NJS-050:');
+
+            result.resultSet.getRows(10, function(err, rows) {
+              should.not.exist(err);
+              (rows[0][0]).should.eql(11);
+              result.resultSet.close(done);
+            });
+          });
+        });
+      }
+    );
+  }); // 72.4
+
+  it('72.5 works with queryStream()', function(done) {
+    var stream = connection.queryStream(query, [], { fetchAhead: true });
+    var count = 0;
+
+    stream.on('error', function(err) {
+      should.not.exist(err);
+    });
+
+    stream.on('data', function(row) {
+      count++;
+      (row[0]).should.eql(count);
+    });
+
+    stream.on('end', function() {
+      count.should.eql(numRows);
+      done();
+    });
+  }); // 72.5
+
+});
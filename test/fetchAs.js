@@ -58,6 +58,7 @@ describe('56. fetchAs.js', function() {
 
   afterEach('release connection, reset fetchAsString property', function(done) {
     oracledb.fetchAsString = [];
+    oracledb.fetchAsBuffer = [];
     connection.release( function(err) {
       should.not.exist(err);
       done();
@@ -300,4 +301,137 @@ describe('56. fetchAs.js', function() {
       } );
   });
 
+  it('56.11 dedup shares repeated string values', function(done) {
+    connection.execute(
+      "SELECT DECODE(MOD(LEVEL, 3), 0, 'OPEN', 1, 'CLOSED', NULL) AS STATUS, " +
+      "       TO_CHAR(LEVEL) AS ID " +
+      "FROM DUAL CONNECT BY LEVEL <= 30",
+      [],
+      {
+        maxRows: 30,
+        fetchInfo: { "STATUS": { dedup: true }, "ID": { type: oracledb.STRING, dedup: true } }
+      },
+      function(err, result) {
+        should.not.exist(err);
+        result.rows.length.should.eql(30);
+        for (var i = 0; i < 30; i++) {
+          var level = i + 1;
+          var status = (level % 3 === 0) ? 'OPEN' : (level % 3 === 1) ? 'CLOSED' : null;
+          should.equal(result.rows[i][0], status);
+          (result.rows[i][1]).should.eql(String(level));
+        }
+        done();
+      }
+    );
+  });
+
+  it('56.12 dedup with ResultSet and more values than are shared', function(done) {
+    connection.execute(
+      "SELECT 'V' || MOD(LEVEL, 500) AS VAL FROM DUAL CONNECT BY LEVEL <= 1000",
+      [],
+      {
+        resultSet: true,
+        outFormat: oracledb.OBJECT,
+        fetchInfo: { "VAL": { dedup: true } }
+      },
+      function(err, result) {
+        should.not.exist(err);
+        result.resultSet.getRows(1000, function(err, rows) {
+          should.not.exist(err);
+          rows.length.should.eql(1000);
+          for (var i = 0; i < 1000; i++) {
+            (rows[i].VAL).should.eql('V' + ((i + 1) % 500));
+          }
+          result.resultSet.close(function(err) {
+            should.not.exist(err);
+            done();
+          });
+        });
+      }
+    );
+  });
+
+  it('56.13 CLOB and BLOB columns fetched as String and Buffer with fetchInfo', function(done) {
+    connection.execute(
+      "SELECT TO_CLOB('abc' || LEVEL) AS C, TO_BLOB(HEXTORAW('0A0B')) AS B, " +
+      "       EMPTY_CLOB() AS E, TO_CLOB(NULL) AS N " +
+      "FROM DUAL CONNECT BY LEVEL <= 3",
+      [],
+      {
+        fetchInfo: {
+          "C": { type: oracledb.STRING },
+          "B": { type: oracledb.BUFFER },
+          "E": { type: oracledb.STRING },
+          "N": { type: oracledb.STRING }
+        }
+      },
+      function(err, result) {
+        should.not.exist(err);
+        result.rows.length.should.eql(3);
+        for (var i = 0; i < 3; i++) {
+          (result.rows[i][0]).should.eql('abc' + (i + 1));
+          (Buffer.isBuffer(result.rows[i][1])).should.be.true();
+          (result.rows[i][1]).should.eql(new Buffer([0x0A, 0x0B]));
+          (result.rows[i][2]).should.eql('');
+          should.equal(result.rows[i][3], null);
+        }
+        done();
+      }
+    );
+  });
+
+  it('56.14 fetchAsString CLOB and fetchAsBuffer BLOB with ResultSet', function(done) {
+    var big = new Array(20001).join('x');
+
+    oracledb.fetchAsString = [ oracledb.CLOB ];
+    oracledb.fetchAsBuffer = [ oracledb.BLOB ];
+    (oracledb.fetchAsBuffer).should.eql( [2007] );
+
+    connection.execute(
+      "SELECT TO_CLOB(RPAD('x', 4000, 'x')) || TO_CLOB(RPAD('x', 4000, 'x')) || " +
+      "       TO_CLOB(RPAD('x', 4000, 'x')) || TO_CLOB(RPAD('x', 4000, 'x')) || " +
+      "       TO_CLOB(RPAD('x', 4000, 'x')) AS C, " +
+      "       TO_BLOB(HEXTORAW('FF')) AS B " +
+      "FROM DUAL CONNECT BY LEVEL <= 5",
+      [],
+      { resultSet: true, outFormat: oracledb.OBJECT },
+      function(err, result) {
+        should.not.exist(err);
+        result.resultSet.getRows(2, function(err, rows) {
+          should.not.exist(err);
+          rows.length.should.eql(2);
+          (rows[0].C).should.eql(big);
+          (rows[1].B).should.eql(new Buffer([0xFF]));
+          result.resultSet.getRows(10, function(err, rows) {
+            should.not.exist(err);
+            rows.length.should.eql(3);
+            (rows[2].C).should.eql(big);
+            result.resultSet.close(function(err) {
+              should.not.exist(err);
+              done();
+            });
+          });
+        });
+      }
+    );
+  });
+
+  it('56.15 BLOB cannot be fetched as String', function(done) {
+    (function() {
+      oracledb.fetchAsBuffer = [ oracledb.CLOB ];
+    }).should.throw(/^NJS-021:/);
+
+    connection.execute(
+      "SELECT TO_BLOB(HEXTORAW('FF')) AS B FROM DUAL",
+      [],
+      { fetchInfo: { "B": { type: oracledb.STRING } } },
+      function(err, result) {
+        should.exist(err);
+        (err.message).should.startWith('NJS-021:');
+        should.not.exist(result);
+        done();
+      }
+    );
+  });
+
 })
@@ -475,4 +475,142 @@ describe('62. lobProperties.js', function() {
       }
     );
   }) // 62.10
+
+  it('62.11 reads ahead without changing the data', function(done) {
+    connection.execute(
+      sqlSelect,
+      { i: 1 },
+      function(err, result) {
+        should.not.exist(err);
+        var clob = result.rows[0][1],
+            blob = result.rows[0][2];
+        var clobData = '',
+            blobData = [];
+
+        clob.setEncoding('utf8');
+        clob.pieceSize = 100;
+        blob.pieceSize = 1000;
+
+        clob.on('data', function(chunk) {
+          clobData += chunk;
+        });
+
+        blob.on('data', function(chunk) {
+          blobData.push(chunk);
+        });
+
+        async.parallel([
+          function(callback) {
+            clob.on('end', callback);
+          },
+          function(callback) {
+            blob.on('end', callback);
+          }
+        ], function() {
+          clobData.should.eql(fs.readFileSync('./test/clobexample.txt', 'utf8'));
+          Buffer.concat(blobData).should.eql(fs.readFileSync('./test/fuzzydinosaur.jpg'));
+          done();
+        });
+      }
+    );
+  }) // 62.11
+
+  it('62.12 pieceSize - can be changed in the data handler', function(done) {
+    connection.execute(
+      sqlSelect,
+      { i: 1 },
+      function(err, result) {
+        should.not.exist(err);
+        var clob = result.rows[0][1];
+        var clobData = '';
+
+        clob.setEncoding('utf8');
+        clob.pieceSize = 100;
+
+        clob.on('data', function(chunk) {
+          clobData += chunk;
+          clob.pieceSize = (clob.pieceSize == 100) ? 50 : 100;
+        });
+
+        clob.on('end', function() {
+          clobData.should.eql(fs.readFileSync('./test/clobexample.txt', 'utf8'));
+          done();
+        });
+      }
+    );
+  }) // 62.12
+
+  it('62.13 offset and pieceSize - busy while the next piece is read ahead', function(done) {
+    connection.execute(
+      sqlSelect,
+      { i: 1 },
+      function(err, result) {
+        should.not.exist(err);
+        var iLob = result.rows[0][1].iLob;
+        var text = fs.readFileSync('./test/clobexample.txt', 'utf8');
+
+        iLob.pieceSize = 100;
+        iLob.read(function(err, str) {
+          should.not.exist(err);
+          str.should.eql(text.substr(0, 100));
+
+          // the next piece is read ahead once this callback returns
+          process.nextTick(function() {
+            should.throws(
+              function() {
+                iLob.pieceSize = 50;
+              },
+              /NJS-023:/
+            );
+            should.throws(
+              function() {
+                iLob.offset = 1;
+              },
+              /NJS-023:/
+            );
+
+            // queued until the piece read ahead is there
+            iLob.read(function(err, str) {
+              should.not.exist(err);
+              str.should.eql(text.substr(100, 100));
+
+              iLob.offset = 1;
+              iLob.read(function(err, str) {
+                should.not.exist(err);
+                str.should.eql(text.substr(0, 100));
+                done();
+              });
+            });
+          });
+        });
+      }
+    );
+  }) // 62.13
+
+  it('62.14 release() is deferred while the next piece is read ahead', function(done) {
+    connection.execute(
+      sqlSelect,
+      { i: 1 },
+      function(err, result) {
+        should.not.exist(err);
+        var iLob = result.rows[0][1].iLob;
+
+        iLob.pieceSize = 100;
+        iLob.read(function(err) {
+          should.not.exist(err);
+
+          process.nextTick(function() {
+            iLob.release();
+
+            iLob.read(function(err) {
+              should.exist(err);
+              (err.message).should.startWith('NJS-022:');
+              // NJS-022: invalid Lob
+              done();
+            });
+          });
+        });
+      }
+    );
+  }) // 62.14
 })
@@ -885,6 +885,66 @@ describe('2. pool.js', function() {
         }
       );
     });
+
+    it('2.8.5 completes queued requests in the order they were made', function(done) {
+      oracledb.createPool(
+        {
+          user              : dbConfig.user,
+          password          : dbConfig.password,
+          connectString     : dbConfig.connectString,
+          poolMin           : 0,
+          poolMax           : 1,
+          poolIncrement     : 1,
+          poolTimeout       : 1,
+          queueRequests     : true, //default
+          queueTimeout      : 10000 //10 seconds
+        },
+        function(err, pool){
+          should.not.exist(err);
+
+          var order = [];
+
+          var getAndRelease = function(id, cb) {
+            pool.getConnection(function(err, conn) {
+              should.not.exist(err);
+              order.push(id);
+
+              conn.release(function(err) {
+                should.not.exist(err);
+                cb();
+              });
+            });
+          };
+
+          pool.getConnection(function(err, conn) {
+            should.not.exist(err);
+
+            async.parallel(
+              [
+                function(cb) { getAndRelease(1, cb); },
+                function(cb) { getAndRelease(2, cb); },
+                function(cb) { getAndRelease(3, cb); },
+                function(cb) {
+                  conn.release(function(err) {
+                    should.not.exist(err);
+                    cb();
+                  });
+                }
+              ],
+              function(err){
+                should.not.exist(err);
+                (order).should.eql([1, 2, 3]);
+
+                pool.terminate(function(err) {
+                  should.not.exist(err);
+                  done();
+                });
+              }
+            );
+          });
+        }
+      );
+    });
   });
 
   describe('2.9 connection request queue (_enableStats & _logStats functionality)', function(){
@@ -958,4 +1018,387 @@ describe('2. pool.js', function() {
     });
   }); // 2.10
 
+  describe('2.11 poolMinIdle', function(){
+    it('2.11.1 opens idle connections ahead of demand', function(done) {
+      oracledb.createPool(
+        {
+          user              : dbConfig.user,
+          password          : dbConfig.password,
+          connectString     : dbConfig.connectString,
+          poolMin           : 1,
+          poolMax           : 5,
+          poolIncrement     : 1,
+          poolTimeout       : 0,
+          poolMinIdle       : 2
+        },
+        function(err, pool){
+          should.not.exist(err);
+          pool.poolMinIdle.should.eql(2);
+
+          pool.getConnection(function(err, conn) {
+            should.not.exist(err);
+
+            // the warm-up runs in the background
+            var tries = 0;
+            function checkIdle() {
+              if (pool.connectionsOpen - pool.connectionsInUse < 2 && ++tries < 50) {
+                return setTimeout(checkIdle, 100);
+              }
+              (pool.connectionsOpen - pool.connectionsInUse).should.not.be.below(2);
+
+              conn.release(function(err) {
+                should.not.exist(err);
+
+                pool.terminate(function(err) {
+                  should.not.exist(err);
+                  done();
+                });
+              });
+            }
+            checkIdle();
+          });
+        }
+      );
+    });
+
+    it('2.11.2 terminate waits for the warm-up', function(done) {
+      oracledb.createPool(
+        {
+          user              : dbConfig.user,
+          password          : dbConfig.password,
+          connectString     : dbConfig.connectString,
+          poolMin           : 2,
+          poolMax           : 4,
+          poolIncrement     : 1,
+          poolTimeout       : 0,
+          poolMinIdle       : 3
+        },
+        function(err, pool){
+          should.not.exist(err);
+
+          pool.terminate(function(err) {
+            should.not.exist(err);
+            done();
+          });
+        }
+      );
+    });
+
+    it('2.11.3 poolMinIdle is read-only', function(done) {
+      oracledb.createPool(
+        {
+          user              : dbConfig.user,
+          password          : dbConfig.password,
+          connectString     : dbConfig.connectString,
+          poolMin           : 0,
+          poolMax           : 1,
+          poolIncrement     : 1
+        },
+        function(err, pool){
+          should.not.exist(err);
+          pool.poolMinIdle.should.eql(0);
+
+          try {
+            pool.poolMinIdle = 1;
+          } catch (err) {
+            should.exist(err);
+            (err.message).should.startWith("NJS-014:");
+          }
+
+          pool.terminate(function(err) {
+            should.not.exist(err);
+            done();
+          });
+        }
+      );
+    });
+
+    it('2.11.4 a second terminate during the warm-up is rejected', function(done) {
+      oracledb.createPool(
+        {
+          user              : dbConfig.user,
+          password          : dbConfig.password,
+          connectString     : dbConfig.connectString,
+          poolMin           : 2,
+          poolMax           : 4,
+          poolIncrement     : 1,
+          poolTimeout       : 0,
+          poolMinIdle       : 3
+        },
+        function(err, pool){
+          should.not.exist(err);
+
+          async.parallel([
+            function(cb) {
+              pool.terminate(function(err) {
+                should.not.exist(err);
+                cb();
+              });
+            },
+            function(cb) {
+              pool.terminate(function(err) {
+                should.exist(err);
+                (err.message).should.startWith("NJS-054:");
+                cb();
+              });
+            }
+          ], done);
+        }
+      );
+    });
+
+    it('2.11.5 the pool is not warmed up without queueRequests', function(done) {
+      oracledb.createPool(
+        {
+          user              : dbConfig.user,
+          password          : dbConfig.password,
+          connectString     : dbConfig.connectString,
+          poolMin           : 0,
+          poolMax           : 2,
+          poolIncrement     : 1,
+          poolTimeout       : 0,
+          poolMinIdle       : 2,
+          queueRequests     : false
+        },
+        function(err, pool){
+          should.not.exist(err);
+
+          // a warm-up would hold both sessions and make these fail
+          async.times(2, function(n, next) {
+            pool.getConnection(function(err, conn) {
+              should.not.exist(err);
+              next(null, conn);
+            });
+          }, function(err, conns) {
+            should.not.exist(err);
+            pool.connectionsInUse.should.eql(2);
+
+            async.each(conns, function(conn, cb) {
+              conn.release(cb);
+            }, function(err) {
+              should.not.exist(err);
+              pool.terminate(function(err) {
+                should.not.exist(err);
+                done();
+              });
+            });
+          });
+        }
+      );
+    });
+  }); // 2.11
+
+  describe('2.12 poolPingInterval', function(){
+    it('2.12.1 overrides the oracledb default', function(done) {
+      oracledb.createPool(
+        {
+          user              : dbConfig.user,
+          password          : dbConfig.password,
+          connectString     : dbConfig.connectString,
+          poolMin           : 0,
+          poolMax           : 1,
+          poolIncrement     : 1,
+          poolPingInterval  : -1
+        },
+        function(err, pool){
+          should.not.exist(err);
+          pool.poolPingInterval.should.eql(-1);
+
+          pool.terminate(function(err) {
+            should.not.exist(err);
+            done();
+          });
+        }
+      );
+    });
+
+    it('2.12.2 hands out checked connections when poolPingInterval is 0', function(done) {
+      oracledb.createPool(
+        {
+          user              : dbConfig.user,
+          password          : dbConfig.password,
+          connectString     : dbConfig.connectString,
+          poolMin           : 1,
+          poolMax           : 1,
+          poolIncrement     : 1,
+          poolPingInterval  : 0
+        },
+        function(err, pool){
+          should.not.exist(err);
+
+          async.timesSeries(3, function(n, next) {
+            pool.getConnection(function(err, conn) {
+              should.not.exist(err);
+
+              conn.execute('select 1 from dual', function(err, result) {
+                should.not.exist(err);
+                (result.rows[0][0]).should.eql(1);
+                conn.release(next);
+              });
+            });
+          }, function(err) {
+            should.not.exist(err);
+            pool.terminate(function(err) {
+              should.not.exist(err);
+              done();
+            });
+          });
+        }
+      );
+    });
+
+    it('2.12.3 drops a pooled session that fails the check', function(done) {
+      var sidSql = "select sys_context('USERENV', 'SID') || ',' || serial# " +
+                   "from v$session where sid = sys_context('USERENV', 'SID')";
+
+      oracledb.createPool(
+        {
+          user              : dbConfig.user,
+          password          : dbConfig.password,
+          connectString     : dbConfig.connectString,
+          poolMin           : 1,
+          poolMax           : 1,
+          poolIncrement     : 1,
+          poolPingInterval  : 0
+        },
+        function(err, pool){
+          should.not.exist(err);
+
+          async.waterfall([
+            function(callback) {
+              pool.getConnection(function(err, conn) {
+                should.not.exist(err);
+
+                conn.execute(sidSql, function(err, result) {
+                  conn.release(function(err2) {
+                    callback(err || err2, err ? null : result.rows[0][0]);
+                  });
+                });
+              });
+            },
+            function(sid, callback) {
+              oracledb.getConnection(dbConfig, function(err, conn) {
+                should.not.exist(err);
+
+                conn.execute(
+                  "alter system kill session '" + sid + "' immediate",
+                  function(err) {
+                    conn.release(function(err2) {
+                      should.not.exist(err2);
+                      // the test user may not be allowed to kill sessions
+                      callback(null, !err);
+                    });
+                  }
+                );
+              });
+            },
+            function(killed, callback) {
+              if (!killed)
+                return callback();
+
+              pool.getConnection(function(err, conn) {
+                should.not.exist(err);
+
+                conn.execute('select 1 from dual', function(err, result) {
+                  should.not.exist(err);
+                  (result.rows[0][0]).should.eql(1);
+                  conn.release(callback);
+                });
+              });
+            }
+          ], function(err) {
+            should.not.exist(err);
+            pool.terminate(function(err) {
+              should.not.exist(err);
+              done();
+            });
+          });
+        }
+      );
+    });
+  }); // 2.12
+
+  describe('2.13 getStatistics', function(){
+    it('2.13.1 counts connection requests and checkout times', function(done) {
+      oracledb.createPool(
+        {
+          user              : dbConfig.user,
+          password          : dbConfig.password,
+          connectString     : dbConfig.connectString,
+          poolMin           : 1,
+          poolMax           : 1,
+          poolIncrement     : 1,
+          poolTimeout       : 0
+        },
+        function(err, pool){
+          should.not.exist(err);
+
+          var stats = pool.getStatistics();
+          stats.connectionRequests.should.eql(0);
+          stats.sessionsCreated.should.eql(stats.connectionsOpen);
+          stats.checkoutTime.count.should.eql(0);
+
+          pool.getConnection(function(err, conn1) {
+            should.not.exist(err);
+
+            // queued until conn1 is released
+            pool.getConnection(function(err, conn2) {
+              should.not.exist(err);
+
+              stats = pool.getStatistics();
+              stats.connectionRequests.should.eql(2);
+              stats.failedConnectionRequests.should.eql(0);
+              stats.maxQueueLength.should.eql(1);
+              stats.queueLength.should.eql(0);
+              stats.maxConnectionsInUse.should.eql(1);
+              stats.checkoutTime.count.should.eql(2);
+              stats.checkoutTime.buckets['+Inf'].should.eql(2);
+              stats.timeInQueue.count.should.eql(1);
+              stats.timeInQueue.p99.should.not.be.below(0);
+
+              conn2.release(function(err) {
+                should.not.exist(err);
+
+                pool.terminate(function(err) {
+                  should.not.exist(err);
+                  done();
+                });
+              });
+            });
+
+            pool.getStatistics().queueLength.should.eql(1);
+            conn1.release(function(err) {
+              should.not.exist(err);
+            });
+          });
+        }
+      );
+    });
+
+    it('2.13.2 throws an error after the pool is terminated', function(done) {
+      oracledb.createPool(
+        {
+          user              : dbConfig.user,
+          password          : dbConfig.password,
+          connectString     : dbConfig.connectString,
+          poolMin           : 0,
+          poolMax           : 1,
+          poolIncrement     : 1
+        },
+        function(err, pool){
+          should.not.exist(err);
+
+          pool.terminate(function(err) {
+            should.not.exist(err);
+
+            (function() {
+              pool.getStatistics();
+            }).should.throw(/^NJS-002:/);
+            done();
+          });
+        }
+      );
+    });
+  }); // 2.13
+
 });
@@ -63,6 +63,7 @@ describe('58. properties.js', function() {
       defaultValues.lobPrefetchSize = oracledb.lobPrefetchSize;
       defaultValues.queueRequests   = oracledb.queueRequests;
       defaultValues.queueTimeout    = oracledb.queueTimeout;
+      defaultValues.poolPingInterval = oracledb.poolPingInterval;
       defaultValues.stmtCacheSize   = oracledb.stmtCacheSize;
     })
 
@@ -82,6 +83,7 @@ describe('58. properties.js', function() {
       oracledb.lobPrefetchSize  = defaultValues.lobPrefetchSize;
       oracledb.queueRequests    = defaultValues.queueRequests;
       oracledb.queueTimeout     = defaultValues.queueTimeout;
+      oracledb.poolPingInterval = defaultValues.poolPingInterval;
       oracledb.stmtCacheSize    = defaultValues.stmtCacheSize;
     })
 
@@ -227,6 +229,34 @@ describe('58. properties.js', function() {
       should.notEqual(oracledb.stmtCacheSize, defaultValues.stmtCacheSize);
     })
 
+    it('58.1.18 ioThreads cannot be changed after the first database call', function(done) {
+      var t = oracledb.ioThreads;
+      t.should.be.a.Number();
+
+      oracledb.getConnection(dbConfig, function(err, conn) {
+        should.not.exist(err);
+
+        oracledb.ioThreads = t; // unchanged value is accepted
+        (function() {
+          oracledb.ioThreads = t + 1;
+        }).should.throw(/^NJS-051:/);
+        (oracledb.ioThreads).should.eql(t);
+
+        conn.release(function(err) {
+          should.not.exist(err);
+          done();
+        });
+      });
+    })
+
+    it('58.1.19 poolPingInterval', function() {
+      var t = oracledb.poolPingInterval;
+      oracledb.poolPingInterval = -1;
+
+      should.equal(t, 60);
+      should.equal(oracledb.poolPingInterval, -1);
+    })
+
   }) // 58.1
 
   describe('58.2 Pool Class', function() {
@@ -362,6 +392,18 @@ describe('58. properties.js', function() {
       }
     })
 
+    it('58.2.10 poolPingInterval', function() {
+      var t = pool.poolPingInterval;
+      t.should.be.a.Number();
+
+      try {
+        pool.poolPingInterval = t + 1;
+      } catch(err) {
+        should.exist(err);
+        (err.message).should.startWith('NJS-014:');
+      }
+    })
+
   }) // 58.2
 
   describe('58.3 Connection Class', function() {
@@ -911,6 +911,80 @@ describe('55. resultSet2.js', function() {
     }) // 55.13.1
   }) // 55.13
 
+  describe('55.14 OBJECT rows', function() {
+
+    function getObjectRows(sql, cb) {
+      connection.execute(
+        sql,
+        [],
+        { resultSet: true, outFormat: oracledb.OBJECT },
+        function(err, result) {
+          should.not.exist(err);
+          result.resultSet.getRows(2, function(err, rows) {
+            should.not.exist(err);
+            result.resultSet.close(function(err) {
+              should.not.exist(err);
+              cb(rows);
+            });
+          });
+        }
+      );
+    }
+
+    it('55.14.1 duplicate column names', function(done) {
+      getObjectRows(
+        'SELECT 1 AS "A", 2 AS "B", 3 AS "B" FROM DUAL',
+        function(rows) {
+          rows.should.eql([ { A: 1, B: 3 } ]);
+          Object.keys(rows[0]).should.eql(['A', 'B']);
+          done();
+        }
+      );
+    })
+
+    it('55.14.2 numeric column names', function(done) {
+      getObjectRows(
+        'SELECT 1 AS "A", 2 AS "1" FROM DUAL',
+        function(rows) {
+          rows.length.should.eql(1);
+          rows[0].A.should.eql(1);
+          rows[0]['1'].should.eql(2);
+          done();
+        }
+      );
+    })
+
+    it('55.14.3 rows of repeated executes have the same properties', function(done) {
+      var sql = "SELECT employees_id FROM " + tableName +
+                " WHERE employees_id <= 3 ORDER BY employees_id";
+
+      async.series([
+        function(callback) {
+          setUp(connection, tableName, callback);
+        },
+        function(callback) {
+          async.timesSeries(2, function(n, next) {
+            connection.execute(
+              sql,
+              [],
+              { outFormat: oracledb.OBJECT },
+              function(err, result) {
+                should.not.exist(err);
+                result.rows.should.eql(
+                  [ { EMPLOYEES_ID: 1 }, { EMPLOYEES_ID: 2 }, { EMPLOYEES_ID: 3 } ]
+                );
+                next();
+              }
+            );
+          }, callback);
+        },
+        function(callback) {
+          clearUp(connection, tableName, callback);
+        }
+      ], done);
+    })
+  }) // 55.14
+
 })
 
 
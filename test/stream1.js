@@ -583,7 +583,7 @@ describe('13. stream1.js', function () {
         stream.pause();
 
         // Using the internal/private caches to validate
-        should.equal(stream._fetchedRows.length, testMaxRows - (1 + stream._readableState.buffer.length));
+        should.equal(stream._fetchedRows.length - stream._fetchedRowsIdx, testMaxRows - (1 + stream._readableState.buffer.length));
         stream._close();
       });
 
@@ -619,5 +619,39 @@ describe('13. stream1.js', function () {
         done();
       }
     });
+
+    it('13.3.3 should use the highWaterMark option for fetching', function (done) {
+      var testHighWaterMark = 7;
+
+      connection.should.be.ok();
+
+      var stream = connection.queryStream(
+        'SELECT employee_name FROM nodb_stream1 ORDER BY employee_name',
+        [],
+        { highWaterMark: testHighWaterMark }
+      );
+
+      should.equal(stream._readableState.highWaterMark, testHighWaterMark);
+
+      stream.on('data', function () {
+        stream.pause();
+
+        // Using the internal/private caches to validate
+        should.equal(stream._fetchedRows.length, testHighWaterMark);
+        stream._close();
+      });
+
+      stream.on('close', function() {
+        done();
+      });
+
+      stream.on('end', function () {
+        done(new Error('Reached the end of the stream'));
+      });
+
+      stream.on('error', function (err) {
+        done(err);
+      });
+    });
   });
 });